@@ -0,0 +1,79 @@
+// main162.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This is a simple test program, to compare the speed of generating
+// uniform random numbers one by one with Rndm::flat() and in batches
+// with Rndm::flat(double* out, int n), for the default Marsaglia-Zaman-
+// Tsang algorithm and for the counter-based Philox one. It also checks
+// that the two ways give exactly the same sequence.
+
+#include "Pythia8/Basics.h"
+#include <ctime>
+using namespace Pythia8;
+
+int main() {
+
+  // Number of random numbers in each test, and batch sizes to test.
+  int nTot     = 100000000;
+  int nBatch[] = { 1, 2, 8, 32, 128, 1024, 0};
+
+  // Loop over the two algorithms.
+  double sum = 0.;
+  for (int iAlg = 0; iAlg < 2; ++iAlg) {
+    string algName = (iAlg == 0) ? "Marsaglia-Zaman-Tsang"
+                                 : "Philox-4x32-10 (counter-based)";
+    cout << "\n " << algName << ":" << endl;
+
+    // Check that scalar and batch calls give the same sequence,
+    // also when they are mixed.
+    Rndm rndmOne(4711);
+    Rndm rndmAll(4711);
+    if (iAlg == 1) {
+      rndmOne.initCounter(4711, 1);
+      rndmAll.initCounter(4711, 1);
+    }
+    int nDiff = 0;
+    vector<double> work(1000);
+    for (int iTry = 0; iTry < 1000; ++iTry) {
+      int nNow = 1 + int( 999. * rndmOne.flat() );
+      rndmAll.flat();
+      rndmAll.flat( &work[0], nNow);
+      for (int i = 0; i < nNow; ++i) if (work[i] != rndmOne.flat()) ++nDiff;
+    }
+    cout << " Number of differences between scalar and batch sequence: "
+         << nDiff << endl;
+
+    // Time the scalar path.
+    Rndm rndm(4711);
+    if (iAlg == 1) rndm.initCounter(4711, 1);
+    clock_t start = clock();
+    for (int i = 0; i < nTot; ++i) sum += rndm.flat();
+    double timeOne = double(clock() - start) / double(CLOCKS_PER_SEC);
+    cout << fixed << setprecision(1) << "   scalar flat()          : "
+         << setw(7) << 1e-6 * nTot / timeOne << " million numbers/s" << endl;
+
+    // Time the batch path for different batch sizes.
+    for (int iBatch = 0; nBatch[iBatch] > 0; ++iBatch) {
+      int nNow = nBatch[iBatch];
+      vector<double> out(nNow);
+      start = clock();
+      for (int i = 0; i < nTot / nNow; ++i) {
+        rndm.flat( &out[0], nNow);
+        sum += out[nNow - 1];
+      }
+      double timeAll = double(clock() - start) / double(CLOCKS_PER_SEC);
+      cout << "   flat(out, n) for n = " << setw(4) << nNow << ": " << setw(7)
+           << 1e-6 * nTot / timeAll << " million numbers/s, speedup "
+           << setprecision(2) << setw(5) << timeOne / timeAll
+           << setprecision(1) << endl;
+    }
+  }
+
+  // Print sum, so that the compiler cannot skip the loops.
+  cout << "\n Control sum: " << scientific << setprecision(6) << sum << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,55 @@
+// main163.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This is a simple tool to compile the XML settings and particle databases
+// into a binary image, which later Pythia constructors read instead of the
+// XML files, as long as the XML files are unchanged. It also compares the
+// time to construct a Pythia object before and after, and checks that the
+// two databases come out the same. The image is written to the xmldoc
+// directory, unless another file name is given as argument.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8/InitCache.h"
+#include <ctime>
+using namespace Pythia8;
+
+int main(int argc, char* argv[]) {
+
+  // Number of constructors timed in each case, and xmldoc location.
+  int    nTry   = 10;
+  string xmlDir = "../share/Pythia8/xmldoc";
+
+  // Time the constructor with the current setup.
+  clock_t start = clock();
+  for (int iTry = 0; iTry < nTry; ++iTry) Pythia pythiaTmp(xmlDir, false);
+  double timeBefore = double(clock() - start) / double(CLOCKS_PER_SEC);
+
+  // Write the binary image.
+  Pythia pythia(xmlDir, false);
+  string fileName = (argc > 1) ? argv[1] : "";
+  if (!pythia.writeDatabase( fileName)) return 1;
+  cout << "\n Binary database image written to "
+       << ((fileName == "") ? pythia.word("xmlPath") + "Pythia8Database.bin"
+       : fileName) << endl;
+
+  // Time the constructor again; only changed when default location used.
+  start = clock();
+  for (int iTry = 0; iTry < nTry; ++iTry) Pythia pythiaTmp(xmlDir, false);
+  double timeAfter = double(clock() - start) / double(CLOCKS_PER_SEC);
+  cout << fixed << setprecision(2) << "\n Time per constructor before: "
+       << setw(7) << 1e3 * timeBefore / nTry << " ms\n"
+       << " Time per constructor after:  " << setw(7)
+       << 1e3 * timeAfter / nTry << " ms" << endl;
+
+  // Compare the databases of a new object with those from the XML files.
+  Pythia pythiaNew(xmlDir, false);
+  bool isSame = (InitCache::hashKey( pythia.settings, pythia.particleData)
+    == InitCache::hashKey( pythiaNew.settings, pythiaNew.particleData));
+  cout << "\n Settings and particle data agree: " << (isSame ? "yes" : "no")
+       << endl;
+
+  // Done.
+  return (isSame) ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+// main164.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This is a simple test program, illustrating multi-process generation.
+// It studies the charged multiplicity distribution at the LHC, as
+// main161.cc, but with events generated by worker processes forked from
+// one initialized Pythia object. The histogram is filled separately in
+// each process, and then summed up.
+
+#include "Pythia8/PythiaParallel.h"
+using namespace Pythia8;
+int main() {
+  // Generator. Process selection. LHC initialization. Histogram.
+  PythiaParallel pythia;
+  pythia.readString("Beams:eCM = 8000.");
+  pythia.readString("HardQCD:all = on");
+  pythia.readString("PhaseSpace:pTHatMin = 20.");
+  pythia.readString("Parallelism:numThreads = 4");
+  pythia.readString("Parallelism:forkProcesses = on");
+  pythia.init();
+  Hist mult("charged multiplicity", 100, -0.5, 799.5);
+  pythia.addHist(mult);
+  // Generate events. The callback is called once for each accepted event,
+  // inside the process that generated it.
+  pythia.run( 1000, [&](Pythia* pythiaPtr) {
+    // Find number of all final charged particles and fill histogram.
+    int nCharged = 0;
+    for (int i = 0; i < pythiaPtr->event.size(); ++i)
+      if (pythiaPtr->event[i].isFinal() && pythiaPtr->event[i].isCharged())
+        ++nCharged;
+    mult.fill( nCharged );
+  });
+  // Combined statistics from all processes. Histogram. Done.
+  pythia.stat();
+  cout << mult;
+  return 0;
+}
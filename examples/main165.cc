@@ -0,0 +1,89 @@
+// main165.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This is a simple test program, to compare the speed of evaluating the
+// running alpha_s, to first and second order, and alpha_em, directly and
+// by interpolation in the optional tables. It also gives the largest
+// relative deviation between the two ways, and the number of table cells.
+
+#include "Pythia8/Pythia.h"
+#include <ctime>
+using namespace Pythia8;
+
+int main() {
+
+  // Number of evaluations in each test, and Q^2 range sampled.
+  int    nTot     = 20000000;
+  double scale2Lo = 0.5;
+  double scale2Hi = 1e8;
+
+  // Random Q^2 values, evenly in log(Q^2), reused for all tests.
+  Pythia pythia("../share/Pythia8/xmldoc", false);
+  Rndm rndm(4711);
+  vector<double> scale2(1000000);
+  for (int i = 0; i < int(scale2.size()); ++i)
+    scale2[i] = scale2Lo * pow( scale2Hi / scale2Lo, rndm.flat());
+  int nScale = scale2.size();
+
+  // Loop over alpha_s first order, second order, and alpha_em.
+  double sum = 0.;
+  for (int iCase = 0; iCase < 3; ++iCase) {
+    string caseName = (iCase == 0) ? "alpha_s, first order"
+      : ((iCase == 1) ? "alpha_s, second order" : "alpha_em, first order");
+    cout << "\n " << caseName << ":" << endl;
+
+    // Direct and tabulated couplings.
+    AlphaStrong alpSdir, alpStab;
+    AlphaEM     alpEMdir, alpEMtab;
+    if (iCase < 2) {
+      alpSdir.init( 0.1365, iCase + 1, 5, false);
+      alpStab.init( 0.1365, iCase + 1, 5, false);
+      alpStab.setTabulate( true);
+      cout << "   number of table cells  : " << alpStab.nTableCells() << endl;
+    } else {
+      alpEMdir.init( 1, &pythia.settings);
+      alpEMtab.init( 1, &pythia.settings);
+      alpEMtab.setTabulate( true);
+    }
+
+    // Largest relative deviation.
+    double devMax = 0.;
+    for (int i = 0; i < nScale; ++i) {
+      double valDir = (iCase < 2) ? alpSdir.alphaS( scale2[i])
+        : alpEMdir.alphaEM( scale2[i]);
+      double valTab = (iCase < 2) ? alpStab.alphaS( scale2[i])
+        : alpEMtab.alphaEM( scale2[i]);
+      devMax = max( devMax, abs(valTab / valDir - 1.));
+    }
+    cout << scientific << setprecision(2) << "   max relative deviation : "
+         << devMax << endl;
+
+    // Time the direct and the tabulated evaluations.
+    double timeDir = 0.;
+    for (int iWay = 0; iWay < 2; ++iWay) {
+      clock_t start = clock();
+      for (int i = 0; i < nTot; ++i) {
+        double scale2Now = scale2[i % nScale];
+        if (iCase < 2) sum += (iWay == 0) ? alpSdir.alphaS( scale2Now)
+          : alpStab.alphaS( scale2Now);
+        else sum += (iWay == 0) ? alpEMdir.alphaEM( scale2Now)
+          : alpEMtab.alphaEM( scale2Now);
+      }
+      double timeNow = double(clock() - start) / double(CLOCKS_PER_SEC);
+      cout << fixed << setprecision(1) << ((iWay == 0)
+           ? "   direct evaluation      : " : "   table interpolation    : ")
+           << setw(7) << 1e9 * timeNow / nTot << " ns per call";
+      if (iWay == 0) timeDir = timeNow;
+      else cout << ", speedup " << setprecision(2) << timeDir / timeNow;
+      cout << endl;
+    }
+  }
+
+  // Print sum, so that the compiler cannot skip the loops.
+  cout << "\n Control sum: " << scientific << setprecision(6) << sum << endl;
+
+  // Done.
+  return 0;
+}
@@ -39,7 +39,9 @@ public:
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm.
+// Marsaglia-Zaman-Tsang algorithm. Alternatively the counter-based
+// Philox-4x32-10 algorithm can be used, where the random numbers of
+// an event only depend on the seed, the stream and the event number.
 
 class Rndm {
 
@@ -47,9 +49,13 @@ public:
 
   // Constructors.
   Rndm() : initRndm(false), seedSave(0), sequence(0),
-    useExternalRndm(false), rndmEngPtr(0) { }
+    useExternalRndm(false), rndmEngPtr(0), isCounterBased(false),
+    eventIsSet(false), streamSave(0), nBuffer(0), eventSave(-1),
+    counterSave(0) { }
   Rndm(int seedIn) : initRndm(false), seedSave(0), sequence(0),
-    useExternalRndm(false), rndmEngPtr(0) { init(seedIn);}
+    useExternalRndm(false), rndmEngPtr(0), isCounterBased(false),
+    eventIsSet(false), streamSave(0), nBuffer(0), eventSave(-1),
+    counterSave(0) { init(seedIn);}
 
   // Possibility to pass in pointer for external random number generation.
   bool rndmEnginePtr( RndmEngine* rndmEngPtrIn);
@@ -57,9 +63,25 @@ public:
   // Initialize, normally at construction or in first call.
   void init(int seedIn = 0) ;
 
+  // Initialize counter-based generation for a given seed and stream.
+  void initCounter(int seedIn = 0, int streamIn = 0) ;
+
+  // Counter-based generation: restart the sequence for a given event
+  // number, or for the next event unless the number was set explicitly.
+  void setEvent(long eventIn) ;
+  void nextEvent() ;
+
+  // Counter-based generation: current settings.
+  bool counterBased() const {return isCounterBased;}
+  int  stream()       const {return streamSave;}
+  long event()        const {return eventSave;}
+
   // Generate next random number uniformly between 0 and 1.
   double flat() ;
 
+  // Generate the next n random numbers in one go, same as n flat() calls.
+  void flat(double* out, int n) ;
+
   // Generate random numbers according to exp(-x).
   double exp() { return -log(flat()) ;}
 
@@ -86,6 +108,15 @@ private:
   // Default random number sequence.
   static const int DEFAULTSEED;
 
+  // Multipliers and key increments of the Philox algorithm.
+  static const unsigned int PHILOXM0, PHILOXM1, PHILOXW0, PHILOXW1;
+
+  // Number of Philox blocks generated together in batch generation.
+  static const int PHILOXLANES;
+
+  // Size of the buffer of counter-based numbers (an even number).
+  static const int NBUFFER = 32;
+
   // State of the random number generator.
   bool   initRndm;
   int    i97, j97, seedSave;
@@ -96,6 +127,20 @@ private:
   bool   useExternalRndm;
   RndmEngine* rndmEngPtr;
 
+  // State of the counter-based generator, and buffer of unused numbers.
+  bool   isCounterBased, eventIsSet;
+  int    streamSave, nBuffer;
+  long   eventSave, counterSave;
+  double buffer[NBUFFER];
+
+  // Generate nBlock consecutive blocks, of two numbers each, of the
+  // counter-based algorithm, starting from the given counter.
+  void   philoxBlocks(long counterIn, int nBlock, double* out);
+
+  // Refill the buffer of counter-based numbers.
+  void   fillBuffer() {philoxBlocks( counterSave, NBUFFER / 2, buffer);
+    counterSave += NBUFFER / 2; nBuffer = NBUFFER;}
+
 };
 
 //==========================================================================
@@ -432,6 +477,11 @@ public:
   // Check whether another histogram has same size and limits.
   bool sameSize(const Hist& h) const ;
 
+  // Write and read the complete histogram in binary form, e.g. to sum
+  // histograms filled in separate processes.
+  void writeBinary(ostream& os) const ;
+  bool readBinary(istream& is) ;
+
   // Take logarithm (base 10 or e) of bin contents.
   void takeLog(bool tenLog = true) ;
 
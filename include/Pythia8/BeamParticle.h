@@ -194,6 +194,17 @@ public:
   double xf(int idIn, double x, double Q2)
     {return pdfBeamPtr->xf(idIn, x, Q2);}
 
+  // All standard or hard-process parton distributions at a number of
+  // points, in the order given by PDF::xfBatchIndex.
+  void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {pdfBeamPtr->xfBatch(nPoints, x, Q2, xfOut);}
+  void xfHardBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {pdfHardBeamPtr->xfBatch(nPoints, x, Q2, xfOut);}
+
+  // Hits and misses of the (x, Q2) cache of the standard PDF.
+  long pdfCacheHits() {return pdfBeamPtr->nCacheHits();}
+  long pdfCacheMisses() {return pdfBeamPtr->nCacheMisses();}
+
   // Ditto, split into valence and sea parts (where gluon counts as sea).
   double xfVal(int idIn, double x, double Q2)
     {return pdfBeamPtr->xfVal(idIn, x, Q2);}
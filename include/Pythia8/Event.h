@@ -589,6 +589,61 @@ private:
 
 //==========================================================================
 
+// The EventColumns class is a compact view of an event record, with one
+// contiguous array per particle property, for analyses and output that
+// loop over one property of all particles at a time. The same object
+// can be filled with one event after the other; the arrays only grow
+// when an event is larger than all the previous ones.
+
+class EventColumns {
+
+public:
+
+  // Constructor.
+  EventColumns(int capacity = 100) : sizeSave(0) {resize(capacity);
+    resize(0);}
+
+  // Fill with the properties of all particles in an event.
+  void fill(const Event& event);
+
+  // Number of particles, as in the event record.
+  int size() const {return sizeSave;}
+
+  // The arrays, each with size() entries.
+  const int*    id()        const {return idSave.data();}
+  const int*    status()    const {return statusSave.data();}
+  const int*    mother1()   const {return mother1Save.data();}
+  const int*    mother2()   const {return mother2Save.data();}
+  const int*    daughter1() const {return daughter1Save.data();}
+  const int*    daughter2() const {return daughter2Save.data();}
+  const double* px()        const {return pxSave.data();}
+  const double* py()        const {return pySave.data();}
+  const double* pz()        const {return pzSave.data();}
+  const double* e()         const {return eSave.data();}
+  const double* m()         const {return mSave.data();}
+  const double* xProd()     const {return xProdSave.data();}
+  const double* yProd()     const {return yProdSave.data();}
+  const double* zProd()     const {return zProdSave.data();}
+  const double* tProd()     const {return tProdSave.data();}
+
+private:
+
+  // Number of particles currently stored.
+  int sizeSave;
+
+  // The arrays.
+  vector<int>    idSave, statusSave, mother1Save, mother2Save,
+                 daughter1Save, daughter2Save;
+  vector<double> pxSave, pySave, pzSave, eSave, mSave, xProdSave,
+                 yProdSave, zProdSave, tProdSave;
+
+  // Set the size of all arrays; the capacity is kept when shrinking.
+  void resize(int sizeIn);
+
+};
+
+//==========================================================================
+
 } // end namespace Pythia8
 
 #endif // end Pythia8_Event_H
@@ -4,6 +4,7 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // This file contains a class that keep track of generic event info.
+// ErrorCounts: thread-safe counters of the registered error messages.
 // Info: contains information on the generation process and errors.
 
 #ifndef Pythia8_Info_H
@@ -18,6 +19,49 @@ namespace Pythia8 {
 // Forard declaration of HIInfo class.
 class HIInfo;
 
+// Forward declaration of InitCache class.
+class InitCache;
+
+//==========================================================================
+
+// The ErrorCounts class holds the number of times each registered error
+// message has occured, in counters that several threads may increase at
+// the same time. The counters live in Info.cc, so that this header does
+// not depend on C++11 libraries. Copies are deep, so that the Info class
+// remains copyable, but only the codes registered so far are copied.
+
+class ErrorCounts {
+
+public:
+
+  // Constructors and destructor. (See Info.cc file.)
+  ErrorCounts();
+  ErrorCounts(const ErrorCounts& other);
+  ErrorCounts& operator=(const ErrorCounts& other);
+  ~ErrorCounts();
+
+  // Increase the counter of a code, and return the value before.
+  long increase(int codeIn, long nIn = 1);
+
+  // Current value of the counter of a code, and reset of all of them.
+  long value(int codeIn) const;
+  void reset();
+
+  // Add the counts of another object.
+  void add(const ErrorCounts& other);
+
+  // Exchange the counters with another object, without copying them.
+  void swap(ErrorCounts& other) {Counters* countersTmp = countersPtr;
+    countersPtr = other.countersPtr; other.countersPtr = countersTmp;}
+
+private:
+
+  // The counters themselves. (See Info.cc file.)
+  class Counters;
+  Counters* countersPtr;
+
+};
+
 //==========================================================================
 
 // The Info class contains a mixed bag of information on the event
@@ -36,9 +80,12 @@ public:
     weightgroups(NULL), init_weights(NULL), eventAttributes(NULL),
     weights_detailed(NULL), weights_compressed(NULL), scales(NULL),
     weights(NULL), rwgt(NULL), hiinfo(0), eCMSave(0.),
-    lowPTmin(false), a0MPISave(0.),
-    abortPartonLevel(false), weightCKKWLSave(1.), weightFIRSTSave(0.) {
+    lowPTmin(false), initCacheSave(0), a0MPISave(0.),
+    abortPartonLevel(false), isVMDstateAEvent(false),
+    isVMDstateBEvent(false), doTimingSave(false), weightCKKWLSave(1.),
+    weightFIRSTSave(0.) {
     for (int i = 0; i < 40; ++i) counters[i] = 0;
+    resetTiming();
     setNWeights(1);}
 
   // Listing of most available information on current event.
@@ -224,16 +271,61 @@ public:
   void   setCounter( int i, int value = 0) {counters[i]  = value;}
   void   addCounter( int i, int value = 1) {counters[i] += value;}
 
+  // The timed stages of event generation. Stages after TIMEPARTON and
+  // TIMEHADRON are parts of these, and are indented in the printout.
+  enum TimingStage {TIMENEXT = 0, TIMEPROCESS, TIMEPARTON, TIMEMPI,
+    TIMEISR, TIMEFSR, TIMEREMNANTS, TIMECR, TIMEHADRON, TIMESTRING,
+    TIMEDECAYS, TIMEBE};
+
+  // Timing of the main stages of event generation, if Next:timing is on:
+  // number of calls and accumulated wall-clock time in seconds.
+  bool   doTiming()          const {return doTimingSave;}
+  int    nStages()           const {return NSTAGES;}
+  string nameStage( int i)   const;
+  long   nCallsStage( int i) const {return (i >= 0 && i < NSTAGES)
+    ? nCallsStageSave[i] : 0;}
+  double timeStage( int i)   const {return (i >= 0 && i < NSTAGES)
+    ? timeStageSave[i] : 0.;}
+
+  // Start and stop the timer of a stage. Nothing is done if timing is off.
+  void   startTiming( TimingStage i) {if (doTimingSave) {
+    ++nCallsStageSave[i]; startStageSave[i] = wallTime();} }
+  void   stopTiming( TimingStage i) {if (doTimingSave)
+    timeStageSave[i] += wallTime() - startStageSave[i];}
+
+  // Print statistics on the time spent in the stages of event generation.
+  void   timingStatistics();
+
   // Reset to empty map of error messages.
-  void   errorReset() {messages.clear();}
+  void   errorReset() {messages.clear(); errorCounts.reset();}
 
-  // Print a message the first few times. Insert in database.
+  // Print a message the first few times. Insert in database. This is
+  // meant for messages composed at run time; they are counted by text,
+  // only in this object, and are not registered.
   void   errorMsg(string messageIn, string extraIn = " ",
     bool showAlways = false);
 
+  // Variant for a message that is a string literal, the normal case.
+  // The message is only registered the first time; later calls are
+  // recognized by the address of the literal, without any string copy.
+  void   errorMsg(const char* messageIn, const string& extraIn = " ",
+    bool showAlways = false);
+
+  // Variant for a message registered with errorCode below. This one
+  // is thread-safe, so that several generators may share one Info.
+  void   errorMsg(int codeIn, const string& extraIn = " ",
+    bool showAlways = false);
+
+  // Register a message, once and for all, and return its code. The codes
+  // are common to all Info objects. Returns -1 if the registry is full.
+  static int errorCode(const string& messageIn);
+
   // Provide total number of errors/aborts/warnings experienced to date.
   int    errorTotalNumber();
 
+  // Provide all errors/aborts/warnings with the number of times each.
+  map<string, int> errorMessages() const;
+
   // Print statistics on errors/aborts/warnings.
   void   errorStatistics();
 
@@ -417,6 +509,10 @@ public:
   // is inactive.
   HIInfo * hiinfo;
 
+  // Access to the cache of initialization results, used by the various
+  // init() methods during Pythia::init(). (Is NULL if no cache is used.)
+  InitCache* initCachePtr() const {return initCacheSave;}
+
   private:
 
   // Number of times the same error message is repeated, unless overridden.
@@ -432,6 +528,9 @@ public:
   // Store initialization information.
   bool   lowPTmin;
 
+  // Cache of initialization results, if any.
+  InitCache* initCacheSave;
+
   // Store common integrated cross section quantities.
   long   nTry, nSel, nAcc;
   double sigGen, sigErr, wtAccSum;
@@ -479,9 +578,22 @@ public:
   // Vector of various loop counters.
   int    counters[50];
 
-  // Map for all error messages.
+  // Timing of the main stages of event generation. The wall-clock time
+  // in seconds is read in Info.cc, so that this header does not depend
+  // on C++11 libraries.
+  static const int NSTAGES = TIMEBE + 1;
+  bool   doTimingSave;
+  long   nCallsStageSave[NSTAGES];
+  double timeStageSave[NSTAGES], startStageSave[NSTAGES];
+  static double wallTime();
+
+  // Map for error messages that are not registered with a code.
   map<string, int> messages;
 
+  // Number of times each registered message occured in this object. The
+  // registry itself is common to all Info objects, see Info.cc.
+  ErrorCounts errorCounts;
+
   // Map for LHEF headers.
   map<string, string> headers;
 
@@ -505,6 +617,7 @@ public:
   friend class SpaceShower;
   friend class GammaKinematics;
   friend class HeavyIons;
+  friend class PythiaParallel;
 
   // Set info on the two incoming beams: only from Pythia class.
   void setBeamA( int idAin, double pzAin, double eAin, double mAin) {
@@ -635,6 +748,15 @@ public:
   // Set current pT evolution scale for MPI/ISR/FSR; from PartonLevel.
   void setPTnow( double pTnowIn) {pTnowSave = pTnowIn;}
 
+  // Set pointer to cache of initialization results: from Pythia.
+  void setInitCachePtr( InitCache* initCacheIn) {initCacheSave = initCacheIn;}
+
+  // Switch timing of event generation stages on or off, and reset it.
+  void setTiming( bool doTimingIn) {doTimingSave = doTimingIn;
+    resetTiming();}
+  void resetTiming() {for (int i = 0; i < NSTAGES; ++i) {
+    nCallsStageSave[i] = 0; timeStageSave[i] = 0.;} }
+
   // Set a0 from MultipartonInteractions.
   void seta0MPI(double a0MPIin) {a0MPISave = a0MPIin;}
 
@@ -0,0 +1,98 @@
+// InitCache.h is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a class to store the outcome of time-consuming
+// initialization steps on file, for reuse in later identical runs.
+// InitCache: binary file of initialization results, keyed by settings.
+
+#ifndef Pythia8_InitCache_H
+#define Pythia8_InitCache_H
+
+#include "Pythia8/Info.h"
+#include "Pythia8/ParticleData.h"
+#include "Pythia8/PythiaStdlib.h"
+#include "Pythia8/Settings.h"
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The InitCache class stores results of the initialization, such as the
+// phase-space maxima of the hard processes and the MPI pT0 and Sudakov
+// tables, as vectors of doubles identified by a text tag. The whole set
+// is keyed by a hash of the current settings and particle data, and is
+// only reused if the hash of a later run agrees.
+
+class InitCache {
+
+public:
+
+  // Constructor.
+  InitCache() : isOpen(false), hasNew(false), nHitSave(0), nMissSave(0),
+    keySave(0), infoPtr(0) {}
+
+  // Begin a new initialization. Read in the file if the key agrees.
+  bool open( string fileNameIn, Settings& settings,
+    ParticleData& particleData, Info* infoPtrIn);
+
+  // End of initialization. Write out the file if new results were added.
+  bool close( bool doWrite = true);
+
+  // Cache is open for reading and writing.
+  bool isActive() const {return isOpen;}
+
+  // Unique tag of a record, adding the number of earlier requests.
+  string tag( string tagIn);
+
+  // Check whether values are stored for a tag, without retrieving them.
+  bool has( string tagIn) const {
+    return isOpen && records.find(tagIn) != records.end();}
+
+  // Retrieve the values stored for a tag, if any.
+  bool get( string tagIn, vector<double>& values);
+
+  // Store the values for a tag.
+  void put( string tagIn, const vector<double>& values);
+
+  // Number of records that were found and not found, respectively.
+  int  nHit()  const {return nHitSave;}
+  int  nMiss() const {return nMissSave;}
+
+  // The hash of the current settings and particle data.
+  static unsigned long long hashKey( Settings& settings,
+    ParticleData& particleData);
+
+private:
+
+  // Constants: could only be changed in the code itself.
+  static const int    FORMATVERSION;
+  static const string FILEHEADER, IGNOREPREFIX[];
+
+  // Status and statistics.
+  bool   isOpen, hasNew;
+  int    nHitSave, nMissSave;
+
+  // Key of current run and name of cache file.
+  unsigned long long keySave;
+  string fileName;
+
+  // The stored records and the number of requests for each tag.
+  map<string, vector<double> > records;
+  map<string, int> nRequest;
+
+  // Pointer to various information on the generation.
+  Info*  infoPtr;
+
+  // Read and write the cache file.
+  bool   readFile();
+  bool   writeFile();
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_InitCache_H
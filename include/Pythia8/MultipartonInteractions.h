@@ -176,12 +176,13 @@ private:
                       EXPPOWMIN, PROBATLOWB, BSTEP, BMAX, EXPMAX,
                       KCONVERGE, CONVERT2MB, ROOTMIN, ECMDEV, WTACCWARN,
                       SIGMAMBLIMIT;
+  static const int    NINITSTATE, NSEEDMAX;
 
   // Initialization data, read from Settings.
   bool   allowRescatter, allowDoubleRes, canVetoMPI, doPartonVertex;
   int    pTmaxMatch, alphaSorder, alphaEMorder, alphaSnfmax, bProfile,
          processLevel, bSelScale, rescatterMode, nQuarkIn, nSample,
-         enhanceScreening, pT0paramMode;
+         enhanceScreening, pT0paramMode, nInitProcesses;
   double alphaSvalue, Kfactor, pT0Ref, ecmRef, ecmPow, pTmin, coreRadius,
          coreFraction, expPow, ySepResc, deltaYResc, sigmaPomP, mPomP, pPomP,
          mMaxPertDiff, mMinPertDiff;
@@ -227,7 +228,7 @@ private:
          zeroIntCorr, normOverlap, nAvg, kNow, normPi, bAvg, bDiv,
          probLowB, radius2B, radius2C, fracA, fracB, fracC, fracAhigh,
          fracBhigh, fracChigh, fracABChigh, expRev, cDiv, cMax,
-         enhanceBavg;
+         enhanceBavg, sigmaViolNow;
 
   // Properties specific to current system.
   bool   bIsSet, bSetInFirst, isAtLowB, pickOtherSel;
@@ -290,6 +291,20 @@ private:
   // Scattered partons.
   vector<int>    scatteredA, scatteredB;
 
+  // Find pT0 and interaction rate for current energy during initialization.
+  bool initStep( bool showMPI);
+
+  // Set the diffractive or gamma+gamma mass of a step during initialization.
+  void setMassStep( int iStep, bool showMPI);
+
+  // Run initStep() for all mass steps in parallel, in forked processes.
+  void initStepsForked( int nProcesses, const vector<string>& cacheTags,
+    vector< vector<double> >& valuesOut);
+
+  // Store or restore the initStep() results, for the initialization cache.
+  void saveInitState( vector<double>& values);
+  bool readInitState( const vector<double>& values);
+
   // Determine constant in d(Prob)/d(pT2) < const / (pT2 + r * pT20)^2.
   void upperEnvelope();
 
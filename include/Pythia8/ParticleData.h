@@ -372,7 +372,11 @@ public:
   ParticleData() : infoPtr(0), settingsPtr(0), rndmPtr(0), couplingsPtr(0),
     particlePtr(0), isInit(false), readingFailedSave(false) {}
 
-  // Copy constructors.
+  // Copy constructors. The entries are copied one by one, so that they
+  // point to the new object, and the hash index is rebuilt to match.
+  ParticleData( const ParticleData& oldPD) : infoPtr(0), settingsPtr(0),
+    rndmPtr(0), couplingsPtr(0), particlePtr(0), isInit(false),
+    readingFailedSave(false) {*this = oldPD;}
   ParticleData& operator=( const ParticleData& oldPD) { if (this != &oldPD) {
     modeBreitWigner = oldPD.modeBreitWigner; maxEnhanceBW = oldPD.maxEnhanceBW;
     for (int i = 0; i < 7; ++i) mQRun[i] = oldPD.mQRun[i];
@@ -381,7 +385,7 @@ public:
     for ( map<int, ParticleDataEntry>::const_iterator pde = oldPD.pdt.begin();
       pde != oldPD.pdt.end(); pde++) { int idTmp = pde->first;
       pdt[idTmp] = pde->second; pdt[idTmp].initPtr(this); }
-    particlePtr = 0; isInit = oldPD.isInit;
+    indexParticles(); particlePtr = 0; isInit = oldPD.isInit;
     readingFailedSave = oldPD.readingFailedSave; } return *this; }
 
   // Initialize pointers.
@@ -401,6 +405,10 @@ public:
   // Read in database from an istream.
   bool init(istream& is) { initCommon(); return readXML(is);}
 
+  // Read in database from, or write it to, a binary image.
+  bool initBinary(istream& is);
+  bool writeBinary(ostream& os);
+
   // Overwrite existing database by reading from specific file.
   bool reInit(string startFile, bool xmlFormat = true) { initCommon();
     return (xmlFormat) ? readXML(startFile) : readFF(startFile);}
@@ -460,14 +468,15 @@ public:
     double mWidthIn = 0., double mMinIn = 0., double mMaxIn = 0.,
     double tau0In = 0.) { pdt[abs(idIn)] = ParticleDataEntry(idIn,
     nameIn, spinTypeIn, chargeTypeIn, colTypeIn, m0In, mWidthIn,
-    mMinIn, mMaxIn, tau0In); pdt[abs(idIn)].initPtr(this); }
+    mMinIn, mMaxIn, tau0In); pdt[abs(idIn)].initPtr(this);
+    indexParticle(abs(idIn)); }
   void addParticle(int idIn, string nameIn, string antiNameIn,
     int spinTypeIn = 0, int chargeTypeIn = 0, int colTypeIn = 0,
     double m0In = 0., double mWidthIn = 0., double mMinIn = 0.,
     double mMaxIn = 0., double tau0In = 0.) { pdt[abs(idIn)]
     = ParticleDataEntry(idIn, nameIn, antiNameIn, spinTypeIn,
     chargeTypeIn, colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In);
-    pdt[abs(idIn)].initPtr(this); }
+    pdt[abs(idIn)].initPtr(this); indexParticle(abs(idIn)); }
 
   // Reset all the properties of an entry in one go.
   void setAll(int idIn, string nameIn, string antiNameIn,
@@ -480,25 +489,25 @@ public:
 
   // Query existence of an entry.
   bool isParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if ( found == pdt.end() ) return false;
-    if ( idIn > 0 || found->second.hasAnti() ) return true;
+    const ParticleDataEntry* found = findIndex( abs(idIn) );
+    if ( found == NULL ) return false;
+    if ( idIn > 0 || found->hasAnti() ) return true;
     return false;
   }
 
-  // Query existence of an entry and return an iterator.
+  // Query existence of an entry and return a pointer to it.
   ParticleDataEntry* findParticle(int idIn) {
-    map<int,ParticleDataEntry>::iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return NULL;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    ParticleDataEntry* found = findIndex( abs(idIn) );
+    if( found == NULL ) return NULL;
+    if ( idIn > 0 || found->hasAnti() ) return found;
     return NULL;
   }
 
-  // Query existence of an entry and return a const iterator.
+  // Query existence of an entry and return a const pointer to it.
   const ParticleDataEntry* findParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return NULL;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    const ParticleDataEntry* found = findIndex( abs(idIn) );
+    if( found == NULL ) return NULL;
+    if ( idIn > 0 || found->hasAnti() ) return found;
     return NULL;
   }
 
@@ -720,6 +729,9 @@ public:
 
 private:
 
+  // Constants: could only be changed in the code itself.
+  static const int INDEXSIZEMIN;
+
   // Common data, accessible for the individual particles.
   bool   setRapidDecayVertex;
   int    modeBreitWigner;
@@ -743,6 +755,30 @@ private:
   // All particle data stored in a map.
   map<int, ParticleDataEntry> pdt;
 
+  // Hash index from |id| to the entries in the map, for fast lookup, with
+  // open addressing and linear probing. Empty slots have a negative key.
+  // The map entries never move, so the pointers stay valid until erased.
+  vector< pair<int, ParticleDataEntry*> > pdtIndex;
+
+  // Look up an entry in the hash index; NULL if not found.
+  ParticleDataEntry* findIndex(int idAbs) const {
+    if (pdtIndex.size() == 0) return NULL;
+    int mask = pdtIndex.size() - 1;
+    for (int i = hashIndex(idAbs) & mask; ; i = (i + 1) & mask) {
+      if (pdtIndex[i].first == idAbs) return pdtIndex[i].second;
+      if (pdtIndex[i].first < 0) return NULL;
+    }
+  }
+
+  // Spread the bits of an id code over the hash index.
+  static int hashIndex(int idAbs) {
+    unsigned int hash = static_cast<unsigned int>(idAbs) * 2654435769u;
+    return int( (hash ^ (hash >> 16)) & 0x7fffffff );}
+
+  // Add an entry of the map to the hash index, or rebuild the whole index.
+  void indexParticle(int idAbs);
+  void indexParticles();
+
   // Pointer to current particle (e.g. when reading decay channels).
   ParticleDataEntry* particlePtr;
 
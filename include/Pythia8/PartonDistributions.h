@@ -4,6 +4,7 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // Header file for parton densities.
+// PDFGridImage: binary image of a PDF grid, mapped into memory.
 // PDF: base class.
 // LHAPDF: derived class for interface to the LHAPDF library.
 // GRV94L: derived class for the GRV 94L parton densities.
@@ -32,6 +33,68 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The PDFGridImage class keeps the grid of a PDF set as a binary file,
+// that is mapped read-only into memory. Then all processes on a node
+// that use the same set share the same pages, and the text file need
+// only be converted once. The image consists of a number of blocks of
+// doubles, each beginning at a page boundary, and is only used as long
+// as the size and modification time of the text file agree.
+
+class PDFGridImage {
+
+public:
+
+  // Constructor.
+  PDFGridImage() : mapPtr(0), mapSize(0) {}
+
+  // Destructor.
+  ~PDFGridImage() {close();}
+
+  // Name of the image file of a data file, in the given directory.
+  static string imageFile(string dataFile, string imageDir);
+
+  // Map an existing image, if it is up to date and has the right tag.
+  bool open(string imageFileIn, string dataFile, string tag);
+
+  // Write an image of the blocks, replacing any earlier one, and map it.
+  bool write(string imageFileIn, string dataFile, string tag,
+    const vector<const vector<double>*>& blocks);
+
+  // Release the mapping.
+  void close();
+
+  // The mapped blocks and their sizes.
+  bool          isMapped()       const {return mapPtr != 0;}
+  int           nBlocks()        const {return blockOffset.size();}
+  const double* block(int i)     const {return reinterpret_cast<const double*>
+    (static_cast<const char*>(mapPtr) + blockOffset[i]);}
+  int           blockSize(int i) const {return int(blockLength[i]);}
+
+private:
+
+  // Copy and = constructors are made private so they cannot be used.
+  PDFGridImage(const PDFGridImage&);
+  PDFGridImage& operator=(const PDFGridImage&);
+
+  // Constants: could only be changed in the code itself.
+  static const int    FORMATVERSION;
+  static const long   PAGESIZE;
+  static const double ENDIANCHECK;
+  static const string FILEHEADER;
+
+  // The mapped memory and the blocks in it: offsets in bytes, lengths
+  // in number of doubles.
+  void*  mapPtr;
+  size_t mapSize;
+  vector<long long> blockOffset, blockLength;
+
+  // Size and modification time of a file.
+  static bool fileStamp(string fileName, long long& size, long long& modTime);
+
+};
+
+//==========================================================================
+
 // Base class for parton distribution functions.
 
 class PDF {
@@ -43,8 +106,10 @@ public:
     setValenceContent(); idSav = 9; xSav = -1.; Q2Sav = -1.;
     xu = 0.; xd = 0.; xs = 0.; xubar = 0.; xdbar = 0.; xsbar = 0.; xc = 0.;
     xb = 0.; xg = 0.; xlepton = 0.; xgamma = 0.; xuVal = 0.; xuSea = 0.;
-    xdVal = 0.; xdSea = 0.; isSet = true; isInit = false;
-    hasGammaInLepton = false; }
+    xdVal = 0.; xdSea = 0.; xsVal = 0.; xcVal = 0.; xbVal = 0.; xsSea = 0.;
+    xcSea = 0.; xbSea = 0.; isSet = true; isInit = false;
+    hasGammaInLepton = false; isCacheable = false; useCache = false;
+    nCacheHit = 0; nCacheMiss = 0; resetCache(); }
 
   // Destructor.
   virtual ~PDF() {}
@@ -62,10 +127,30 @@ public:
   // Read out parton density.
   virtual double xf(int id, double x, double Q2);
 
+  // Read out all parton densities at a number of (x, Q2) points, stored
+  // point by point with NXFBATCH values each, see xfBatchIndex.
+  static const int NXFBATCH = 12;
+  static int xfBatchIndex(int id) {return (id == 21) ? 5
+    : ( (id == 22) ? NXFBATCH - 1 : id + 5 );}
+  virtual void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut);
+
   // Read out valence and sea part of parton densities.
   virtual double xfVal(int id, double x, double Q2);
   virtual double xfSea(int id, double x, double Q2);
 
+  // Switch on or off the cache of recently evaluated (x, Q2) points.
+  // Only used for PDFs where all flavours only depend on x and Q2.
+  virtual void setCache(bool useCacheIn) {
+    useCache = useCacheIn && isCacheable; resetCache();}
+
+  // Empty the cache, e.g. at the beginning of each event.
+  virtual void resetCache() {nCacheUsed = 0; iCacheNext = 0;}
+
+  // Number of cache hits and misses so far.
+  virtual long nCacheHits() {return nCacheHit;}
+  virtual long nCacheMisses() {return nCacheMiss;}
+
   // Check whether x and Q2 values fall inside the fit bounds (LHAPDF6 only).
   virtual bool insideBounds(double, double) {return true;}
 
@@ -150,12 +235,30 @@ protected:
   // True if a photon beam inside a lepton beam, otherwise set false.
   bool hasGammaInLepton;
 
+  // Cache of all flavours at the latest NCACHE (x, Q2) points, filled
+  // cyclically. Derived classes where xfUpdate only depends on x and Q2
+  // set isCacheable true in their constructor.
+  static const int NCACHE = 8, NCACHEVAL = 21;
+  bool   isCacheable, useCache;
+  int    nCacheUsed, iCacheNext;
+  long   nCacheHit, nCacheMiss;
+  double xCache[NCACHE], Q2Cache[NCACHE], valCache[NCACHE][NCACHEVAL];
+
   // Resolve valence content for assumed meson. Possibly modified later.
   void setValenceContent();
 
   // Update parton densities.
   virtual void xfUpdate(int id, double x, double Q2) = 0;
 
+  // Update parton densities, or copy them from the cache when possible.
+  void xfUpdateCached(int id, double x, double Q2) {
+    if (useCache) xfFromCache(id, x, Q2); else xfUpdate(id, x, Q2);}
+  void xfFromCache(int id, double x, double Q2);
+
+  // Batch evaluation for PDFs where xfUpdate sets all flavours at once.
+  void xfBatchAll(int nPoints, const double* x, const double* Q2,
+    double* xfOut);
+
   // Small routine for error printout, depending on infoPtr existing or not.
   void printErr(string errMsg, Info* infoPtr = 0) {
     if (infoPtr !=0) infoPtr->errorMsg(errMsg);
@@ -174,7 +277,7 @@ class GRV94L : public PDF {
 public:
 
   // Constructor.
-  GRV94L(int idBeamIn = 2212) : PDF(idBeamIn) {}
+  GRV94L(int idBeamIn = 2212) : PDF(idBeamIn) {isCacheable = true;}
 
 private:
 
@@ -201,7 +304,7 @@ class CTEQ5L : public PDF {
 public:
 
   // Constructor.
-  CTEQ5L(int idBeamIn = 2212) : PDF(idBeamIn) {}
+  CTEQ5L(int idBeamIn = 2212) : PDF(idBeamIn) {isCacheable = true;}
 
 private:
 
@@ -226,14 +329,20 @@ class MSTWpdf : public PDF {
 
 public:
 
-  // Constructor.
+  // Constructor. If an image directory is given, the grid is kept in a
+  // binary image there, that is shared between processes.
   MSTWpdf(int idBeamIn = 2212, int iFitIn = 1,
-    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
-    : PDF(idBeamIn) {init( iFitIn,  xmlPath, infoPtr);}
+    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0,
+    string imageDirIn = "") : PDF(idBeamIn), imageDir(imageDirIn), c(0) {
+    isCacheable = true; init( iFitIn,  xmlPath, infoPtr);}
 
   // Constructor with a stream.
   MSTWpdf(int idBeamIn, istream& is, Info* infoPtr = 0)
-    : PDF(idBeamIn) {init( is, infoPtr);}
+    : PDF(idBeamIn), c(0) {isCacheable = true; init( is, infoPtr);}
+
+  // All flavours are updated together, so batches need no flavour loop.
+  void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {xfBatchAll( nPoints, x, Q2, xfOut);}
 
 private:
 
@@ -244,7 +353,15 @@ private:
   // Data read in from grid file or set at initialization.
   int    iFit, alphaSorder, alphaSnfmax;
   double mCharm, mBottom, alphaSQ0, alphaSMZ, distance, tolerance,
-         xx[65], qq[49], c[13][64][48][5][5];
+         xx[65], qq[49];
+
+  // Interpolation coefficients c[13][64][48][5][5], stored in cSave or
+  // in an optional binary image of the grid that is shared by processes.
+  typedef double CoeffGrid[64][48][5][5];
+  string dataFile, imageDir;
+  vector<double> cSave;
+  PDFGridImage gridImage;
+  const CoeffGrid* c;
 
   // Initialization of data array.
   void init( int iFitIn, string xmlPath, Info* infoPtr);
@@ -252,6 +369,10 @@ private:
   // Initialization through a stream.
   void init( istream& is, Info* infoPtr);
 
+  // Take the grid from its binary image, or write the image.
+  bool readImage();
+  bool writeImage();
+
   // Update PDF values.
   void xfUpdate(int , double x, double Q2);
 
@@ -291,20 +412,26 @@ class CTEQ6pdf : public PDF {
 
 public:
 
-  // Constructor.
+  // Constructor. If an image directory is given, the grid is kept in a
+  // binary image there, that is shared between processes.
   CTEQ6pdf(int idBeamIn = 2212, int iFitIn = 1, double rescaleIn = 1.,
-    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
-    : PDF(idBeamIn), doExtraPol(false) {rescale = rescaleIn,
-    init( iFitIn, xmlPath, infoPtr);}
+    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0,
+    string imageDirIn = "") : PDF(idBeamIn), doExtraPol(false),
+    imageDir(imageDirIn), upd(0) {rescale = rescaleIn,
+    isCacheable = true; init( iFitIn, xmlPath, infoPtr);}
 
   // Constructor with a stream.
   CTEQ6pdf(int idBeamIn, istream& is, bool isPdsGrid = false,
-    Info* infoPtr = 0) : PDF(idBeamIn), doExtraPol(false) {
-    init( is, isPdsGrid, infoPtr);}
+    Info* infoPtr = 0) : PDF(idBeamIn), doExtraPol(false), upd(0) {
+    isCacheable = true; init( is, isPdsGrid, infoPtr);}
 
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
 
+  // All flavours are updated together, so batches need no flavour loop.
+  void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {xfBatchAll( nPoints, x, Q2, xfOut);}
+
 private:
 
   // Constants: could only be changed in the code itself.
@@ -314,16 +441,30 @@ private:
   bool   doExtraPol;
   int    iFit, order, nQuark, nfMx, mxVal, nX, nT, nG,
          iGridX, iGridQ, iGridLX, iGridLQ;
-  double rescale, lambda, mQ[7], qIni, qMax, tv[26], xMin, xv[202], upd[57773],
+  double rescale, lambda, mQ[7], qIni, qMax, tv[26], xMin, xv[202],
          xvpow[202], xMinEps, xMaxEps, qMinEps, qMaxEps, fVec[5],
          tConst[9], xConst[9], dlx, xLast, qLast;
 
+  // The grid, stored in updSave or in an optional binary image of the
+  // grid that is shared by processes.
+  string dataFile, imageDir;
+  vector<double> updSave;
+  PDFGridImage gridImage;
+  const double* upd;
+
   // Initialization of data array.
   void init( int iFitIn, string xmlPath, Info* infoPtr);
 
   // Initialization through a stream.
   void init( istream& is, bool isPdsGrid, Info* infoPtr);
 
+  // Set up quantities derived from the grid.
+  void initDerived();
+
+  // Take the grid from its binary image, or write the image.
+  bool readImage();
+  bool writeImage();
+
   // Update PDF values.
   void xfUpdate(int id, double x, double Q2);
 
@@ -331,7 +472,7 @@ private:
   double parton6(int iParton, double x, double q);
 
   // Interpolation in grid.
-  double polint4F(double xgrid[], double fgrid[], double xin);
+  double polint4F(const double xgrid[], const double fgrid[], double xin);
 
 };
 
@@ -376,10 +517,11 @@ public:
 
   // Constructor.
   GRVpiL(int idBeamIn = 211, double rescaleIn = 1.) :
-    PDF(idBeamIn) {rescale = rescaleIn;}
+    PDF(idBeamIn) {rescale = rescaleIn; isCacheable = true;}
 
   // Allow for new rescaling factor of the PDF for VMD beams.
-  void setVMDscale(double rescaleIn = 1.) {rescale = rescaleIn;}
+  void setVMDscale(double rescaleIn = 1.) {rescale = rescaleIn;
+    resetCache();}
 
 private:
 
@@ -407,7 +549,7 @@ public:
     PomGluonA(PomGluonAIn), PomGluonB(PomGluonBIn),
     PomQuarkA(PomQuarkAIn), PomQuarkB(PomQuarkBIn),
     PomQuarkFrac(PomQuarkFracIn), PomStrangeSupp(PomStrangeSuppIn)
-    {init();}
+    {isCacheable = true; init();}
 
 private:
 
@@ -438,12 +580,12 @@ public:
  PomH1FitAB(int idBeamIn = 990, int iFit = 1, double rescaleIn = 1.,
    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
    : PDF(idBeamIn), doExtraPol(false)  {rescale = rescaleIn;
-   init( iFit, xmlPath, infoPtr);}
+   isCacheable = true; init( iFit, xmlPath, infoPtr);}
 
   // Constructor with a stream.
  PomH1FitAB(int idBeamIn, double rescaleIn, istream& is,
    Info* infoPtr = 0) : PDF(idBeamIn), doExtraPol(false) {
-   rescale = rescaleIn; init( is, infoPtr);}
+   rescale = rescaleIn; isCacheable = true; init( is, infoPtr);}
 
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
@@ -483,12 +625,12 @@ public:
   PomH1Jets(int idBeamIn = 990, int iFit = 1, double rescaleIn = 1.,
     string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
     : PDF(idBeamIn), doExtraPol(false) {rescale = rescaleIn;
-    init( iFit, xmlPath, infoPtr);}
+    isCacheable = true; init( iFit, xmlPath, infoPtr);}
 
   // Constructor with a stream.
   PomH1Jets(int idBeamIn, double rescaleIn, istream& is,
     Info* infoPtr = 0) : PDF(idBeamIn), doExtraPol(false) {rescale = rescaleIn;
-    init( is, infoPtr);}
+    isCacheable = true; init( is, infoPtr);}
 
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
@@ -656,12 +798,13 @@ public:
     string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
     : PDF(idBeamIn), fPDFGrid(NULL), fXGrid(NULL), fLogXGrid(NULL),
     fQ2Grid(NULL), fLogQ2Grid(NULL), fRes(NULL) {
-    init( iFitIn, xmlPath, infoPtr); };
+    isCacheable = true; init( iFitIn, xmlPath, infoPtr); };
 
   // Constructor with a stream.
   NNPDF(int idBeamIn, istream& is, Info* infoPtr = 0)
     : PDF(idBeamIn), fPDFGrid(NULL), fXGrid(NULL), fLogXGrid(NULL),
-    fQ2Grid(NULL), fLogQ2Grid(NULL), fRes(NULL) { init( is, infoPtr); };
+    fQ2Grid(NULL), fLogQ2Grid(NULL), fRes(NULL) { isCacheable = true;
+    init( is, infoPtr); };
 
   // Destructor.
   ~NNPDF() {
@@ -742,6 +885,12 @@ public:
   void setExtrapolate(bool extrapolate) {
     if (pdfPtr) pdfPtr->setExtrapolate(extrapolate);}
 
+  // Cache of recent (x, Q2) points, kept by the loaded object.
+  void setCache(bool useCacheIn) {if (pdfPtr) pdfPtr->setCache(useCacheIn);}
+  void resetCache() {if (pdfPtr) pdfPtr->resetCache();}
+  long nCacheHits() {return (pdfPtr) ? pdfPtr->nCacheHits() : 0;}
+  long nCacheMisses() {return (pdfPtr) ? pdfPtr->nCacheMisses() : 0;}
+
   // Read out parton density
   double xf(int id, double x, double Q2) {
     if (pdfPtr) return pdfPtr->xf(id, x, Q2); else return 0;}
@@ -815,7 +964,7 @@ public:
 
   // Constructor. Needs the randon number generator to sample valence content.
   CJKL(int idBeamIn = 22, Rndm* rndmPtrIn = 0 ) : PDF(idBeamIn) {
-    rndmPtr = rndmPtrIn; }
+    rndmPtr = rndmPtrIn; isCacheable = true; }
 
   // Functions to approximate pdfs for ISR.
   double gammaPDFxDependence(int id, double);
@@ -864,37 +1013,96 @@ class LHAGrid1 : public PDF {
 
 public:
 
-  // Constructor.
+  // Constructor. If an image directory is given, the grid is kept in a
+  // binary image there, that is shared between processes.
   LHAGrid1(int idBeamIn = 2212, string pdfWord = "void",
-    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
-    : PDF(idBeamIn), doExtraPol(false), pdfGrid(NULL), pdfSlope(NULL) {
-    init( pdfWord, xmlPath, infoPtr); };
+    string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0,
+    string imageDirIn = "") : PDF(idBeamIn), doExtraPol(false), nxPad(0),
+    imageDir(imageDirIn), gridPtr(0), slopePtr(0), nMem(1), Q2WtSav(-1.),
+    xWtSav(-1.) {isCacheable = true; init( pdfWord, xmlPath, infoPtr); };
 
   // Constructor with a stream.
   LHAGrid1(int idBeamIn, istream& is, Info* infoPtr = 0)
-    : PDF(idBeamIn), doExtraPol(false), pdfGrid(NULL), pdfSlope(NULL) {
+    : PDF(idBeamIn), doExtraPol(false), nxPad(0), gridPtr(0), slopePtr(0),
+    nMem(1), Q2WtSav(-1.), xWtSav(-1.) {isCacheable = true;
     init( is, infoPtr); };
 
-  // Destructor.
-  ~LHAGrid1() { if (pdfGrid) { for (int iid = 0; iid < 12; ++iid) {
-    for (int ix = 0; ix < nx; ++ix) delete[] pdfGrid[iid][ix];
-    delete[] pdfGrid[iid]; } delete[] pdfGrid; }
-    if (pdfSlope) { for (int iid = 0; iid < 12; ++iid) delete[] pdfSlope[iid];
-    delete[] pdfSlope;} };
-
   // Allow extrapolation beyond boundaries. This is optional.
-  void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
+  void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;
+    initPadding();}
+
+  // All flavours are updated together, so batches need no flavour loop.
+  void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {xfBatchAll( nPoints, x, Q2, xfOut);}
+
+  // Read in all the other members of the set, for PDF uncertainties.
+  // Requires a data file name ending in _0000.dat.
+  bool initMembers(Info* infoPtr = 0);
+
+  // Number of members of the set that are loaded.
+  int nMembers() {return nMem;}
+
+  // Parton density of flavour id for all members, xfOut[iMem], with
+  // one grid search and one set of interpolation weights for all.
+  void xfMembers(int id, double x, double Q2, double* xfOut);
+
+  // Calculate PDF envelope, as for LHAPDF6.
+  void calcPDFEnvelope(int idNow, double xNow, double Q2Now, int valSea);
+  void calcPDFEnvelope(pair<int,int> idNows, pair<double,double> xNows,
+    double Q2Now, int valSea);
+  PDFEnvelope getPDFEnvelope() {return pdfEnvelope;}
 
 private:
 
+  // Number of flavours stored for each grid point.
+  static const int NFLAV = 12;
+
+  // Constants: could only be changed in the code itself.
+  static const int    NXPADMAX;
+  static const double PDFMINVALUE, XPADRANGE, DLNXPAD;
+
   // Variables to be set during code initialization.
   bool   doExtraPol;
   int    nx, nq, nqSub;
   vector<int> nqSum;
-  double xMin, xMax, qMin, qMax, pdfVal[12];
+  double xMin, xMax, qMin, qMax, pdfVal[NFLAV];
   vector<double> xGrid, lnxGrid, qGrid, lnqGrid, qDiv;
-  double*** pdfGrid;
-  double** pdfSlope;
+
+  // Inverse denominators of the cubic interpolation weights, four for
+  // each starting grid point in ln(x) and in ln(q).
+  vector<double> wxDen, wqDen;
+
+  // The grid, in one array with the flavours of a (q, x) point adjacent:
+  // element (iq, ix, iid) is pdfGrid[(iq * nx + ix) * NFLAV + iid].
+  // Similarly pdfSlope[iq * NFLAV + iid] is the small-x slope.
+  vector<double> pdfGrid, pdfSlope;
+
+  // Extension of the grid below xMin, when extrapolating: nxPad points
+  // uniform in ln(x), from lnxPadMin up to xMin, with the power-law tails
+  // of the small-x slopes. Same ordering as the grid, with nxPad x points.
+  int    nxPad;
+  double lnxPadMin, dlnxPad;
+  vector<double> padGrid;
+
+  // Optional binary image of the grid. The interpolation uses gridPtr
+  // and slopePtr, that point either to the arrays above or to the image.
+  string dataFile, imageDir;
+  PDFGridImage gridImage;
+  const double *gridPtr, *slopePtr;
+
+  // All members of the set, if loaded, with the members of a grid point
+  // and flavour adjacent: element (iq, ix, iid, iMem) of memGrid is at
+  // ((iq * nx + ix) * NFLAV + iid) * nMem + iMem. Similarly memSlope.
+  // The error type and confidence level scale factor of the set.
+  int    nMem;
+  vector<double> memGrid, memSlope, memVal, memTmp;
+  string errorType;
+  double errorScale;
+  PDFEnvelope pdfEnvelope;
+
+  // The q interpolation of the latest Q2 value, and ditto for x.
+  double Q2WtSav, wqSav[4], xWtSav, wxSav[4];
+  int    n3qSav, m3qSav, inxSav, m3xSav;
 
   // Initialization of data array.
   void init( string pdfSet, string xmlPath, Info* infoPtr);
@@ -902,12 +1110,43 @@ private:
   // Initialization through a stream.
   void init( istream& is, Info* infoPtr);
 
+  // Take the grid from its binary image, or write the image.
+  bool readImage();
+  bool writeImage();
+
+  // Set up the extension of the grid below xMin.
+  void initPadding();
+
   // Update PDF values.
   void xfUpdate(int id, double x, double Q2);
 
-  // Interpolation in the grid for a given PDF flavour.
+  // Interpolation in the grid, for all flavours at once.
   void xfxevolve(double x, double Q2);
 
+  // Find the x grid position and the weights for interpolation in x.
+  void setXWeights(double x);
+
+  // Find the q subgrid and the weights for interpolation in q.
+  void setQ2Weights(double Q2);
+
+  // Interpolate grid flavour iid for all members, using stored weights.
+  void xfMembersGrid(double x, int iid, double* valOut);
+
+  // Envelope from the values of all members, by the error type.
+  void setEnvelope(const vector<double>& val);
+
+  // Inverse denominators of the cubic interpolation weights.
+  static void setWeightDenominators(const vector<double>& lnGrid,
+    vector<double>& wDen);
+
+  // Cubic interpolation weights at ln, given four grid points lnGrid
+  // and the inverse denominators wDen of their weights.
+  static void cubicWeights(double ln, const double* lnGrid,
+    const double* wDen, double* w) { double d0 = ln - lnGrid[0],
+    d1 = ln - lnGrid[1], d2 = ln - lnGrid[2], d3 = ln - lnGrid[3];
+    w[0] = d1 * d2 * d3 * wDen[0]; w[1] = d0 * d2 * d3 * wDen[1];
+    w[2] = d0 * d1 * d3 * wDen[2]; w[3] = d0 * d1 * d2 * wDen[3];}
+
 };
 
 //==========================================================================
@@ -1048,8 +1287,8 @@ class nPDF : public PDF {
 public:
 
   // Constructor.
-  nPDF(int idBeamIn = 2212, PDF* protonPDFPtrIn = 0) : PDF(idBeamIn)
-    { initNPDF(protonPDFPtrIn); }
+  nPDF(int idBeamIn = 2212, PDF* protonPDFPtrIn = 0) : PDF(idBeamIn),
+    doTable(false), hasTable(false) { initNPDF(protonPDFPtrIn); }
 
   // Update parton densities.
   void xfUpdate(int id, double x, double Q2);
@@ -1066,8 +1305,14 @@ public:
 
   // Set (and reset) the ratio of protons to nucleons to study nuclear
   // modifications of protons (= 1.0) and neutrons (= 0.0). By default Z/A.
-  void setMode(double zaIn) { za = zaIn; na = 1. - za; }
-  void resetMode() { za = double(z)/double(a); na = double(a-z)/double(a); }
+  void setMode(double zaIn) { za = zaIn; na = 1. - za; hasTable = false;}
+  void resetMode() { za = double(z)/double(a); na = double(a-z)/double(a);
+    hasTable = false;}
+
+  // Tabulate the nuclear PDFs, i.e. the proton PDF combined with the
+  // nuclear modifications, on one grid that is interpolated instead.
+  void setTabulate(bool doTableIn) {doTable = doTableIn; hasTable = false;
+    if (doTable) initTable();}
 
 protected:
 
@@ -1075,8 +1320,18 @@ protected:
   // classes.
   double ruv, rdv, ru, rd, rs, rc, rb, rg;
 
+  // The table has to be redone, e.g. when the error set is changed.
+  void clearTable() {hasTable = false;}
+
 private:
 
+  // Number of flavours stored for each point of the table.
+  static const int NFLTAB = 9;
+
+  // Constants: could only be changed in the code itself.
+  static const int    NXTAB, NQ2TAB;
+  static const double XMINTAB, Q2MINTAB, Q2MAXTAB, TOLTAB, XFMINTAB;
+
   // The nuclear mass number and number of protons (charge) and normalized
   // number of protons and neutrons.
   int a, z;
@@ -1085,6 +1340,24 @@ private:
   // Pointer to (free) proton PDF.
   PDF* protonPDFPtr;
 
+  // The table of nuclear PDFs, with the flavours of a grid point adjacent.
+  // The grid is uniform in u = ln(x) - 2 (1 - x) and in ln(Q2). Cells
+  // where the interpolation is not accurate enough, e.g. around the
+  // thresholds of the proton PDF, are marked to use the direct calculation.
+  bool   doTable, hasTable;
+  double uMinTab, duTab, lnQ2MinTab, dlnQ2Tab;
+  vector<double> table;
+  vector<bool>   cellOk;
+
+  // Set up the table.
+  void initTable();
+
+  // Interpolate in the table. False if outside it or in a marked cell.
+  bool xfTable(double x, double Q2, bool checkCell = true);
+
+  // The nuclear PDFs at a point, from the proton PDF and modifications.
+  void xfDirect(int id, double x, double Q2);
+
 };
 
 //==========================================================================
@@ -1122,7 +1395,7 @@ public:
   void rUpdate(int id, double x, double Q2);
 
   // Use other than central set to study uncertainties.
-  void setErrorSet(int iSetIn) {iSet = iSetIn;}
+  void setErrorSet(int iSetIn) {iSet = iSetIn; clearTable();}
 
 private:
 
@@ -1162,7 +1435,7 @@ public:
   void rUpdate(int id, double x, double Q2);
 
   // Use other than central set to study uncertainties.
-  void setErrorSet(int iSetIn) {iSet = iSetIn;}
+  void setErrorSet(int iSetIn) {iSet = iSetIn; clearTable();}
 
 private:
 
@@ -83,6 +83,12 @@ public:
   // For Les Houches with negative event weight needs
   virtual double sigmaSumSigned() const {return sigmaMx;}
 
+  // Store or reuse the outcome of the maximum search in setupSampling(),
+  // for the initialization cache. Only available for 2 -> 1/2/3 sampling.
+  bool   getSampling( vector<double>& values) const;
+  void   setSampling( const vector<double>& values) {samplingIn = values;}
+  bool   samplingReused() const {return isSamplingReused;}
+
   // Give back constructed four-vectors and known masses.
   Vec4   p(int i)   const {return pH[i];}
   double m(int i)   const {return mH[i];}
@@ -224,6 +230,11 @@ protected:
   double tauCoef[8], yCoef[8], zCoef[8], tauCoefSum[8], yCoefSum[8],
          zCoefSum[8];
 
+  // Outcome of the maximum search for 2 -> 1/2/3, when stored or reused.
+  bool   hasSampling123, isSamplingReused;
+  vector<double> samplingIn;
+  bool   reuseSampling123();
+
   // Calculate kinematical limits for 2 -> 1/2/3.
   bool limitTau(bool is2, bool is3);
   bool limitY();
@@ -24,6 +24,7 @@
 #include "Pythia8/HadronLevel.h"
 #include "Pythia8/History.h"
 #include "Pythia8/Info.h"
+#include "Pythia8/InitCache.h"
 #include "Pythia8/JunctionSplitting.h"
 #include "Pythia8/LesHouches.h"
 #include "Pythia8/Merging.h"
@@ -81,6 +82,10 @@ public:
   // Check consistency of version numbers (called by constructors).
   bool checkVersion();
 
+  // Write a binary image of the XML settings and particle databases,
+  // which later constructors read instead of the XML files, if up to date.
+  bool writeDatabase(string fileName = "");
+
   // Read in one update for a setting or particle data from a single line.
   bool readString(string, bool warn = true);
 
@@ -277,7 +282,8 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const double VERSIONNUMBERHEAD, VERSIONNUMBERCODE;
-  static const int    NTRY, SUBRUNDEFAULT;
+  static const int    NTRY, SUBRUNDEFAULT, DATABASEFORMAT;
+  static const string DATABASEFILE, DATABASEHEADER;
 
   // Initialization data, extracted from database.
   string xmlPath;
@@ -341,6 +347,14 @@ private:
   PDF* pdfVMDAPtr;
   PDF* pdfVMDBPtr;
 
+  // The PDFs with an (x, Q2) cache, to be emptied for each new event.
+  vector<PDF*> pdfCachePtrs;
+
+  // PDFs that can be shared between the beams and kept between init calls,
+  // keyed by the settings they were set up with, and the ones now in use.
+  map<string, PDF*> pdfSharedPtrs;
+  set<PDF*>         pdfSharedUsed;
+
   // Keep track when "new" has been used and needs a "delete" for PDF's etc.
   bool useNewPdfA, useNewPdfB, useNewPdfHard, useNewPdfPomA, useNewPdfPomB,
     useNewPdfGamA, useNewPdfGamB, useNewPdfHardGamA, useNewPdfHardGamB,
@@ -420,12 +434,24 @@ private:
   // The total cross section class is used both on process and parton level.
   SigmaTotal sigmaTot;
 
+  // Optional cache of initialization results, reused between runs.
+  InitCache  initCache;
+
   // The RHadrons class is used both at PartonLevel and HadronLevel.
   RHadrons   rHadrons;
 
   // Flags for handling generation of heavy ion collisons.
   bool        hasHeavyIons, hasOwnHeavyIons, doHeavyIons;
 
+  // Flag that the current next call is timed as a whole.
+  bool        isTimingNext;
+
+  // Read the binary image of the databases, if it is up to date.
+  bool readDatabase(string fileName);
+
+  // Size and modification time of a file, to check that it is unchanged.
+  bool fileStamp(string fileName, long long& size, long long& modTime);
+
   // Write the Pythia banner, with symbol and version information.
   void banner();
 
@@ -447,6 +473,15 @@ private:
   // Set up pointers to PDFs.
   bool initPDFs();
 
+  // Find a PDF among the shared ones, or else set it up and store it.
+  PDF* getSharedPDFPtr(int idIn, int sequence = 1, string beam = "");
+
+  // Name of the nucleon or pion PDF set to use for a beam.
+  string pdfSetWord(int idIn, int sequence = 1, string beam = "");
+
+  // Delete a PDF created with new, unless it is among the shared ones.
+  void deletePDF(PDF* pdfPtr);
+
   // Recalculate kinematics for each event when beam momentum has a spread.
   void nextKinematics();
 
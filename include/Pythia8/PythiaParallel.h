@@ -0,0 +1,149 @@
+// PythiaParallel.h is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a driver for multi-threaded event generation.
+// PythiaParallel: run several Pythia instances on a pool of threads,
+// or in worker processes forked from one initialized instance.
+// Note that this file requires C++11 (threads and function objects).
+
+#ifndef Pythia8_PythiaParallel_H
+#define Pythia8_PythiaParallel_H
+
+#include "Pythia8/Pythia.h"
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Pythia8 {
+
+// The C++11 functionality used below.
+using std::function;
+using std::mutex;
+using std::thread;
+
+//==========================================================================
+
+// The PythiaParallel class owns one helper Pythia object, that holds the
+// Settings and ParticleData databases, and a number of worker Pythia
+// objects. The workers are created with the Pythia(Settings&,
+// ParticleData&) constructor, so that the XML files are only read once,
+// are initialized once each, and then generate events on separate threads.
+// Alternatively a single worker is initialized, and then forked into
+// several processes that share its tables copy-on-write.
+
+class PythiaParallel {
+
+private:
+
+  // The helper object holds the databases; it is never initialized.
+  // Declared first, so that it exists when the references below are bound.
+  Pythia pythiaHelper;
+
+public:
+
+  // Constructor. (See PythiaParallel.cc file.)
+  PythiaParallel(string xmlDir = "../share/Pythia8/xmldoc",
+    bool printBanner = true);
+
+  // Destructor. (See PythiaParallel.cc file.)
+  ~PythiaParallel();
+
+  // Read in one update for a setting or particle data from a single line.
+  bool readString(string line, bool warn = true) {
+    return pythiaHelper.readString(line, warn);}
+
+  // Read in updates for settings or particle data from user-defined file.
+  bool readFile(string fileName, bool warn = true,
+    int subrun = SUBRUNDEFAULT) {
+    return pythiaHelper.readFile(fileName, warn, subrun);}
+  bool readFile(string fileName, int subrun) {
+    return pythiaHelper.readFile(fileName, true, subrun);}
+
+  // Initialize all workers. The optional function is called for each
+  // worker before its init(), e.g. to attach UserHooks or other objects.
+  bool init();
+  bool init(function<bool(Pythia*)> customInit);
+
+  // Generate nEvents accepted events, distributed over the workers. The
+  // callback is called once for each accepted event, with a pointer to
+  // the worker that generated it. Returns the number of accepted events.
+  long run(long nEvents, function<void(Pythia*)> callback);
+
+  // Print combined statistics on cross sections and errors.
+  void stat();
+
+  // Histograms filled by the callback, to be summed over the worker
+  // processes after each run. Not needed when threads are used.
+  void addHist(Hist& hist) {histPtrs.push_back(&hist);}
+
+  // Number of workers and access to them, e.g. for histograms.
+  int     nWorkers() const {return int(pythiaObjects.size());}
+  Pythia* worker(int i) {return (i >= 0 && i < nWorkers())
+    ? pythiaObjects[i] : 0;}
+
+  // Read in settings values: shorthand, not new functionality.
+  bool   flag(string key) {return settings.flag(key);}
+  int    mode(string key) {return settings.mode(key);}
+  double parm(string key) {return settings.parm(key);}
+  string word(string key) {return settings.word(key);}
+
+  // The Settings and ParticleData databases shared by all workers.
+  Settings&     settings;
+  ParticleData& particleData;
+
+  // Combined cross section and error statistics, filled after each run.
+  Info          info;
+
+private:
+
+  // Copy and = constructors are made private so they cannot be used.
+  PythiaParallel(const PythiaParallel&);
+  PythiaParallel& operator=(const PythiaParallel&);
+
+  // Constants: could only be changed in the code itself.
+  static const int SUBRUNDEFAULT, NSEEDMAX;
+
+  // The worker objects, one per thread, or only one when forking.
+  vector<Pythia*> pythiaObjects;
+
+  // Statistics returned by the worker processes, one for each, and
+  // the histograms to sum over them.
+  vector<Info>    infoForked;
+  vector<Hist*>   histPtrs;
+
+  // Status and run parameters.
+  bool   isInit, processAsync, counterBased, forkProcesses;
+  int    numThreads, nAllowErrors, seedBase, nForked;
+
+  // Number keying the next event when counter-based random numbers are used.
+  long   nEventKey;
+
+  // Serialize the user callback unless asynchronous processing is allowed.
+  mutex  callbackMutex;
+
+  // Delete all workers.
+  void   clearWorkers();
+
+  // Generate events in worker processes forked from the first worker.
+  long   runForked(long nEvents, function<void(Pythia*)> callback);
+
+  // Event loop inside a worker process; results written to file.
+  bool   runWorkerProcess(int iWorker, long nEvents,
+    function<void(Pythia*)> callback, string fileName);
+
+  // Read back the results of a worker process.
+  bool   readWorkerResults(string fileName, Info& infoOut, long& nAcc,
+    long& nTry, int& nErrors);
+
+  // Sum up cross section, counter and error statistics of all workers.
+  void   collectInfo();
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_PythiaParallel_H
@@ -128,6 +128,19 @@ string toLower(const string& name, bool trim = true);
 inline void toLowerRep(string& name, bool trim = true) {
   name = toLower( name, trim);}
 
+// Write and read a plain value or a string in binary form, e.g. for the
+// binary image of the settings and particle databases.
+template<typename T> inline void writeBinary(ostream& os, const T& val) {
+  os.write( reinterpret_cast<const char*>(&val), sizeof(T));}
+template<typename T> inline bool readBinary(istream& is, T& val) {
+  return bool( is.read( reinterpret_cast<char*>(&val), sizeof(T)));}
+inline void writeBinary(ostream& os, const string& val) {
+  int nChar = val.size(); writeBinary( os, nChar);
+  os.write( val.c_str(), nChar);}
+inline bool readBinary(istream& is, string& val) { int nChar = 0;
+  if (!readBinary( is, nChar) || nChar < 0) return false;
+  val.resize( nChar); return (nChar == 0 || is.read( &val[0], nChar));}
+
 // The Gamma function for real argument.
 double GammaReal(double x);
 
@@ -209,6 +209,13 @@ public:
   // Read in database from stream.
   bool init(istream& is, bool append = false) ;
 
+  // Read in database from, or write its defaults to, a binary image.
+  bool initBinary(istream& is) ;
+  bool writeBinary(ostream& os) ;
+
+  // The XML files read by the latest init from file.
+  vector<string> getXMLFiles() {return xmlFilesSave;}
+
   // Overwrite existing database by reading from specific file.
   bool reInit(string startFile = "../share/Pythia8/xmldoc/Index.xml") ;
 
@@ -388,6 +395,9 @@ public:
   vector<string> readStringHistory;
   map<int, vector<string> > readStringSubrun;
 
+  // The XML files read by init.
+  vector<string> xmlFilesSave;
+
   // Print out table of database, called from listAll and listChanged.
   void list(bool doListAll, bool doListString, string match);
 
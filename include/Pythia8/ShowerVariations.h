@@ -0,0 +1,58 @@
+// ShowerVariations.h is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Header file for the bookkeeping of shower uncertainty variations,
+// common to the initial- and final-state showers.
+// VariationList: shower uncertainty variations of one kind.
+
+#ifndef Pythia8_ShowerVariations_H
+#define Pythia8_ShowerVariations_H
+
+#include "Pythia8/PythiaStdlib.h"
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The VariationList class stores the shower uncertainty variations of one
+// kind, i.e. the weight index and the variation value of each, in
+// contiguous arrays. The showers fill the factor of each variation in
+// a tight loop, and then multiply it into the factors of all weights.
+
+class VariationList {
+
+public:
+
+  // Constructor.
+  VariationList() {}
+
+  // Copy the (iWeight, value) pairs of a map, and take the logarithms.
+  void init(const map<int,double>& varIn) {
+    iWeight.resize(0); value.resize(0); logValue.resize(0);
+    for (map<int,double>::const_iterator it = varIn.begin();
+      it != varIn.end(); ++it) { iWeight.push_back(it->first);
+      value.push_back(it->second);
+      logValue.push_back( (it->second > 0.) ? log(it->second) : 0.);}
+    fac.resize( iWeight.size(), 1.);}
+
+  // Number of variations.
+  int size() const {return iWeight.size();}
+
+  // Multiply the factors into those of all weights, and mark these.
+  void apply(vector<double>& facAll, vector<char>& doAll) const {
+    for (int j = 0; j < int(iWeight.size()); ++j) {
+      facAll[iWeight[j]] *= fac[j]; doAll[iWeight[j]] = 1;} }
+
+  // Weight indices, variation values and their logarithms, and factors.
+  vector<int>    iWeight;
+  vector<double> value, logValue, fac;
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_ShowerVariations_H
@@ -333,6 +333,9 @@ protected:
   int sizeBeamA() const {return inBeamA.size();}
   int sizeBeamB() const {return inBeamB.size();}
 
+  // Check whether the densities of a beam can be read in one batch.
+  static bool canBatch(const vector<InBeam>& inBeam);
+
   // Allowed colliding parton pairs, with pdf's.
   vector<InPair> inPair;
   void addPair(int idAIn, int idBIn) {
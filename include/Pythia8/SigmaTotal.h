@@ -413,10 +413,10 @@ class SigmaABMST : public SigmaTotAux {
 public:
 
   // Constructor.
-  SigmaABMST() {};
+  SigmaABMST() : infoPtr(0) {};
 
   // Initialize data members.
-  virtual void init( Info* , Settings& settings, ParticleData* ,
+  virtual void init( Info* infoPtrIn, Settings& settings, ParticleData* ,
     Rndm* rndmPtrIn);
 
   // Calculate integrated total/elastic cross sections.
@@ -461,6 +461,9 @@ private:
          ygap, ypow, expPygap, multSD, powSD, multDD, powDD,
          multCD, powCD, mMinCDnow, bMinSD, bMinDD, bMinCD;
 
+  // Pointer to various information on the generation.
+  Info*  infoPtr;
+
   // The scattering amplitude, from which cross sections are derived.
   complex amplitude( double t, bool useCoulomb = false,
     bool onlyPomerons = false) ;
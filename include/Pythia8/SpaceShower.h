@@ -5,6 +5,7 @@
 
 // Header file for the spacelike initial-state showers.
 // SpaceDipoleEnd: radiating dipole end in ISR.
+// SpaceDipoleTrial: trial emission of a dipole end, kept for reuse.
 // SpaceShower: handles the showering description.
 
 #ifndef Pythia8_SpaceShower_H
@@ -19,6 +20,7 @@
 #include "Pythia8/PartonVertex.h"
 #include "Pythia8/PythiaStdlib.h"
 #include "Pythia8/Settings.h"
+#include "Pythia8/ShowerVariations.h"
 #include "Pythia8/StandardModel.h"
 #include "Pythia8/UserHooks.h"
 #include "Pythia8/MergingHooks.h"
@@ -78,6 +80,45 @@ public:
 
 //==========================================================================
 
+// The state of a radiating dipole end when its trial emission was made,
+// the range of that trial, and the parton densities used for the
+// overestimated evolution coefficient; only used inside SpaceShower.
+
+class SpaceDipoleTrial {
+
+public:
+
+  // Constructor.
+  SpaceDipoleTrial() : isValid(false), isFirstRad(false), hasTrial(false),
+    hasPDF(false), isTinyPDF(false), iRadiator(0), iRecoiler(0),
+    iColPartner(0), idDaughter(0), colType(0), chgType(0), MEtype(0),
+    nBranch(0), beamVersion(0), nFlavPDF(0), x1(0.), x2(0.), m2Dip(0.),
+    m2ColPair(0.), pT2beg(0.), pT2end(0.), pT2(0.), pT2PDF(0.),
+    xPDFdaughter(0.), xPDFmotherSum(0.), xPDFgMother(0.) {
+    for (int i = 0; i < 21; ++i) xPDFmother[i] = 0.;}
+
+  // Check that the dipole end is in the same state as when kept.
+  bool sameDipole(const SpaceDipoleTrial& key) const {
+    return isValid && key.isValid && key.iRadiator == iRadiator
+      && key.iRecoiler == iRecoiler && key.iColPartner == iColPartner
+      && key.idDaughter == idDaughter && key.colType == colType
+      && key.chgType == chgType && key.MEtype == MEtype
+      && key.nBranch == nBranch && key.beamVersion == beamVersion
+      && key.isFirstRad == isFirstRad && key.x1 == x1 && key.x2 == x2
+      && key.m2Dip == m2Dip && key.m2ColPair == m2ColPair;}
+
+  // Properties of the dipole end and its beam, the trial scales,
+  // and the parton densities with the scale they were evaluated at.
+  bool   isValid, isFirstRad, hasTrial, hasPDF, isTinyPDF;
+  int    iRadiator, iRecoiler, iColPartner, idDaughter, colType, chgType,
+         MEtype, nBranch, beamVersion, nFlavPDF;
+  double x1, x2, m2Dip, m2ColPair, pT2beg, pT2end, pT2, pT2PDF,
+         xPDFdaughter, xPDFmotherSum, xPDFgMother, xPDFmother[21];
+
+} ;
+
+//==========================================================================
+
 // The SpaceShower class does spacelike showers.
 
 class SpaceShower {
@@ -280,10 +321,8 @@ private:
 
   // Bookkeeping of enhanced  actual or trial emissions (see EPJC (2013) 73).
   bool doTrialNow, canEnhanceEmission, canEnhanceTrial, canEnhanceET;
-  string splittingNameNow, splittingNameSel;
-  map< double, pair<string,double> > enhanceFactors;
-  void storeEnhanceFactor(double pT2, string name, double enhanceFactorIn)
-    { enhanceFactors.insert(make_pair(pT2,make_pair(name,enhanceFactorIn)));}
+  SplitKernel splitKernelNow, splitKernelSel;
+  double      enhanceFacNow, enhanceFacSel;
 
   // List of emissions in different sides in different systems:
   vector<int> nRadA,nRadB;
@@ -291,6 +330,15 @@ private:
   // All dipole ends
   vector<SpaceDipoleEnd> dipEnd;
 
+  // Trial emissions kept for reuse, the current state of each dipole end,
+  // and the versions of the two beam remnant states.
+  bool   reuseTrials;
+  int    beamVersion[2];
+  BeamParticle* beamSavePtr[2];
+  vector<double> beamState[2], beamStateNow;
+  vector<SpaceDipoleTrial> dipTrial, dipKey;
+  SpaceDipoleTrial* pdfSavePtr;
+
   // List of 2 -> 2 momenta for external weak setup.
   vector<Vec4> weakMomenta;
 
@@ -300,6 +348,12 @@ private:
   int iDipSel;
   SpaceDipoleEnd* dipEndSel;
 
+  // Update the version number of a beam when its remnant state changed.
+  void checkBeamState( BeamParticle* beamPtrIn, int iBeam);
+
+  // Current state of a dipole end, for reuse of its trial emission.
+  SpaceDipoleTrial trialKey( const SpaceDipoleEnd& dip, Event& event);
+
   // Evolve a QCD dipole end.
   void pT2nextQCD( double pT2begDip, double pT2endDip);
 
@@ -337,6 +391,12 @@ private:
   map<int,double> varG2GGmuRfac, varQ2QGmuRfac, varQ2GQmuRfac, varG2QQmuRfac,
     varX2XGmuRfac;
   map<int,double> varG2GGcNS, varQ2QGcNS, varQ2GQcNS, varG2QQcNS, varX2XGcNS;
+  // The same variations in contiguous arrays, for the evaluation, and the
+  // factors and flags of all weights, reused between calls.
+  VariationList uVarG2GGmuR, uVarQ2QGmuR, uVarG2QQmuR, uVarX2XGmuR,
+                uVarG2GGcNS, uVarQ2QGcNS, uVarG2QQcNS, uVarX2XGcNS;
+  vector<double> uVarFac;
+  vector<char>   doVar;
   map<int,double>* varPDFplus;
   map<int,double>* varPDFminus;
   map<int,double>* varPDFmember;
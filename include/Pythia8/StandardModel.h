@@ -4,6 +4,7 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // This file gives access to some Standard Model parameters.
+// AlphaTable: optional table of running couplings, for fast lookup.
 // AlphaStrong: fix or first- or second-order running alpha_strong.
 
 #ifndef Pythia8_StandardModel_H
@@ -17,6 +18,83 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The AlphaTable class stores a few values of a running coupling at nodes
+// evenly spaced in a variable t, that equals log2(Q^2) at powers of two
+// and is linear in Q^2 in between, so that a node is found from the
+// exponent and mantissa of Q^2, without any logarithm. Octaves contain
+// an integer number of cells, and values are interpolated linearly in t.
+// Cells that fail the accuracy requirement are marked not to be used.
+
+class AlphaTable {
+
+public:
+
+  // Constructor.
+  AlphaTable() : nVal(0), nCell(0), nPerOct(0.), iMin(0.), scale2Lo(0.),
+    scale2Hi(0.) {}
+
+  // Set up nodes from below scale2Min to above scale2Max, with
+  // nPerOctIn cells per factor two in Q^2, for nValIn values each.
+  void init(double scale2MinIn, double scale2MaxIn, int nPerOctIn,
+    int nValIn);
+
+  // Remove the table.
+  void clear() {nVal = nCell = 0; scale2Lo = scale2Hi = 0.;
+    values.resize(0); cellOk.resize(0);}
+
+  // Number of cells, Q^2 at a node, or in the middle of a cell.
+  int    nCells() const {return nCell;}
+  double scale2Node(int iNode) const {return scale2T( iNode);}
+  double scale2Mid(int iCell) const {return scale2T( iCell + 0.5);}
+
+  // Cell containing a Q^2 value, -1 if outside table.
+  int    cell(double scale2) const { int iCell = -1;
+    if (scale2 >= scale2Lo && scale2 < scale2Hi)
+      iCell = min( int(pCell( scale2)), nCell - 1);
+    return iCell;}
+
+  // Set the values at a node, and mark a cell not to be used.
+  void   setValue(int iNode, int iVal, double val) {
+    values[iNode * nVal + iVal] = val;}
+  void   rejectCell(int iCell) {
+    if (iCell >= 0 && iCell < nCell) cellOk[iCell] = false;}
+
+  // Interpolated values. False if outside the table or in a rejected cell.
+  bool   interpolate(double scale2, double* valOut) const {
+    if (!(scale2 >= scale2Lo && scale2 < scale2Hi)) return false;
+    double p = pCell( scale2);
+    int iCell = min( int(p), nCell - 1);
+    if (!cellOk[iCell]) return false;
+    p -= iCell;
+    const double* valNow = &values[iCell * nVal];
+    for (int iVal = 0; iVal < nVal; ++iVal) valOut[iVal] = valNow[iVal]
+      + p * (valNow[nVal + iVal] - valNow[iVal]);
+    return true;}
+
+private:
+
+  // Number of values per node, number of cells, cells per octave,
+  // number of cells from t = 0 to the first node, and Q^2 range.
+  int    nVal, nCell;
+  double nPerOct, iMin, scale2Lo, scale2Hi;
+
+  // The values, with those of a node adjacent, and which cells to use.
+  vector<double> values;
+  vector<bool>   cellOk;
+
+  // Position of Q^2 in units of cells from the first node.
+  double pCell(double scale2) const { int expo;
+    double mant = frexp( scale2, &expo);
+    return (expo + 2. * mant - 2.) * nPerOct - iMin;}
+
+  // Q^2 at a position in units of cells from the first node.
+  double scale2T(double p) const {double t = (p + iMin) / nPerOct;
+    double tFloor = floor(t); return ldexp( 1. + t - tFloor, int(tFloor));}
+
+};
+
+//==========================================================================
+
 // The AlphaStrong class calculates the alpha_strong value at an arbitrary
 // scale, given the value at m_Z, to zeroth, first or second order.
 
@@ -29,7 +107,8 @@ public:
     Lambda3Save(0.), Lambda4Save(0.), Lambda5Save(0.), Lambda6Save(0.),
     Lambda3Save2(0.), Lambda4Save2(0.), Lambda5Save2(0.), Lambda6Save2(0.),
     scale2Min(0.), mc(0.), mb(0.), mt(0.), mc2(0.), mb2(0.), mt2(0.),
-    lastCallToFull(false), valueRef(0.), valueNow(0.), scale2Now(0.) {}
+    lastCallToFull(false), doTable(false), valueRef(0.), valueNow(0.),
+    scale2Now(0.) {}
 
   // Destructor.
   virtual ~AlphaStrong() {}
@@ -58,6 +137,10 @@ public:
   // Return the CMW factor (for nF between 3 and 6).
   double facCMW( int nFin);
 
+  // Optionally interpolate in a table of values, set up at initialization.
+  void setTabulate(bool doTableIn) {doTable = doTableIn; initTable();}
+  int  nTableCells() const {return table.nCells();}
+
 // Protected data members: accessible to derived classes.
 protected:
 
@@ -90,12 +173,17 @@ protected:
 private:
 
   // Private constants: could only be changed in the code itself.
-  static const int    NITER;
+  static const int    NITER, NPEROCTTAB;
+  static const double SCALE2MAXTAB, TOLTAB;
 
   // Private data members.
-  bool   lastCallToFull;
+  bool   lastCallToFull, doTable;
   double valueRef, valueNow, scale2Now;
 
+  // Optional table of first-order values and second-order corrections.
+  AlphaTable table;
+  void   initTable();
+
 };
 
 //==========================================================================
@@ -108,7 +196,7 @@ class AlphaEM {
 public:
 
   // Constructors.
-  AlphaEM() {}
+  AlphaEM() : doTable(false), order(0) {}
 
   // Initialization for a given order.
   void init(int orderIn, Settings* settingsPtr);
@@ -116,15 +204,24 @@ public:
   // alpha_EM value.
   double alphaEM(double scale2);
 
+  // Optionally interpolate in a table of values, set up at initialization.
+  void setTabulate(bool doTableIn) {doTable = doTableIn; initTable();}
+
 private:
 
   // Constants: could only be changed in the code itself.
-  static const double MZ, Q2STEP[5], BRUNDEF[5];
+  static const int    NPEROCTTAB;
+  static const double MZ, Q2STEP[5], BRUNDEF[5], SCALE2MAXTAB, TOLTAB;
 
   // Data members.
+  bool   doTable;
   int    order;
   double alpEM0, alpEMmZ, mZ2, bRun[5], alpEMstep[5];
 
+  // Optional table of values.
+  AlphaTable table;
+  void   initTable();
+
 };
 
 //==========================================================================
@@ -4,7 +4,9 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // Header file for the timelike final-state showers.
+// TimeDipoleME: precompiled matrix-element correction of a dipole end.
 // TimeDipoleEnd: data on a radiating dipole end.
+// TimeDipoleTrial: trial emission of a dipole end, kept for reuse.
 // TimeShower: handles the showering description.
 
 #ifndef Pythia8_TimeShower_H
@@ -19,6 +21,7 @@
 #include "Pythia8/PythiaStdlib.h"
 #include "Pythia8/PartonVertex.h"
 #include "Pythia8/Settings.h"
+#include "Pythia8/ShowerVariations.h"
 #include "Pythia8/StandardModel.h"
 #include "Pythia8/UserHooks.h"
 #include "Pythia8/MergingHooks.h"
@@ -28,6 +31,38 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// Matrix-element correction of a dipole end, precompiled from its MEtype
+// by TimeShower::setupMEcorr, so that each trial branching only has to
+// look up how to evaluate it. Redone wherever the dipole end is created
+// or its MEtype or type changed. Only used inside TimeShower class.
+
+class TimeDipoleME {
+
+public:
+
+  // The ways findMEcorr can evaluate the correction.
+  enum Mode {NOCORR = 0, QCD, QEDCHARGE, QEDVECTOR, WEAKSCHANNEL,
+    WEAKTCHANNEL};
+
+  // Constructor.
+  TimeDipoleME() : mode(NOCORR), kind(0), expr(0), wt1(1.), wt2(0.),
+    offset(0.) { }
+
+  // Evaluation mode, and ME kind for calcMEcorr.
+  Mode   mode;
+  int    kind;
+
+  // Expressions of calcMEcorr to use: 0 = the single one of the kind,
+  // 1 = vector, 2 = axial, 3 = mixture of both, 4 = their sum.
+  int    expr;
+
+  // Coupling weights of vector and axial parts, and eikonal offset factor.
+  double wt1, wt2, offset;
+
+};
+
+//==========================================================================
+
 // Data on radiating dipole ends; only used inside TimeShower class.
 
 class TimeDipoleEnd {
@@ -65,6 +100,9 @@ public:
   double MEmix;
   bool   MEorder, MEsplit, MEgluinoRec, isFlexible;
 
+  // Precompiled matrix-element correction, set by setupMEcorr.
+  TimeDipoleME MEcorr;
+
   // Properties specific to current trial emission.
   int    flavour, iAunt;
   double mRad, m2Rad, mRec, m2Rec, mDip, m2Dip, m2DipCorr,
@@ -74,6 +112,61 @@ public:
 
 //==========================================================================
 
+// Trial emission of a dipole end, kept for reuse in the next pTnext call
+// as long as the dipole end and its radiator and recoiler are unchanged.
+// Then pT2 is the first emission below pT2beg or, if vanishing, there
+// is none above pT2end. Only used inside TimeShower class.
+
+class TimeDipoleTrial {
+
+public:
+
+  // Constructor.
+  TimeDipoleTrial() : isValid(false), iRadiator(-1), iRecoiler(-1),
+    iMEpartner(-1), colType(0), chgType(0), MEtype(0), pT2cap(0.),
+    pT2beg(0.), pT2end(0.), pT2(0.) { }
+
+  // Only QCD and QED dipole ends with a local recoiler are kept.
+  static bool canKeep(const TimeDipoleEnd& dip) {
+    return dip.isrType == 0 && dip.weakType == 0 && dip.colvType == 0
+      && (dip.colType != 0 || dip.chgType != 0 || dip.gamType != 0)
+      && dip.m2DipCorr >= 0.;}
+
+  // Store the outcome of a new trial.
+  void set(const TimeDipoleEnd& dip, const Event& event, double pT2begIn,
+    double pT2endIn) { isValid = true; iRadiator = dip.iRadiator;
+    iRecoiler = dip.iRecoiler; iMEpartner = dip.iMEpartner;
+    colType = dip.colType; chgType = dip.chgType; MEtype = dip.MEtype;
+    pRad = event[iRadiator].p(); pRec = event[iRecoiler].p();
+    pT2cap = 0.25 * dip.m2DipCorr; pT2beg = pT2begIn; pT2end = pT2endIn;
+    pT2 = dip.pT2;}
+
+  // Check that the dipole end is the one the trial was made for.
+  bool matches(const TimeDipoleEnd& dip, const Event& event) const {
+    return isValid && dip.iRadiator == iRadiator
+      && dip.iRecoiler == iRecoiler && dip.iMEpartner == iMEpartner
+      && dip.colType == colType && dip.chgType == chgType
+      && dip.MEtype == MEtype && dip.pT2 == pT2
+      && sameMomentum( event[iRadiator].p(), pRad)
+      && sameMomentum( event[iRecoiler].p(), pRec);}
+
+  // Properties of the dipole end, and the trial scales.
+  bool   isValid;
+  int    iRadiator, iRecoiler, iMEpartner, colType, chgType, MEtype;
+  Vec4   pRad, pRec;
+  double pT2cap, pT2beg, pT2end, pT2;
+
+private:
+
+  // Exact equality of two four-momenta.
+  static bool sameMomentum(const Vec4& p1, const Vec4& p2) {
+    return p1.px() == p2.px() && p1.py() == p2.py() && p1.pz() == p2.pz()
+      && p1.e() == p2.e();}
+
+};
+
+//==========================================================================
+
 // The TimeShower class does timelike showers.
 
 class TimeShower {
@@ -251,6 +344,7 @@ private:
   static const double MCMIN, MBMIN, SIMPLIFYROOT, XMARGIN, XMARGINCOMB,
          TINYPDF, LARGEM2, THRESHM2, LAMBDA3MARGIN, WEAKPSWEIGHT, WG2QEXTRA,
          REJECTFACTOR, PROBLIMIT;
+  static const int    NMEKIND, MEKINDEXPR[];
   // Rescatter: try to fix up recoil between systems
   static const bool   FIXRESCATTER, VETONEGENERGY;
   static const double MAXVIRTUALITYFRACTION, MAXNEGENERGYFRACTION;
@@ -291,16 +385,18 @@ private:
   // Bookkeeping of enhanced  actual or trial emissions (see EPJC (2013) 73).
   bool doTrialNow, canEnhanceEmission, canEnhanceTrial, canEnhanceET,
        doUncertaintiesNow;
-  string splittingNameNow, splittingNameSel;
-  map< double, pair<string,double> > enhanceFactors;
-  void storeEnhanceFactor(double pT2, string name, double enhanceFactorIn)
-    { enhanceFactors.insert(make_pair(pT2,make_pair(name,enhanceFactorIn)));}
+  SplitKernel splitKernelNow, splitKernelSel;
+  double      enhanceFacNow, enhanceFacSel;
 
   // All dipole ends and a pointer to the selected hardest dipole end.
   vector<TimeDipoleEnd> dipEnd;
   TimeDipoleEnd* dipSel;
   int iDipSel;
 
+  // Optionally reuse the trial emissions of unchanged dipole ends.
+  bool   reuseTrials;
+  vector<TimeDipoleTrial> dipTrial;
+
   // Setup a dipole end, either QCD, QED/photon, weak or Hidden Valley one.
   void setupQCDdip( int iSys, int i, int colTag,  int colSign, Event& event,
     bool isOctetOnium = false, bool limitPTmaxIn = true);
@@ -337,6 +433,12 @@ private:
   // Find mixture of V and A in gamma/Z: energy- and flavour-dependent.
   double gammaZmix( Event& event, int iRes, int iDau1, int iDau2);
 
+  // Precompile how the ME correction of a dipole end is evaluated.
+  void setupMEcorr( TimeDipoleEnd& dip);
+
+  // Set the ME kind, expressions and coupling weights to use.
+  void setMEcoef( TimeDipoleME& me, int kind, int combiIn, double mixIn);
+
   // Set up to calculate QCD ME correction with calcMEcorr.
   double findMEcorr(TimeDipoleEnd* dip, Particle& rad, Particle& partner,
    Particle& emt, bool cutEdge = true);
@@ -346,8 +448,8 @@ private:
    Vec4 emt, Vec4 p3, Vec4 p4, Vec4 radBef, Vec4 recBef);
 
   // Calculate value of QCD ME correction.
-  double calcMEcorr( int kind, int combiIn, double mixIn, double x1,
-    double x2, double r1, double r2, double r3 = 0., bool cutEdge = true);
+  double calcMEcorr( const TimeDipoleME& me, double x1, double x2,
+    double r1, double r2, double r3 = 0., bool cutEdge = true);
 
   // Find coefficient of azimuthal asymmetry from gluon polarization.
   void findAsymPol( Event& event, TimeDipoleEnd* dip);
@@ -379,6 +481,12 @@ private:
   map<int,double> varG2GGmuRfac;
   map<int,double> varQ2QGmuRfac, varG2QQmuRfac, varX2XGmuRfac;
   map<int,double> varG2GGcNS, varQ2QGcNS, varG2QQcNS, varX2XGcNS;
+  // The same variations in contiguous arrays, for the evaluation, and the
+  // factors and flags of all weights, reused between calls.
+  VariationList uVarG2GGmuR, uVarQ2QGmuR, uVarG2QQmuR, uVarX2XGmuR,
+                uVarG2GGcNS, uVarQ2QGcNS, uVarG2QQcNS, uVarX2XGcNS;
+  vector<double> uVarFac;
+  vector<char>   doVar;
   map<int,double>* varPDFplus;
   map<int,double>* varPDFminus;
   map<int,double>* varPDFmember;
@@ -24,6 +24,19 @@ class PhaseSpace;
 
 //==========================================================================
 
+// Integer codes of the shower splitting kernels that can be enhanced.
+// The corresponding names, as used by UserHooks::enhanceFactor(string),
+// are obtained with UserHooks::splitKernelName.
+
+enum SplitKernel { noSplit = 0,
+  fsrQ2QG, fsrG2GG, fsrG2QQ, fsrG2QQcc, fsrG2QQbb, fsrQ2QA, fsrA2LL,
+  fsrA2QQ, fsrQ2QW, fsrQ2QHV,
+  isrG2GG, isrQ2GQ, isrQ2QG, isrG2QQ, isrG2QQcc, isrG2QQbb, isrQ2QA,
+  isrQ2AQ, isrA2QQ, isrQ2QW,
+  nSplitKernel };
+
+//==========================================================================
+
 // UserHooks is base class for user access to program execution.
 
 class UserHooks {
@@ -191,6 +204,22 @@ public:
   void setEnhancedEventWeight(double wt) { enhancedEventWeight = wt;}
   double getEnhancedEventWeight() { return enhancedEventWeight;}
 
+  // Enhancement factor and veto probability by integer splitting-kernel
+  // code, as used by the showers. The enhancement factor is only obtained
+  // from the method above once per kernel, and then kept until reset.
+  double enhanceFactorByKernel( SplitKernel kernel) {
+    if (!hasEnhanceSave[kernel]) { hasEnhanceSave[kernel] = true;
+      enhanceSave[kernel] = enhanceFactor( splitKernelName(kernel));}
+    return enhanceSave[kernel];}
+  double vetoProbabilityByKernel( SplitKernel kernel) {
+    return vetoProbability( splitKernelName(kernel));}
+  void resetEnhanceFactors() {
+    for (int i = 0; i < nSplitKernel; ++i) hasEnhanceSave[i] = false;}
+
+  // Name of a splitting kernel, e.g. "fsr:G2QQ:cc" for fsrG2QQcc.
+  static const string& splitKernelName( SplitKernel kernel) {
+    return SPLITKERNELNAME[kernel];}
+
   // Bookkeeping of weights for enhanced actual or trial emissions
   // (sec. 3 in EPJC (2013) 73).
   virtual bool canEnhanceTrial() {return false;}
@@ -221,7 +250,8 @@ protected:
   // Constructor.
   UserHooks() : infoPtr(0), settingsPtr(0), particleDataPtr(0), rndmPtr(0),
     beamAPtr(0), beamBPtr(0), beamPomAPtr(0), beamPomBPtr(0), coupSMPtr(0),
-    partonSystemsPtr(0), sigmaTotPtr(0), selBias(1.) {}
+    partonSystemsPtr(0), sigmaTotPtr(0), selBias(1.) {
+    resetEnhanceFactors();}
 
   // Pointer to various information on the generation.
   Info*          infoPtr;
@@ -265,6 +295,15 @@ protected:
   // Bookkept quantities for boosted event weights.
   double enhancedEventWeight, pTEnhanced, wtEnhanced;
 
+private:
+
+  // Names of the splitting kernels.
+  static const string SPLITKERNELNAME[nSplitKernel];
+
+  // Enhancement factors obtained so far, by splitting kernel.
+  bool   hasEnhanceSave[nSplitKernel];
+  double enhanceSave[nSplitKernel];
+
 };
 
 //==========================================================================
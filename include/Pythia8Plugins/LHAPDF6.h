@@ -99,11 +99,15 @@ public:
   // Constructor.
   LHAPDF6(int idBeamIn, string setName, int member, int, Info* infoPtr)
     : PDF(idBeamIn), pdf(0), extrapol(false)
-    { init(setName, member, infoPtr); }
+    { isCacheable = true; init(setName, member, infoPtr); }
 
   // Allow extrapolation beyond boundaries (not implemented).
   void setExtrapolate(bool extrapolIn) {extrapol = extrapolIn;}
 
+  // All flavours are updated together, so batches need no flavour loop.
+  void xfBatch(int nPoints, const double* x, const double* Q2,
+    double* xfOut) {xfBatchAll( nPoints, x, Q2, xfOut);}
+
 private:
 
   // The LHAPDF objects.
@@ -112,6 +116,9 @@ private:
   ::LHAPDF::Extrapolator *ext;
   bool extrapol;
 
+  // All quark and gluon densities of the latest point, ids -6 to 6.
+  vector<double> xfAll;
+
   // Initialization of PDF set.
   void init(string setName, int member, Info* infoPtr);
 
@@ -202,16 +209,17 @@ void LHAPDF6::xfUpdate(int, double x, double Q2) {
   if (Q2 < pdf->q2Min() ) Q2 = pdf->q2Min();
   if (Q2 > pdf->q2Max() ) Q2 = pdf->q2Max();
 
-  // Update values.
-  xg     = pdf->xfxQ2(21, x, Q2);
-  xu     = pdf->xfxQ2(2,  x, Q2);
-  xd     = pdf->xfxQ2(1,  x, Q2);
-  xs     = pdf->xfxQ2(3,  x, Q2);
-  xubar  = pdf->xfxQ2(-2, x, Q2);
-  xdbar  = pdf->xfxQ2(-1, x, Q2);
-  xsbar  = pdf->xfxQ2(-3, x, Q2);
-  xc     = pdf->xfxQ2(4,  x, Q2);
-  xb     = pdf->xfxQ2(5,  x, Q2);
+  // Update values. Quarks and gluon in one call, indexed by id + 6.
+  pdf->xfxQ2(x, Q2, xfAll);
+  xg     = xfAll[6];
+  xu     = xfAll[8];
+  xd     = xfAll[7];
+  xs     = xfAll[9];
+  xubar  = xfAll[4];
+  xdbar  = xfAll[5];
+  xsbar  = xfAll[3];
+  xc     = xfAll[10];
+  xb     = xfAll[11];
   xgamma = pdf->xfxQ2(22, x, Q2);
 
   // Subdivision of valence and sea.
@@ -18,7 +18,7 @@ namespace Pythia8 {
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm
+// Marsaglia-Zaman-Tsang algorithm, or the counter-based Philox algorithm.
 
 //--------------------------------------------------------------------------
 
@@ -28,6 +28,16 @@ namespace Pythia8 {
 // The default seed, i.e. the Marsaglia-Zaman random number sequence.
 const int Rndm::DEFAULTSEED     = 19780503;
 
+// Multipliers and Weyl key increments of Philox-4x32, cf.
+// J.K. Salmon et al., Proc. SC11 (2011) 16.
+const unsigned int Rndm::PHILOXM0 = 0xD2511F53;
+const unsigned int Rndm::PHILOXM1 = 0xCD9E8D57;
+const unsigned int Rndm::PHILOXW0 = 0x9E3779B9;
+const unsigned int Rndm::PHILOXW1 = 0xBB67AE85;
+
+// Number of Philox blocks generated in parallel in batch mode.
+const int Rndm::PHILOXLANES       = 16;
+
 //--------------------------------------------------------------------------
 
 // Method to pass in pointer for external random number generation.
@@ -93,6 +103,130 @@ void Rndm::init(int seedIn) {
   initRndm  = true;
   seedSave  = seed;
   sequence  = 0;
+  isCounterBased = false;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Initialize counter-based generation. The seed and stream number form
+// the key, and the event number and a running counter within the event
+// form the counter, of the Philox-4x32-10 algorithm. Event number -1 is
+// used for the initialization stage.
+
+void Rndm::initCounter(int seedIn, int streamIn) {
+
+  // Pick seed in same way as above.
+  int seed = seedIn;
+  if (seedIn < 0) seed = DEFAULTSEED;
+  else if (seedIn == 0) seed = int(time(0));
+  if (seed < 0) seed = -seed;
+
+  // Reset counters.
+  initRndm       = true;
+  isCounterBased = true;
+  eventIsSet     = false;
+  seedSave       = seed;
+  streamSave     = max( 0, streamIn);
+  eventSave      = -1;
+  counterSave    = 0;
+  nBuffer        = 0;
+  sequence       = 0;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Counter-based generation: restart the sequence for a given event.
+// The following call to nextEvent() will not change the event number.
+
+void Rndm::setEvent(long eventIn) {
+
+  if (!isCounterBased) return;
+  eventSave   = eventIn;
+  eventIsSet  = true;
+  counterSave = 0;
+  nBuffer     = 0;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Counter-based generation: restart the sequence for the next event,
+// unless the event number already was set explicitly.
+
+void Rndm::nextEvent() {
+
+  if (!isCounterBased) return;
+  if (!eventIsSet) ++eventSave;
+  eventIsSet  = false;
+  counterSave = 0;
+  nBuffer     = 0;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate nBlock consecutive Philox-4x32-10 blocks, each giving two
+// random numbers. Blocks are processed in parallel lanes, with the ten
+// rounds outermost, so that the inner loops can be vectorized.
+
+void Rndm::philoxBlocks(long counterIn, int nBlock, double* out) {
+
+  // Constants to combine 53 bits to each number.
+  const double TWO26  = 67108864.;
+  const double TWOM53 = 1. / 9007199254740992.;
+
+  // Event number is common to all blocks.
+  unsigned long long evt = static_cast<unsigned long long>(eventSave);
+  unsigned int evtLow    = static_cast<unsigned int>(evt);
+  unsigned int evtHigh   = static_cast<unsigned int>(evt >> 32);
+
+  // Loop over sets of lanes.
+  unsigned int ctr0[PHILOXLANES], ctr1[PHILOXLANES], ctr2[PHILOXLANES],
+    ctr3[PHILOXLANES];
+  for (int iBeg = 0; iBeg < nBlock; iBeg += PHILOXLANES) {
+    int nLane = min( PHILOXLANES, nBlock - iBeg);
+
+    // Counter as 32-bit words.
+    for (int iLane = 0; iLane < nLane; ++iLane) {
+      unsigned long long cnt
+        = static_cast<unsigned long long>(counterIn + iBeg + iLane);
+      ctr0[iLane] = static_cast<unsigned int>(cnt);
+      ctr1[iLane] = static_cast<unsigned int>(cnt >> 32);
+      ctr2[iLane] = evtLow;
+      ctr3[iLane] = evtHigh;
+    }
+
+    // Ten rounds of multiplications and bumps of the key.
+    unsigned int key0 = static_cast<unsigned int>(seedSave);
+    unsigned int key1 = static_cast<unsigned int>(streamSave);
+    for (int iRound = 0; iRound < 10; ++iRound) {
+      for (int iLane = 0; iLane < nLane; ++iLane) {
+        unsigned long long prod0
+          = static_cast<unsigned long long>(PHILOXM0) * ctr0[iLane];
+        unsigned long long prod1
+          = static_cast<unsigned long long>(PHILOXM1) * ctr2[iLane];
+        unsigned int hi0 = static_cast<unsigned int>(prod0 >> 32);
+        unsigned int hi1 = static_cast<unsigned int>(prod1 >> 32);
+        ctr0[iLane] = hi1 ^ ctr1[iLane] ^ key0;
+        ctr1[iLane] = static_cast<unsigned int>(prod1);
+        ctr2[iLane] = hi0 ^ ctr3[iLane] ^ key1;
+        ctr3[iLane] = static_cast<unsigned int>(prod0);
+      }
+      key0 += PHILOXW0;
+      key1 += PHILOXW1;
+    }
+
+    // Combine 53 bits to each number, shifted to lie strictly inside (0,1).
+    double* outNow = out + 2 * iBeg;
+    for (int iLane = 0; iLane < nLane; ++iLane) {
+      outNow[2 * iLane]     = ( double(ctr0[iLane] >> 5) * TWO26
+        + double(ctr1[iLane] >> 6) + 0.5) * TWOM53;
+      outNow[2 * iLane + 1] = ( double(ctr2[iLane] >> 5) * TWO26
+        + double(ctr3[iLane] >> 6) + 0.5) * TWOM53;
+    }
+  }
 
 }
 
@@ -105,6 +239,13 @@ double Rndm::flat() {
   // Use external random number generator if such has been linked.
   if (useExternalRndm) return rndmEngPtr->flat();
 
+  // Counter-based generation, in the order the numbers were produced.
+  if (isCounterBased) {
+    ++sequence;
+    if (nBuffer == 0) fillBuffer();
+    return buffer[NBUFFER - nBuffer--];
+  }
+
   // Ensure that already initialized.
   if (!initRndm) init(DEFAULTSEED);
 
@@ -128,6 +269,68 @@ double Rndm::flat() {
 
 //--------------------------------------------------------------------------
 
+// Generate the next n random numbers in one go. The sequence is the same
+// as for n flat() calls, and the two can be mixed freely.
+
+void Rndm::flat(double* out, int n) {
+
+  // Use external random number generator if such has been linked.
+  if (n <= 0) return;
+  if (useExternalRndm) {
+    for (int i = 0; i < n; ++i) out[i] = rndmEngPtr->flat();
+    return;
+  }
+
+  // Counter-based generation: first numbers left over in the buffer,
+  // then whole buffers directly into the output, and last a partial one.
+  if (isCounterBased) {
+    sequence += n;
+    int i = 0;
+    while (nBuffer > 0 && i < n) out[i++] = buffer[NBUFFER - nBuffer--];
+    int nBlock = ((n - i) / NBUFFER) * (NBUFFER / 2);
+    if (nBlock > 0) {
+      philoxBlocks( counterSave, nBlock, out + i);
+      counterSave += nBlock;
+      i += 2 * nBlock;
+    }
+    if (i < n) fillBuffer();
+    while (i < n) out[i++] = buffer[NBUFFER - nBuffer--];
+    return;
+  }
+
+  // Ensure that already initialized.
+  if (!initRndm) init(DEFAULTSEED);
+
+  // Same algorithm as in flat(), but on local copies of the state.
+  int    iNow = i97;
+  int    jNow = j97;
+  double cNow = c;
+  for (int i = 0; i < n; ++i) {
+    double uni;
+    do {
+      uni = u[iNow] - u[jNow];
+      if (uni < 0.) uni += 1.;
+      u[iNow] = uni;
+      if (--iNow < 0) iNow = 96;
+      if (--jNow < 0) jNow = 96;
+      cNow -= cd;
+      if (cNow < 0.) cNow += cm;
+      uni -= cNow;
+      if (uni < 0.) uni += 1.;
+    } while (uni <= 0. || uni >= 1.);
+    out[i] = uni;
+  }
+
+  // Save state.
+  i97       = iNow;
+  j97       = jNow;
+  c         = cNow;
+  sequence += n;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick one option among  vector of (positive) probabilities.
 
 int Rndm::pick(const vector<double>& prob) {
@@ -167,6 +370,15 @@ bool Rndm::dumpState(string fileName) {
   ofs.write((char *) &cm,       sizeof(double));
   ofs.write((char *) &u,        sizeof(double) * 97);
 
+  // Append the state of the counter-based generator.
+  ofs.write((char *) &isCounterBased, sizeof(bool));
+  ofs.write((char *) &eventIsSet,     sizeof(bool));
+  ofs.write((char *) &streamSave,     sizeof(int));
+  ofs.write((char *) &nBuffer,        sizeof(int));
+  ofs.write((char *) &eventSave,      sizeof(long));
+  ofs.write((char *) &counterSave,    sizeof(long));
+  ofs.write((char *) &buffer,         sizeof(double) * NBUFFER);
+
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::dumpState: seed = " << seedSave
        << ", sequence no = " << sequence << endl;
@@ -198,6 +410,19 @@ bool Rndm::readState(string fileName) {
   ifs.read((char *) &cd,       sizeof(double));
   ifs.read((char *) &cm,       sizeof(double));
   ifs.read((char *) &u,        sizeof(double) *97);
+  initRndm = true;
+
+  // State of the counter-based generator; absent in older files.
+  bool counterIn = false;
+  if (ifs.read((char *) &counterIn, sizeof(bool)) && counterIn) {
+    ifs.read((char *) &eventIsSet,  sizeof(bool));
+    ifs.read((char *) &streamSave,  sizeof(int));
+    ifs.read((char *) &nBuffer,     sizeof(int));
+    ifs.read((char *) &eventSave,   sizeof(long));
+    ifs.read((char *) &counterSave, sizeof(long));
+    ifs.read((char *) &buffer,      sizeof(double) * NBUFFER);
+  }
+  isCounterBased = counterIn && ifs.good();
 
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::readState: seed " << seedSave
@@ -1241,6 +1466,52 @@ bool Hist::sameSize(const Hist& h) const {
 
 //--------------------------------------------------------------------------
 
+// Write the complete histogram in binary form.
+
+void Hist::writeBinary(ostream& os) const {
+
+  Pythia8::writeBinary( os, titleSave);
+  Pythia8::writeBinary( os, nBin);
+  Pythia8::writeBinary( os, nFill);
+  Pythia8::writeBinary( os, xMin);
+  Pythia8::writeBinary( os, xMax);
+  Pythia8::writeBinary( os, linX);
+  Pythia8::writeBinary( os, dx);
+  Pythia8::writeBinary( os, under);
+  Pythia8::writeBinary( os, inside);
+  Pythia8::writeBinary( os, over);
+  for (int ix = 0; ix < nBin; ++ix) Pythia8::writeBinary( os, res[ix]);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read a histogram written by writeBinary. Unchanged if reading fails.
+
+bool Hist::readBinary(istream& is) {
+
+  Hist hNew;
+  if (!Pythia8::readBinary( is, hNew.titleSave)
+    || !Pythia8::readBinary( is, hNew.nBin) || hNew.nBin < 0
+    || hNew.nBin > NBINMAX || !Pythia8::readBinary( is, hNew.nFill)
+    || !Pythia8::readBinary( is, hNew.xMin)
+    || !Pythia8::readBinary( is, hNew.xMax)
+    || !Pythia8::readBinary( is, hNew.linX)
+    || !Pythia8::readBinary( is, hNew.dx)
+    || !Pythia8::readBinary( is, hNew.under)
+    || !Pythia8::readBinary( is, hNew.inside)
+    || !Pythia8::readBinary( is, hNew.over) ) return false;
+  hNew.res.resize( hNew.nBin);
+  for (int ix = 0; ix < hNew.nBin; ++ix)
+    if (!Pythia8::readBinary( is, hNew.res[ix])) return false;
+  titleSave = hNew.titleSave;
+  *this     = hNew;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Take 10-logarithm or natural logarithm of contents bin by bin.
 
 void Hist::takeLog(bool tenLog) {
@@ -893,4 +893,67 @@ Event& Event::operator+=( const Event& addEvent) {
 
 //==========================================================================
 
+// The EventColumns class.
+
+//--------------------------------------------------------------------------
+
+// Fill with the properties of all particles in an event. Each particle
+// is read in place, once, and its properties spread over the arrays.
+
+void EventColumns::fill(const Event& event) {
+
+  // Adjust size of arrays.
+  int nPart = event.size();
+  resize( nPart);
+
+  // Loop over particles and copy their properties.
+  for (int i = 0; i < nPart; ++i) {
+    const Particle& pNow = event[i];
+    idSave[i]        = pNow.id();
+    statusSave[i]    = pNow.status();
+    mother1Save[i]   = pNow.mother1();
+    mother2Save[i]   = pNow.mother2();
+    daughter1Save[i] = pNow.daughter1();
+    daughter2Save[i] = pNow.daughter2();
+    pxSave[i]        = pNow.px();
+    pySave[i]        = pNow.py();
+    pzSave[i]        = pNow.pz();
+    eSave[i]         = pNow.e();
+    mSave[i]         = pNow.m();
+    xProdSave[i]     = pNow.xProd();
+    yProdSave[i]     = pNow.yProd();
+    zProdSave[i]     = pNow.zProd();
+    tProdSave[i]     = pNow.tProd();
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set the size of all arrays. Vectors keep their capacity when they
+// shrink, so memory is only allocated for the largest event so far.
+
+void EventColumns::resize(int sizeIn) {
+
+  sizeSave = sizeIn;
+  idSave.resize( sizeIn);
+  statusSave.resize( sizeIn);
+  mother1Save.resize( sizeIn);
+  mother2Save.resize( sizeIn);
+  daughter1Save.resize( sizeIn);
+  daughter2Save.resize( sizeIn);
+  pxSave.resize( sizeIn);
+  pySave.resize( sizeIn);
+  pzSave.resize( sizeIn);
+  eSave.resize( sizeIn);
+  mSave.resize( sizeIn);
+  xProdSave.resize( sizeIn);
+  yProdSave.resize( sizeIn);
+  zProdSave.resize( sizeIn);
+  tProdSave.resize( sizeIn);
+
+}
+
+//==========================================================================
+
 } // end namespace Pythia8
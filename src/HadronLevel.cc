@@ -211,22 +211,25 @@ bool HadronLevel::next( Event& event) {
       }
 
       // Process all colour singlet (sub)systems.
-      for (int iSub = 0; iSub < colConfig.size(); ++iSub) {
+      infoPtr->startTiming(Info::TIMESTRING);
+      bool fragOK = true;
+      for (int iSub = 0; iSub < colConfig.size() && fragOK; ++iSub) {
 
         // Collect sequentially all partons in a colour singlet subsystem.
         colConfig.collect(iSub, event);
 
         // String fragmentation of each colour singlet (sub)system.
-        if ( colConfig[iSub].massExcess > mStringMin ) {
-          if (!stringFrag.fragment( iSub, colConfig, event)) return false;
+        if ( colConfig[iSub].massExcess > mStringMin )
+          fragOK = stringFrag.fragment( iSub, colConfig, event);
 
         // Low-mass string treated separately. Tell if diffractive system.
-        } else {
+        else {
           bool isDiff = infoPtr->isDiffractiveA() || infoPtr->isDiffractiveB();
-          if (!ministringFrag.fragment( iSub, colConfig, event, isDiff))
-            return false;
+          fragOK = ministringFrag.fragment( iSub, colConfig, event, isDiff);
         }
       }
+      infoPtr->stopTiming(Info::TIMESTRING);
+      if (!fragOK) return false;
     }
 
     // Hadron scattering.
@@ -242,6 +245,7 @@ bool HadronLevel::next( Event& event) {
     if (doDecay) {
 
       // Loop through all entries to find those that should decay.
+      infoPtr->startTiming(Info::TIMEDECAYS);
       int iDec = 0;
       do {
         Particle& decayer = event[iDec];
@@ -251,6 +255,7 @@ bool HadronLevel::next( Event& event) {
           if (decays.moreToDo()) moreToDo = true;
         }
       } while (++iDec < event.size());
+      infoPtr->stopTiming(Info::TIMEDECAYS);
     }
 
     // Hadron scattering, old model, after decays.
@@ -259,7 +264,10 @@ bool HadronLevel::next( Event& event) {
 
     // Third part: include Bose-Einstein effects among current particles.
     if (doBoseEinsteinNow) {
-      if (!boseEinstein.shiftEvent(event)) return false;
+      infoPtr->startTiming(Info::TIMEBE);
+      bool shiftOK = boseEinstein.shiftEvent(event);
+      infoPtr->stopTiming(Info::TIMEBE);
+      if (!shiftOK) return false;
       doBoseEinsteinNow = false;
     }
 
@@ -267,6 +275,7 @@ bool HadronLevel::next( Event& event) {
     if (doDecay) {
 
       // Loop through all entries to find those that should decay.
+      infoPtr->startTiming(Info::TIMEDECAYS);
       int iDec = 0;
       do {
         Particle& decayer = event[iDec];
@@ -275,6 +284,7 @@ bool HadronLevel::next( Event& event) {
           if (decays.moreToDo()) moreToDo = true;
         }
       } while (++iDec < event.size());
+      infoPtr->stopTiming(Info::TIMEDECAYS);
     }
 
   // Normally done first time around, but sometimes not (e.g. Upsilon).
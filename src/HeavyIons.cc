@@ -113,8 +113,9 @@ void HeavyIons::setupSpecials(Pythia & p, string match) {
 // Sum up info from all used Pythia objects.
 
 void HeavyIons::sumUpMessages(Info & in, string tag, const Info & other) {
-  for ( map<string,int>::const_iterator it = other.messages.begin();
-        it != other.messages.end(); ++it )
+  map<string,int> messages = other.errorMessages();
+  for ( map<string,int>::const_iterator it = messages.begin();
+        it != messages.end(); ++it )
     in.messages[tag + it->first] += it->second;
 }
 
@@ -150,10 +151,14 @@ void HeavyIons::clearProcessLevel(Pythia & pyt) {
 // Update the Info object in the main Pythia object.
 
 void HeavyIons::updateInfo() {
-  map<string, int> saveMess = mainPythiaPtr->info.messages;
+  map<string, int> saveMess;
+  saveMess.swap( mainPythiaPtr->info.messages);
+  ErrorCounts saveCounts;
+  saveCounts.swap( mainPythiaPtr->info.errorCounts);
   mainPythiaPtr->info = hiinfo.primInfo;
   mainPythiaPtr->info.hiinfo = &hiinfo;
-  mainPythiaPtr->info.messages = saveMess;
+  mainPythiaPtr->info.messages.swap( saveMess);
+  mainPythiaPtr->info.errorCounts.swap( saveCounts);
   mainPythiaPtr->info.updateWeight(hiinfo.weight());
   mainPythiaPtr->info.sigmaReset();
   double norm = 1.0/double(hiinfo.NSave);
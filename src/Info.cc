@@ -8,10 +8,102 @@
 #include "Pythia8/Info.h"
 #include <limits>
 
+// Access wall-clock time for the timing of event generation stages.
+#include <chrono>
+
+// Thread-safe registration and counting of error messages.
+#include <atomic>
+#include <mutex>
+
 namespace Pythia8 {
 
 //==========================================================================
 
+// The registry of error messages, common to all Info objects, with a
+// cache from the address of a string literal to its code. The sizes
+// could be changed here if desired; the cache size must be a power of 2.
+
+static const int                NERRORCODES = 512;
+static const int                NERRORCACHE = 1024;
+static std::mutex               errorCodeMutex;
+static std::atomic<int>         nErrorCodes(0);
+static std::atomic<const char*> errorCacheKey[NERRORCACHE];
+static int                      errorCacheCode[NERRORCACHE];
+
+// The text of the registered messages.
+
+static string& errorCodeMessage(int codeIn) {
+  static string errorCodeMessages[NERRORCODES];
+  return errorCodeMessages[codeIn];
+}
+
+//==========================================================================
+
+// ErrorCounts class.
+// Thread-safe counters of the registered error messages of an Info object.
+
+//--------------------------------------------------------------------------
+
+// The counters, one for each possible code.
+
+class ErrorCounts::Counters {
+
+public:
+
+  Counters() {for (int i = 0; i < NERRORCODES; ++i) n[i].store(0);}
+  std::atomic<long> n[NERRORCODES];
+
+};
+
+//--------------------------------------------------------------------------
+
+// Constructors and destructor. The counters of codes not yet registered
+// are always zero, so they need not be copied.
+
+ErrorCounts::ErrorCounts() : countersPtr(new Counters) {}
+
+ErrorCounts::ErrorCounts(const ErrorCounts& other)
+  : countersPtr(new Counters) {*this = other;}
+
+ErrorCounts& ErrorCounts::operator=(const ErrorCounts& other) {
+  if (this != &other) for (int i = 0; i < nErrorCodes.load(); ++i)
+    countersPtr->n[i].store( other.countersPtr->n[i].load());
+  return *this;
+}
+
+ErrorCounts::~ErrorCounts() {delete countersPtr;}
+
+//--------------------------------------------------------------------------
+
+// Increase the counter of a code, and return the value before.
+
+long ErrorCounts::increase(int codeIn, long nIn) {
+  return countersPtr->n[codeIn].fetch_add(nIn);
+}
+
+//--------------------------------------------------------------------------
+
+// Current value of the counter of a code, and reset of all of them.
+
+long ErrorCounts::value(int codeIn) const {
+  return countersPtr->n[codeIn].load();
+}
+
+void ErrorCounts::reset() {
+  for (int i = 0; i < nErrorCodes.load(); ++i) countersPtr->n[i].store(0);
+}
+
+//--------------------------------------------------------------------------
+
+// Add the counts of another object.
+
+void ErrorCounts::add(const ErrorCounts& other) {
+  for (int i = 0; i < nErrorCodes.load(); ++i)
+    countersPtr->n[i].fetch_add( other.countersPtr->n[i].load());
+}
+
+//==========================================================================
+
 // Info class.
 // This class contains a mixed bag of information on the event generation
 // activity, especially on the current subprocess properties.
@@ -264,7 +356,9 @@ vector<int> Info::codesHard() {
 
 //--------------------------------------------------------------------------
 
-// Print a message the first few times. Insert in database.
+// Print a message the first few times. Insert in database. The message
+// is counted by text in this object; it is not registered, so that
+// messages composed at run time do not fill up the registry.
 
   void Info::errorMsg(string messageIn, string extraIn, bool showAlways) {
 
@@ -278,6 +372,100 @@ vector<int> Info::codesHard() {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Print a message given as a string literal the first few times. The code
+// is found from the address of the literal; the text is compared as well,
+// in case the same address is reused for another message.
+
+void Info::errorMsg(const char* messageIn, const string& extraIn,
+  bool showAlways) {
+
+  // Look for the address in the cache.
+  size_t address = reinterpret_cast<size_t>(messageIn);
+  int iSlot = (address ^ (address >> 12)) & (NERRORCACHE - 1);
+  for (int iTry = 0; iTry < NERRORCACHE; ++iTry) {
+    const char* keyNow = errorCacheKey[iSlot].load(std::memory_order_acquire);
+    if (keyNow == 0) break;
+    if (keyNow == messageIn) {
+      int codeNow = errorCacheCode[iSlot];
+      if (errorCodeMessage(codeNow) == messageIn) {
+        errorMsg( codeNow, extraIn, showAlways);
+        return;
+      }
+      break;
+    }
+    iSlot = (iSlot + 1) & (NERRORCACHE - 1);
+  }
+
+  // Else register the message, and store its address in the cache.
+  string message = messageIn;
+  int codeNow = errorCode( message);
+  if (codeNow < 0) {
+    errorMsg( message, extraIn, showAlways);
+    return;
+  }
+  errorCodeMutex.lock();
+  iSlot = (address ^ (address >> 12)) & (NERRORCACHE - 1);
+  for (int iTry = 0; iTry < NERRORCACHE; ++iTry) {
+    const char* keyNow = errorCacheKey[iSlot].load(std::memory_order_relaxed);
+    if (keyNow == messageIn) break;
+    if (keyNow == 0) {
+      errorCacheCode[iSlot] = codeNow;
+      errorCacheKey[iSlot].store( messageIn, std::memory_order_release);
+      break;
+    }
+    iSlot = (iSlot + 1) & (NERRORCACHE - 1);
+  }
+  errorCodeMutex.unlock();
+  errorMsg( codeNow, extraIn, showAlways);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Print a registered message the first few times, and count it.
+
+void Info::errorMsg(int codeIn, const string& extraIn, bool showAlways) {
+
+  // Unknown codes are counted as a message of their own.
+  if (codeIn < 0 || codeIn >= nErrorCodes.load()) {
+    errorMsg( string("Error in Info::errorMsg: unknown error code"));
+    return;
+  }
+
+  // Count, and print message the first few times.
+  long times = errorCounts.increase(codeIn);
+  if (times < TIMESTOPRINT || showAlways) cout << " PYTHIA "
+    << errorCodeMessage(codeIn) << " " << extraIn << endl;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Register a message and return its code. A message that is already known
+// keeps its code. The text is stored before the code is made public, so
+// that it can be read later without locking.
+
+int Info::errorCode(const string& messageIn) {
+
+  // The codes of the messages registered so far.
+  static map<string, int> codes;
+  std::lock_guard<std::mutex> lock(errorCodeMutex);
+  map<string, int>::const_iterator found = codes.find(messageIn);
+  if (found != codes.end()) return found->second;
+
+  // Add a new message, if there is room.
+  int codeNow = nErrorCodes.load();
+  if (codeNow >= NERRORCODES) return -1;
+  errorCodeMessage(codeNow) = messageIn;
+  codes[messageIn] = codeNow;
+  nErrorCodes.store(codeNow + 1);
+  return codeNow;
+
+}
+
+
 //--------------------------------------------------------------------------
 
 // Provide total number of errors/aborts/warnings experienced to date.
@@ -288,12 +476,28 @@ int Info::errorTotalNumber() {
   for ( map<string, int>::iterator messageEntry = messages.begin();
     messageEntry != messages.end(); ++messageEntry)
     nTot += messageEntry->second;
+  for (int i = 0; i < nErrorCodes.load(); ++i) nTot += errorCounts.value(i);
   return nTot;
 
 }
 
 //--------------------------------------------------------------------------
 
+// Provide all errors/aborts/warnings with the number of times each,
+// both the registered ones and the ones in the map.
+
+map<string, int> Info::errorMessages() const {
+
+  map<string, int> messagesAll = messages;
+  for (int i = 0; i < nErrorCodes.load(); ++i)
+    if (errorCounts.value(i) > 0)
+      messagesAll[errorCodeMessage(i)] += errorCounts.value(i);
+  return messagesAll;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Print statistics on errors/aborts/warnings.
 
 void Info::errorStatistics() {
@@ -309,11 +513,12 @@ void Info::errorStatistics() {
        << "                                                          | \n";
 
   // Loop over all messages
-  map<string, int>::iterator messageEntry = messages.begin();
-  if (messageEntry == messages.end())
+  map<string, int> messagesAll = errorMessages();
+  map<string, int>::iterator messageEntry = messagesAll.begin();
+  if (messageEntry == messagesAll.end())
     cout << " |      0   no errors or warnings to report              "
          << "                                                          | \n";
-  while (messageEntry != messages.end()) {
+  while (messageEntry != messagesAll.end()) {
     // Message printout.
     string temp = messageEntry->first;
     int len = temp.length();
@@ -334,6 +539,81 @@ void Info::errorStatistics() {
 
 //--------------------------------------------------------------------------
 
+// Name of a timed stage of event generation. Indented ones are parts
+// of the preceding non-indented one.
+
+string Info::nameStage( int i) const {
+
+  switch (i) {
+  case TIMENEXT:     return "Pythia::next";
+  case TIMEPROCESS:  return "  ProcessLevel::next";
+  case TIMEPARTON:   return "  PartonLevel::next";
+  case TIMEMPI:      return "    multiparton interactions";
+  case TIMEISR:      return "    initial-state showers";
+  case TIMEFSR:      return "    final-state showers";
+  case TIMEREMNANTS: return "    BeamRemnants::add";
+  case TIMECR:       return "    ColourReconnection::next";
+  case TIMEHADRON:   return "  HadronLevel::next";
+  case TIMESTRING:   return "    string fragmentation";
+  case TIMEDECAYS:   return "    ParticleDecays::decay";
+  case TIMEBE:       return "    BoseEinstein::shiftEvent";
+  default:           return "";
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Current wall-clock time in seconds, from an arbitrary starting point.
+
+double Info::wallTime() {
+
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Print statistics on the time spent in the stages of event generation.
+
+void Info::timingStatistics() {
+
+  // Header.
+  cout << "\n *-------  PYTHIA Timing Statistics  ------------------------"
+       << "------------------------------------------------------* \n"
+       << " |                                                       "
+       << "                                                          | \n"
+       << " | Stage                                          calls     "
+       << "total (s)   per event (ms)   per call (us)    fraction | \n"
+       << " |                                                       "
+       << "                                                          | \n";
+
+  // One line per stage. Times per event refer to the Pythia::next calls.
+  long   nEvents   = nCallsStageSave[TIMENEXT];
+  double timeTotal = timeStageSave[TIMENEXT];
+  for (int i = TIMENEXT; i < NSTAGES; ++i) {
+    long   nCalls = nCallsStageSave[i];
+    double time   = timeStageSave[i];
+    cout << " | " << left << setw(38) << nameStage(i) << right
+         << setw(14) << nCalls << fixed << setprecision(3) << setw(14)
+         << time << setw(17) << ((nEvents > 0) ? 1e3 * time / nEvents : 0.)
+         << setw(16) << ((nCalls > 0) ? 1e6 * time / nCalls : 0.)
+         << setprecision(1) << setw(10)
+         << ((timeTotal > 0.) ? 100. * time / timeTotal : 0.) << " % | \n";
+  }
+
+  // Done.
+  cout << " |                                                       "
+       << "                                                          | \n"
+       << " *-------  End PYTHIA Timing Statistics  --------------------"
+       << "------------------------------------------------------* "
+       << endl;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Return a list of all header key names
 
 vector < string > Info::headerKeys() {
@@ -0,0 +1,324 @@
+// InitCache.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Function definitions (not found in the header) for the InitCache class.
+
+#include "Pythia8/InitCache.h"
+
+// Access file renaming and removal.
+#include <cstdio>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The InitCache class.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Version of the file layout; to be increased when the layout changes.
+const int    InitCache::FORMATVERSION  = 1;
+
+// Identifying header at the beginning of a cache file.
+const string InitCache::FILEHEADER     = "PYTHIA8INITCACHE";
+
+// Settings that do not influence the initialization results; the list
+// must end with an empty string. Note that the names are lower case.
+// Random:seed does change the sampled results, but is left out on
+// purpose, so that runs with different seeds can share one file.
+const string InitCache::IGNOREPREFIX[] = { "init:", "next:", "stat:",
+  "main:", "check:", "random:", "parallelism:", "print:", ""};
+
+//--------------------------------------------------------------------------
+
+// Begin a new initialization. Read in the file if the key agrees.
+
+bool InitCache::open( string fileNameIn, Settings& settings,
+  ParticleData& particleData, Info* infoPtrIn) {
+
+  // Save input. Reset records and statistics.
+  fileName  = fileNameIn;
+  infoPtr   = infoPtrIn;
+  isOpen    = true;
+  hasNew    = false;
+  nHitSave  = 0;
+  nMissSave = 0;
+  records.clear();
+  nRequest.clear();
+
+  // Find key and read in existing results, if the key agrees.
+  keySave   = hashKey( settings, particleData);
+  return readFile();
+
+}
+
+//--------------------------------------------------------------------------
+
+// End of initialization. Write out the file if new results were added.
+
+bool InitCache::close( bool doWrite) {
+
+  // Only write when something new was found.
+  if (!isOpen) return false;
+  isOpen = false;
+  bool isOK = true;
+  if (doWrite && hasNew) isOK = writeFile();
+
+  // Records no longer needed.
+  records.clear();
+  nRequest.clear();
+  return isOK;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Unique tag of a record, adding the number of earlier requests. The
+// initialization order is fixed for given settings, so the n'th request
+// of the same kind in two runs refers to the same object.
+
+string InitCache::tag( string tagIn) {
+
+  ostringstream os;
+  os << tagIn << "#" << nRequest[tagIn]++;
+  return os.str();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Retrieve the values stored for a tag, if any.
+
+bool InitCache::get( string tagIn, vector<double>& values) {
+
+  if (!isOpen) return false;
+  map<string, vector<double> >::const_iterator rec = records.find(tagIn);
+  if (rec == records.end()) {
+    ++nMissSave;
+    return false;
+  }
+  values = rec->second;
+  ++nHitSave;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store the values for a tag.
+
+void InitCache::put( string tagIn, const vector<double>& values) {
+
+  if (!isOpen) return;
+  records[tagIn] = values;
+  hasNew = true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// The hash of the current settings and particle data. All values are
+// written out with full precision and then hashed with the 64-bit FNV-1a
+// algorithm. Settings that only steer printout and the like are skipped.
+
+unsigned long long InitCache::hashKey( Settings& settings,
+  ParticleData& particleData) {
+
+  // Write out all relevant settings.
+  ostringstream os;
+  os << scientific << setprecision(17);
+  map<string, Flag> flags = settings.getFlagMap("");
+  map<string, Mode> modes = settings.getModeMap("");
+  map<string, Parm> parms = settings.getParmMap("");
+  map<string, Word> words = settings.getWordMap("");
+  map<string, FVec> fvecs = settings.getFVecMap("");
+  map<string, MVec> mvecs = settings.getMVecMap("");
+  map<string, PVec> pvecs = settings.getPVecMap("");
+  map<string, WVec> wvecs = settings.getWVecMap("");
+  vector<string> names;
+  for (map<string, Flag>::iterator it = flags.begin(); it != flags.end();
+    ++it) names.push_back(it->first);
+  for (map<string, Mode>::iterator it = modes.begin(); it != modes.end();
+    ++it) names.push_back(it->first);
+  for (map<string, Parm>::iterator it = parms.begin(); it != parms.end();
+    ++it) names.push_back(it->first);
+  for (map<string, Word>::iterator it = words.begin(); it != words.end();
+    ++it) names.push_back(it->first);
+  for (map<string, FVec>::iterator it = fvecs.begin(); it != fvecs.end();
+    ++it) names.push_back(it->first);
+  for (map<string, MVec>::iterator it = mvecs.begin(); it != mvecs.end();
+    ++it) names.push_back(it->first);
+  for (map<string, PVec>::iterator it = pvecs.begin(); it != pvecs.end();
+    ++it) names.push_back(it->first);
+  for (map<string, WVec>::iterator it = wvecs.begin(); it != wvecs.end();
+    ++it) names.push_back(it->first);
+  for (int i = 0; i < int(names.size()); ++i) {
+    bool skip = false;
+    for (int j = 0; IGNOREPREFIX[j] != ""; ++j)
+      if (names[i].find(IGNOREPREFIX[j]) == 0) skip = true;
+    if (skip) continue;
+    string name = names[i];
+    os << name << "=";
+    if      (flags.find(name) != flags.end()) os << flags[name].valNow;
+    else if (modes.find(name) != modes.end()) os << modes[name].valNow;
+    else if (parms.find(name) != parms.end()) os << parms[name].valNow;
+    else if (words.find(name) != words.end()) os << words[name].valNow;
+    else if (fvecs.find(name) != fvecs.end()) {
+      for (int k = 0; k < int(fvecs[name].valNow.size()); ++k)
+        os << fvecs[name].valNow[k] << ",";
+    } else if (mvecs.find(name) != mvecs.end()) {
+      for (int k = 0; k < int(mvecs[name].valNow.size()); ++k)
+        os << mvecs[name].valNow[k] << ",";
+    } else if (pvecs.find(name) != pvecs.end()) {
+      for (int k = 0; k < int(pvecs[name].valNow.size()); ++k)
+        os << pvecs[name].valNow[k] << ",";
+    } else if (wvecs.find(name) != wvecs.end()) {
+      for (int k = 0; k < int(wvecs[name].valNow.size()); ++k)
+        os << wvecs[name].valNow[k] << ",";
+    }
+    os << "\n";
+  }
+
+  // Write out the particle properties and decay tables.
+  for (int id = particleData.nextId(0); id != 0;
+    id = particleData.nextId(id)) {
+    ParticleDataEntry* entry = particleData.particleDataEntryPtr(id);
+    os << id << ":" << entry->m0() << "," << entry->mWidth() << ","
+       << entry->mMin() << "," << entry->mMax() << "," << entry->tau0()
+       << "," << entry->isResonance() << "," << entry->mayDecay() << "\n";
+    for (int i = 0; i < entry->sizeChannels(); ++i) {
+      const DecayChannel& channel = entry->channel(i);
+      os << " " << channel.onMode() << "," << channel.bRatio() << ","
+         << channel.meMode();
+      for (int j = 0; j < channel.multiplicity(); ++j)
+        os << "," << channel.product(j);
+      os << "\n";
+    }
+  }
+
+  // Hash the string.
+  string all = os.str();
+  unsigned long long hash = 14695981039346656037ULL;
+  for (int i = 0; i < int(all.size()); ++i) {
+    hash ^= static_cast<unsigned char>(all[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read the cache file. Records are only kept if header and key agree.
+
+bool InitCache::readFile() {
+
+  // Missing file is not an error; it will be created at the end of init.
+  ifstream is( fileName.c_str(), ios::binary);
+  if (!is.good()) return false;
+
+  // Check header, format version and key.
+  string header( FILEHEADER.size(), ' ');
+  int formatVersion = 0;
+  unsigned long long keyFile = 0;
+  is.read( &header[0], header.size());
+  is.read( reinterpret_cast<char*>(&formatVersion), sizeof(int));
+  is.read( reinterpret_cast<char*>(&keyFile), sizeof(keyFile));
+  if (!is.good() || header != FILEHEADER
+    || formatVersion != FORMATVERSION) {
+    infoPtr->errorMsg("Warning in InitCache::readFile: "
+      "file is not a valid cache file; will be overwritten", fileName);
+    return false;
+  }
+  if (keyFile != keySave) {
+    infoPtr->errorMsg("Warning in InitCache::readFile: "
+      "settings have changed; cache will be recalculated", fileName);
+    return false;
+  }
+
+  // Read the records.
+  int nRecords = 0;
+  is.read( reinterpret_cast<char*>(&nRecords), sizeof(int));
+  for (int iRec = 0; iRec < nRecords && is.good(); ++iRec) {
+    int nChar = 0;
+    int nVal  = 0;
+    is.read( reinterpret_cast<char*>(&nChar), sizeof(int));
+    if (!is.good() || nChar <= 0) break;
+    string tagNow( nChar, ' ');
+    is.read( &tagNow[0], nChar);
+    is.read( reinterpret_cast<char*>(&nVal), sizeof(int));
+    if (!is.good() || nVal < 0) break;
+    vector<double> values( nVal);
+    if (nVal > 0)
+      is.read( reinterpret_cast<char*>(&values[0]), nVal * sizeof(double));
+    if (is.good()) records[tagNow] = values;
+  }
+
+  // Reject the whole file if it could not be read completely.
+  if (int(records.size()) != nRecords) {
+    infoPtr->errorMsg("Warning in InitCache::readFile: "
+      "file is corrupt; cache will be recalculated", fileName);
+    records.clear();
+    return false;
+  }
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the cache file. A temporary file is renamed at the end, so that
+// several programs running at the same time never see a partial file.
+
+bool InitCache::writeFile() {
+
+  // Open a uniquely named temporary file.
+  ostringstream osTmp;
+  osTmp << fileName << ".tmp" << this;
+  string fileTmp = osTmp.str();
+  ofstream os( fileTmp.c_str(), ios::binary);
+  if (!os.good()) {
+    infoPtr->errorMsg("Error in InitCache::writeFile: "
+      "could not open file", fileName);
+    return false;
+  }
+
+  // Write header and key, then all records.
+  int nRecords = records.size();
+  os.write( FILEHEADER.c_str(), FILEHEADER.size());
+  os.write( reinterpret_cast<const char*>(&FORMATVERSION), sizeof(int));
+  os.write( reinterpret_cast<const char*>(&keySave), sizeof(keySave));
+  os.write( reinterpret_cast<const char*>(&nRecords), sizeof(int));
+  for (map<string, vector<double> >::const_iterator rec = records.begin();
+    rec != records.end(); ++rec) {
+    int nChar = rec->first.size();
+    int nVal  = rec->second.size();
+    os.write( reinterpret_cast<const char*>(&nChar), sizeof(int));
+    os.write( rec->first.c_str(), nChar);
+    os.write( reinterpret_cast<const char*>(&nVal), sizeof(int));
+    if (nVal > 0) os.write( reinterpret_cast<const char*>(&rec->second[0]),
+      nVal * sizeof(double));
+  }
+  os.close();
+
+  // Move file in place.
+  if (!os.good() || rename( fileTmp.c_str(), fileName.c_str()) != 0) {
+    infoPtr->errorMsg("Error in InitCache::writeFile: "
+      "could not write file", fileName);
+    remove( fileTmp.c_str());
+    return false;
+  }
+  return true;
+
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
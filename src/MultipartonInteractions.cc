@@ -8,6 +8,14 @@
 
 #include "Pythia8/MultipartonInteractions.h"
 
+// Reuse of earlier initialization results.
+#include "Pythia8/InitCache.h"
+
+// Process creation and temporary files, for parallel initialization.
+#include <unistd.h>
+#include <sys/wait.h>
+#include <cstdio>
+
 // Internal headers for special processes.
 #include "Pythia8/SigmaQCD.h"
 #include "Pythia8/SigmaEW.h"
@@ -336,6 +344,12 @@ const double MultipartonInteractions::WTACCWARN     = 1.1;
 // Limit below which scientific notation is used for printing.
 const double MultipartonInteractions::SIGMAMBLIMIT  = 1.;
 
+// Number of values, apart from the Sudakov table, in an init cache record.
+const int    MultipartonInteractions::NINITSTATE    = 25;
+
+// Largest seed of the random number stream of a forked mass step.
+const int    MultipartonInteractions::NSEEDMAX      = 900000000;
+
 //--------------------------------------------------------------------------
 
 // Initialize the generation process for given beams.
@@ -376,6 +390,9 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
   // Parameters of alphaEM generation.
   alphaEMorder   = settings.mode("MultipartonInteractions:alphaEMorder");
 
+  // Number of processes for parallel initialization of mass steps.
+  nInitProcesses = settings.mode("MultipartonInteractions:nInitProcesses");
+
   //  Parameters of cross section generation.
   Kfactor        = settings.parm("MultipartonInteractions:Kfactor");
 
@@ -489,11 +506,15 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
 
   // Initialize alpha_strong generation.
   alphaS.init( alphaSvalue, alphaSorder, alphaSnfmax, false);
-  double Lambda3 = alphaS.Lambda3();
 
   // Initialize alphaEM generation.
   alphaEM.init( alphaEMorder, &settings);
 
+  // Optionally tabulate the running couplings.
+  bool tabulateAlpha = settings.flag("StandardModel:tabulateAlpha");
+  alphaS.setTabulate( tabulateAlpha);
+  alphaEM.setTabulate( tabulateAlpha);
+
   // Attach matrix-element calculation objects.
   sigma2gg.init( 0, processLevel, infoPtr, &settings, particleDataPtr,
     rndmPtr, beamAPtr, beamBPtr, couplingsPtr);
@@ -571,132 +592,42 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
     eStepSize = log(mGmGmMax / mGmGmMin) / (nStep - 1.);
   }
 
+  // Optionally find pT0 and the interaction rate of the mass steps in
+  // parallel, in processes forked from this one.
+  InitCache* initCachePtr = infoPtr->initCachePtr();
+  vector<string> cacheTags(nStep);
+  if (initCachePtr != 0) for (int iStep = 0; iStep < nStep; ++iStep)
+    cacheTags[iStep] = initCachePtr->tag("MultipartonInteractions");
+  vector< vector<double> > valuesForked(nStep);
+  double pTminForked = pTmin;
+  if (nStep > 1 && nInitProcesses > 1)
+    initStepsForked( nInitProcesses, cacheTags, valuesForked);
+
   for (int iStep = 0; iStep < nStep; ++iStep) {
 
     // Update and output current diffractive mass and
     // fictitious Pomeron-proton cross section for normalization.
-    if (nStep > 1) {
-      if (!hasGamma) eCM = mMinPertDiff * pow( mMaxPertDiff / mMinPertDiff,
-                           iStep / (nStep - 1.) );
-      else eCM = mGmGmMin * pow( mGmGmMax / mGmGmMin, iStep / (nStep - 1.) );
-      sCM = eCM * eCM;
-
-
-      // MPI for diffractive events. Rescale Pom/p flux to use for Pom/gamma.
-      if (hasPomeronBeams) {
-        double gamPomRatio = 1.;
-        if (hasGamma) {
-          sigmaTotPtr->calc(22, 2212, eCM);
-          double sigGamP = sigmaTotPtr->sigmaTot();
-          sigmaTotPtr->calc(2212, 2212, eCM);
-          double sigPP   = sigmaTotPtr->sigmaTot();
-          gamPomRatio = sigGamP / sigPP;
-        }
-        sigmaND = gamPomRatio * sigmaPomP * pow( eCM / mPomP, pPomP);
-        if (showMPI) cout << " |   diffractive mass = " << scientific
-          << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
-          << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
-          << setw(8) << sigmaND << " mb    | \n";
-
-        // Keep track of pomeron momentum fraction.
-        if ( beamAPtr->id() == 990 && beamBPtr->id() == 990 ) {
-          beamAPtr->xPom(eCM/eCMsave);
-          beamBPtr->xPom(eCM/eCMsave);
-        }
-        else if ( beamAPtr->id() == 990 )
-          beamAPtr->xPom(pow2(eCM/eCMsave));
-        else if ( beamBPtr->id() == 990 )
-          beamBPtr->xPom(pow2(eCM/eCMsave));
-      // MPI with photons from leptons.
-      } else {
-
-        // Hadron-photon case.
-        if ( isHadronGamma ) {
-          sigmaTotPtr->calc( beamAPtr->id(), 22, eCM );
-          sigmaND = sigmaTotPtr->sigmaND();
-          if (showMPI) cout << " |   hadron+gamma eCM = " << scientific
-            << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
-            << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
-            << setw(8) << sigmaND << " mb    | \n";
-
-        // Photon-hadron case.
-        } else if ( isGammaHadron )  {
-          sigmaTotPtr->calc( 22, beamBPtr->id(), eCM );
-          sigmaND = sigmaTotPtr->sigmaND();
-          if (showMPI) cout << " |   gamma+hadron eCM = " << scientific
-            << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
-            << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
-            << setw(8) << sigmaND << " mb    | \n";
-
-        // Photon-photon case.
-        } else {
-          sigmaTotPtr->calc( 22, 22, eCM );
-          sigmaND = sigmaTotPtr->sigmaND();
-          if (showMPI) cout << " |    gamma+gamma eCM = " << scientific
-            << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
-            << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
-            << setw(8) << sigmaND << " mb    | \n";
-        }
-      }
-
-    }
-
-    // Set current pT0 scale according to chosed parametrization.
-    if (pT0paramMode == 0) pT0 = pT0Ref * pow(eCM / ecmRef, ecmPow);
-    else                   pT0 = pT0Ref + ecmPow * log (eCM / ecmRef);
-
-    // The pT0 value may need to be decreased, if sigmaInt < sigmaND.
-    double pT4dSigmaMaxBeg = 0.;
-    for ( ; ; ) {
-
-      // Derived pT kinematics combinations.
-      pT20         = pT0*pT0;
-      pT2min       = pTmin*pTmin;
-      pTmax        = 0.5*eCM;
-      pT2max       = pTmax*pTmax;
-      pT20R        = RPT20 * pT20;
-      pT20minR     = pT2min + pT20R;
-      pT20maxR     = pT2max + pT20R;
-      pT20min0maxR = pT20minR * pT20maxR;
-      pT2maxmin    = pT2max - pT2min;
-
-      // Provide upper estimate of interaction rate d(Prob)/d(pT2).
-      upperEnvelope();
-
-      // Setup binning in b for x-dependent matter profile.
-      if (bProfile == 4) {
-        sigmaIntWgt.resize(XDEP_BBIN);
-        sigmaSumWgt.resize(XDEP_BBIN);
-        bstepNow = XDEP_BSTEP;
-      }
-
-      // Integrate the parton-parton interaction cross section.
-      pT4dSigmaMaxBeg = pT4dSigmaMax;
-      jetCrossSection();
-
-      // If the overlap-weighted cross section has not fallen below
-      // cutoff, then increase bin size in b and reintegrate.
-      while (bProfile == 4
-        && sigmaIntWgt[XDEP_BBIN - 1] > XDEP_CUTOFF * sigmaInt) {
-        bstepNow += XDEP_BSTEPINC;
-        jetCrossSection();
-      }
-
-      // Sufficiently big SigmaInt or reduce pT0; maybe also pTmin.
-      if (sigmaInt > SIGMASTEP * sigmaND) break;
-      if (showMPI) cout << fixed << setprecision(2) << " |    pT0 = "
-        << setw(5) << pT0 << " gives sigmaInteraction = " << setw(8)
-        << ((sigmaInt > SIGMAMBLIMIT) ? fixed : scientific) << sigmaInt
-        << " mb: rejected    | \n";
-      if (pTmin > pT0) pTmin *= PT0STEP;
-      pT0 *= PT0STEP;
-
-      // Give up if pT0 and pTmin fall too low.
-      if ( max(pT0, pTmin) < max(PT0MIN, Lambda3) ) {
-        infoPtr->errorMsg("Error in MultipartonInteractions::init:"
-          " failed to find acceptable pT0 and pTmin");
-        infoPtr->setTooLowPTmin(true);
-        return false;
+    if (nStep > 1) setMassStep( iStep, showMPI);
+
+    // Reuse results of an identical earlier initialization, if available.
+    vector<double> cacheValues;
+    bool fromCache = (initCachePtr != 0)
+      && initCachePtr->get( cacheTags[iStep], cacheValues)
+      && readInitState( cacheValues);
+
+    // Else use the result of a forked process, or find pT0 and the
+    // interaction rate here, and store the outcome. A forked process
+    // started from the original pTmin, so its result is not used if an
+    // earlier step has lowered pTmin, but the step is redone, as it would
+    // have been without forking.
+    if (!fromCache) {
+      bool useForked = valuesForked[iStep].size() > 0
+        && pTmin == pTminForked;
+      if ( !(useForked && readInitState( valuesForked[iStep]))
+        && !initStep( showMPI)) return false;
+      if (initCachePtr != 0) {
+        saveInitState( cacheValues);
+        initCachePtr->put( cacheTags[iStep], cacheValues);
       }
     }
 
@@ -706,11 +637,8 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
       << ((sigmaInt > SIGMAMBLIMIT) ? fixed : scientific) << sigmaInt
       << " mb: accepted    | \n";
 
-    // Calculate factor relating matter overlap and interaction rate.
-    overlapInit();
-
     // Maximum violation relative to first estimate.
-    sigmaMaxViol = max( sigmaMaxViol, pT4dSigmaMax / pT4dSigmaMaxBeg);
+    sigmaMaxViol = max( sigmaMaxViol, sigmaViolNow);
 
     // Save values calculated.
     if (nStep > 1) {
@@ -790,6 +718,320 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
 
 //--------------------------------------------------------------------------
 
+// Find pT0 and integrate the interaction cross section for the current
+// energy, and from it the matter overlap, as part of the initialization.
+
+bool MultipartonInteractions::initStep( bool showMPI) {
+
+  // Set current pT0 scale according to chosed parametrization.
+  if (pT0paramMode == 0) pT0 = pT0Ref * pow(eCM / ecmRef, ecmPow);
+  else                   pT0 = pT0Ref + ecmPow * log (eCM / ecmRef);
+
+  // The pT0 value may need to be decreased, if sigmaInt < sigmaND.
+  double pT4dSigmaMaxBeg = 0.;
+  for ( ; ; ) {
+
+    // Derived pT kinematics combinations.
+    pT20         = pT0*pT0;
+    pT2min       = pTmin*pTmin;
+    pTmax        = 0.5*eCM;
+    pT2max       = pTmax*pTmax;
+    pT20R        = RPT20 * pT20;
+    pT20minR     = pT2min + pT20R;
+    pT20maxR     = pT2max + pT20R;
+    pT20min0maxR = pT20minR * pT20maxR;
+    pT2maxmin    = pT2max - pT2min;
+
+    // Provide upper estimate of interaction rate d(Prob)/d(pT2).
+    upperEnvelope();
+
+    // Setup binning in b for x-dependent matter profile.
+    if (bProfile == 4) {
+      sigmaIntWgt.resize(XDEP_BBIN);
+      sigmaSumWgt.resize(XDEP_BBIN);
+      bstepNow = XDEP_BSTEP;
+    }
+
+    // Integrate the parton-parton interaction cross section.
+    pT4dSigmaMaxBeg = pT4dSigmaMax;
+    jetCrossSection();
+
+    // If the overlap-weighted cross section has not fallen below
+    // cutoff, then increase bin size in b and reintegrate.
+    while (bProfile == 4
+      && sigmaIntWgt[XDEP_BBIN - 1] > XDEP_CUTOFF * sigmaInt) {
+      bstepNow += XDEP_BSTEPINC;
+      jetCrossSection();
+    }
+
+    // Sufficiently big SigmaInt or reduce pT0; maybe also pTmin.
+    if (sigmaInt > SIGMASTEP * sigmaND) break;
+    if (showMPI) cout << fixed << setprecision(2) << " |    pT0 = "
+      << setw(5) << pT0 << " gives sigmaInteraction = " << setw(8)
+      << ((sigmaInt > SIGMAMBLIMIT) ? fixed : scientific) << sigmaInt
+      << " mb: rejected    | \n";
+    if (pTmin > pT0) pTmin *= PT0STEP;
+    pT0 *= PT0STEP;
+
+    // Give up if pT0 and pTmin fall too low.
+    if ( max(pT0, pTmin) < max(PT0MIN, alphaS.Lambda3()) ) {
+      infoPtr->errorMsg("Error in MultipartonInteractions::init:"
+        " failed to find acceptable pT0 and pTmin");
+      infoPtr->setTooLowPTmin(true);
+      return false;
+    }
+  }
+
+  // Calculate factor relating matter overlap and interaction rate.
+  overlapInit();
+
+  // Maximum violation relative to first estimate.
+  sigmaViolNow = pT4dSigmaMax / pT4dSigmaMaxBeg;
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set the current diffractive or gamma+gamma mass of a step, and the
+// fictitious Pomeron-proton cross section for normalization.
+
+void MultipartonInteractions::setMassStep( int iStep, bool showMPI) {
+
+  // Masses are evenly spaced in logarithm.
+  if (!hasGamma) eCM = mMinPertDiff * pow( mMaxPertDiff / mMinPertDiff,
+                       iStep / (nStep - 1.) );
+  else eCM = mGmGmMin * pow( mGmGmMax / mGmGmMin, iStep / (nStep - 1.) );
+  sCM = eCM * eCM;
+
+  // MPI for diffractive events. Rescale Pom/p flux to use for Pom/gamma.
+  if (hasPomeronBeams) {
+    double gamPomRatio = 1.;
+    if (hasGamma) {
+      sigmaTotPtr->calc(22, 2212, eCM);
+      double sigGamP = sigmaTotPtr->sigmaTot();
+      sigmaTotPtr->calc(2212, 2212, eCM);
+      double sigPP   = sigmaTotPtr->sigmaTot();
+      gamPomRatio = sigGamP / sigPP;
+    }
+    sigmaND = gamPomRatio * sigmaPomP * pow( eCM / mPomP, pPomP);
+    if (showMPI) cout << " |   diffractive mass = " << scientific
+      << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
+      << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
+      << setw(8) << sigmaND << " mb    | \n";
+
+    // Keep track of pomeron momentum fraction.
+    if ( beamAPtr->id() == 990 && beamBPtr->id() == 990 ) {
+      beamAPtr->xPom(eCM/eCMsave);
+      beamBPtr->xPom(eCM/eCMsave);
+    }
+    else if ( beamAPtr->id() == 990 )
+      beamAPtr->xPom(pow2(eCM/eCMsave));
+    else if ( beamBPtr->id() == 990 )
+      beamBPtr->xPom(pow2(eCM/eCMsave));
+  // MPI with photons from leptons.
+  } else {
+
+    // Hadron-photon case.
+    if ( isHadronGamma ) {
+      sigmaTotPtr->calc( beamAPtr->id(), 22, eCM );
+      sigmaND = sigmaTotPtr->sigmaND();
+      if (showMPI) cout << " |   hadron+gamma eCM = " << scientific
+        << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
+        << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
+        << setw(8) << sigmaND << " mb    | \n";
+
+    // Photon-hadron case.
+    } else if ( isGammaHadron )  {
+      sigmaTotPtr->calc( 22, beamBPtr->id(), eCM );
+      sigmaND = sigmaTotPtr->sigmaND();
+      if (showMPI) cout << " |   gamma+hadron eCM = " << scientific
+        << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
+        << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
+        << setw(8) << sigmaND << " mb    | \n";
+
+    // Photon-photon case.
+    } else {
+      sigmaTotPtr->calc( 22, 22, eCM );
+      sigmaND = sigmaTotPtr->sigmaND();
+      if (showMPI) cout << " |    gamma+gamma eCM = " << scientific
+        << setprecision(2) << setw(8) << eCM << " GeV and sigmaNorm = "
+        << ((sigmaND > SIGMAMBLIMIT) ? fixed : scientific)
+        << setw(8) << sigmaND << " mb    | \n";
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find pT0 and the interaction rate for all mass steps in parallel, each
+// in a process forked from this one, so that it has its own copy of the
+// beams, PDFs and random number generator. Each step uses a random number
+// stream of its own, seeded from the generator of this process. Steps
+// found in the initialization cache are skipped. Results are returned in
+// temporary files; a step that fails is left empty, to be redone in init().
+
+void MultipartonInteractions::initStepsForked( int nProcesses,
+  const vector<string>& cacheTags, vector< vector<double> >& valuesOut) {
+
+  // Directory for the temporary files.
+  const char* tmpDirPtr = getenv("TMPDIR");
+  string tmpDir = (tmpDirPtr != 0 && *tmpDirPtr != '\0') ? tmpDirPtr : "/tmp";
+
+  // Output buffered so far would otherwise be repeated by each process.
+  cout << std::flush;
+  fflush(stdout);
+
+  // Seeds of the steps. Always one per step, so that later random numbers
+  // of this process do not depend on which steps are forked.
+  vector<int> seeds(nStep);
+  for (int iStep = 0; iStep < nStep; ++iStep)
+    seeds[iStep] = 1 + min( NSEEDMAX - 1, int(NSEEDMAX * rndmPtr->flat()));
+
+  // Start one process per step, but not more than nProcesses at a time.
+  InitCache* initCachePtr = infoPtr->initCachePtr();
+  vector<pid_t>  pids(nStep, 0);
+  vector<int>    status(nStep, 1);
+  vector<string> fileNames(nStep);
+  int iWait = 0;
+  for (int iStep = 0; iStep < nStep; ++iStep) {
+    if (initCachePtr != 0 && initCachePtr->has( cacheTags[iStep])) continue;
+    int nRunning = 0;
+    for (int i = iWait; i < iStep; ++i) if (pids[i] > 0) ++nRunning;
+    for ( ; nRunning >= nProcesses; ++iWait) if (pids[iWait] > 0) {
+      waitpid( pids[iWait], &status[iWait], 0);
+      pids[iWait] = 0;
+      --nRunning;
+    }
+
+    // Temporary file for the results.
+    string fileTmp = tmpDir + "/pythia8mpiXXXXXX";
+    vector<char> nameTmp( fileTmp.begin(), fileTmp.end());
+    nameTmp.push_back('\0');
+    int fileDes = mkstemp( &nameTmp[0]);
+    if (fileDes < 0) break;
+    close(fileDes);
+    fileNames[iStep] = &nameTmp[0];
+
+    // The process for a step never returns from here.
+    setMassStep( iStep, false);
+    pids[iStep] = fork();
+    if (pids[iStep] == 0) {
+      rndmPtr->init( seeds[iStep]);
+      bool isOK = initStep( false);
+      vector<double> values;
+      saveInitState( values);
+      int nValues = values.size();
+      ofstream os( fileNames[iStep].c_str(), ios::binary);
+      writeBinary( os, nValues);
+      for (int i = 0; i < nValues; ++i) writeBinary( os, values[i]);
+      os.close();
+      _exit( (isOK && os) ? 0 : 1);
+    }
+    if (pids[iStep] < 0) {
+      pids[iStep] = 0;
+      break;
+    }
+  }
+
+  // Wait for the remaining processes, and read back their results.
+  for (int iStep = 0; iStep < nStep; ++iStep) {
+    if (pids[iStep] > 0) waitpid( pids[iStep], &status[iStep], 0);
+    if (fileNames[iStep] == "") continue;
+    ifstream is( fileNames[iStep].c_str(), ios::binary);
+    int nValues = 0;
+    if (WIFEXITED(status[iStep]) && WEXITSTATUS(status[iStep]) == 0
+      && readBinary( is, nValues) && nValues > 0) {
+      valuesOut[iStep].resize( nValues);
+      for (int i = 0; i < nValues; ++i)
+      if (!readBinary( is, valuesOut[iStep][i])) {
+        valuesOut[iStep].resize(0);
+        break;
+      }
+    }
+    is.close();
+    remove( fileNames[iStep].c_str());
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store the results of initStep() for the current energy, for use by
+// the initialization cache.
+
+void MultipartonInteractions::saveInitState( vector<double>& values) {
+
+  double valuesNow[NINITSTATE] = { pT0, pTmin, pT4dSigmaMax, pT4dProbMax,
+    sigmaInt, zeroIntCorr, normOverlap, nAvg, kNow, normPi, bAvg, bDiv,
+    probLowB, enhanceBavg, fracAhigh, fracBhigh, fracChigh, fracABChigh,
+    cDiv, cMax, a0now, a02now, a2max, bstepNow, sigmaViolNow };
+  values.resize( NINITSTATE + 101);
+  for (int i = 0; i < NINITSTATE; ++i) values[i] = valuesNow[i];
+  for (int j = 0; j <= 100; ++j) values[NINITSTATE + j] = sudExpPT[j];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Restore the results of initStep() from the initialization cache.
+
+bool MultipartonInteractions::readInitState( const vector<double>& values) {
+
+  // Check that the record is of the expected size.
+  if (int(values.size()) != NINITSTATE + 101) return false;
+
+  // Read back values in the same order as they were stored.
+  int i = 0;
+  pT0          = values[i++];
+  pTmin        = values[i++];
+  pT4dSigmaMax = values[i++];
+  pT4dProbMax  = values[i++];
+  sigmaInt     = values[i++];
+  zeroIntCorr  = values[i++];
+  normOverlap  = values[i++];
+  nAvg         = values[i++];
+  kNow         = values[i++];
+  normPi       = values[i++];
+  bAvg         = values[i++];
+  bDiv         = values[i++];
+  probLowB     = values[i++];
+  enhanceBavg  = values[i++];
+  fracAhigh    = values[i++];
+  fracBhigh    = values[i++];
+  fracChigh    = values[i++];
+  fracABChigh  = values[i++];
+  cDiv         = values[i++];
+  cMax         = values[i++];
+  a0now        = values[i++];
+  a02now       = values[i++];
+  a2max        = values[i++];
+  bstepNow     = values[i++];
+  sigmaViolNow = values[i++];
+  for (int j = 0; j <= 100; ++j) sudExpPT[j] = values[i++];
+
+  // Derived pT kinematics combinations.
+  pT20         = pT0*pT0;
+  pT2min       = pTmin*pTmin;
+  pTmax        = 0.5*eCM;
+  pT2max       = pTmax*pTmax;
+  pT20R        = RPT20 * pT20;
+  pT20minR     = pT2min + pT20R;
+  pT20maxR     = pT2max + pT20R;
+  pT20min0maxR = pT20minR * pT20maxR;
+  pT2maxmin    = pT2max - pT2min;
+  if (bProfile == 4) infoPtr->seta0MPI(a0now * XDEP_SMB2FM);
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Reset impact parameter choice and update the CM energy.
 // For diffraction also interpolate parameters to current CM energy.
 
@@ -1666,16 +1908,20 @@ double MultipartonInteractions::sigmaPT2scatter(bool isFirst) {
   double xPDF2[21];
   double xPDF2sum = 0.;
 
-  // For first interaction use normal densities.
+  // For first interaction use normal densities, all flavours in one call.
   if (isFirst) {
+    double xfAll1[PDF::NXFBATCH];
+    double xfAll2[PDF::NXFBATCH];
+    beamAPtr->xfBatch( 1, &x1, &pT2Fac, xfAll1);
+    beamBPtr->xfBatch( 1, &x2, &pT2Fac, xfAll2);
     for (int id = -nQuarkIn; id <= nQuarkIn; ++id) {
-      if (id == 0) xPDF1[10] = (9./4.) * beamAPtr->xf(21, x1, pT2Fac);
-      else xPDF1[id+10] = beamAPtr->xf(id, x1, pT2Fac);
+      if (id == 0) xPDF1[10] = (9./4.) * xfAll1[PDF::xfBatchIndex(21)];
+      else xPDF1[id+10] = xfAll1[PDF::xfBatchIndex(id)];
       xPDF1sum += xPDF1[id+10];
     }
     for (int id = -nQuarkIn; id <= nQuarkIn; ++id) {
-      if (id == 0) xPDF2[10] = (9./4.) * beamBPtr->xf(21, x2, pT2Fac);
-      else xPDF2[id+10] = beamBPtr->xf(id, x2, pT2Fac);
+      if (id == 0) xPDF2[10] = (9./4.) * xfAll2[PDF::xfBatchIndex(21)];
+      else xPDF2[id+10] = xfAll2[PDF::xfBatchIndex(id)];
       xPDF2sum += xPDF2[id+10];
     }
 
@@ -585,6 +585,14 @@ void ParticleDataEntry::setConstituentMass() {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Minimal number of slots in the hash index; must be a power of two.
+const int ParticleData::INDEXSIZEMIN = 256;
+
+//--------------------------------------------------------------------------
+
 // Get data to be distributed among particles during setup.
 // Note: this routine is called twice. Firstly from init(...), but
 // the data should not be used at that point, so is likely overkill.
@@ -871,8 +879,24 @@ bool ParticleData::readXML(istream &inStr, bool reset) {
 
 bool ParticleData::copyXML(const ParticleData &particleDataIn) {
 
+  // A database read from a binary image has no XML lines. Then copy the
+  // particle entries, but keep the pointers of the current object.
+  if (particleDataIn.xmlFileSav.size() == 0 && particleDataIn.isInit) {
+    Info*      infoPtrNow      = infoPtr;
+    Settings*  settingsPtrNow  = settingsPtr;
+    Rndm*      rndmPtrNow      = rndmPtr;
+    Couplings* couplingsPtrNow = couplingsPtr;
+    pdt.clear();
+    pdtIndex.clear();
+    *this = particleDataIn;
+    initPtr( infoPtrNow, settingsPtrNow, rndmPtrNow, couplingsPtrNow);
+    initCommon();
+    return true;
+  }
+
   // First Reset everything.
   pdt.clear();
+  pdtIndex.clear();
   xmlFileSav.clear();
   readStringHistory.resize(0);
   readStringSubrun.clear();
@@ -894,6 +918,7 @@ bool ParticleData::loadXML(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    pdtIndex.clear();
     xmlFileSav.clear();
     readStringHistory.resize(0);
     readStringSubrun.clear();
@@ -1052,6 +1077,111 @@ bool ParticleData::processXML(bool reset) {
 
 //--------------------------------------------------------------------------
 
+// Read in database from a binary image, as written by writeBinary.
+
+bool ParticleData::initBinary(istream& is) {
+
+  // Reset whole database before beginning.
+  initCommon();
+  pdt.clear();
+  pdtIndex.clear();
+  xmlFileSav.clear();
+  readStringHistory.resize(0);
+  readStringSubrun.clear();
+  isInit = false;
+
+  // Read in one particle at a time.
+  int nParticle = 0;
+  bool isOK = readBinary( is, nParticle);
+  for (int iPart = 0; isOK && iPart < nParticle; ++iPart) {
+    int idTmp, spinTypeTmp, chargeTypeTmp, colTypeTmp, nChannel;
+    double m0Tmp, mWidthTmp, mMinTmp, mMaxTmp, tau0Tmp;
+    string nameTmp, antiNameTmp;
+    isOK = readBinary( is, idTmp) && readBinary( is, nameTmp)
+      && readBinary( is, antiNameTmp) && readBinary( is, spinTypeTmp)
+      && readBinary( is, chargeTypeTmp) && readBinary( is, colTypeTmp)
+      && readBinary( is, m0Tmp) && readBinary( is, mWidthTmp)
+      && readBinary( is, mMinTmp) && readBinary( is, mMaxTmp)
+      && readBinary( is, tau0Tmp) && readBinary( is, nChannel);
+    if (!isOK) break;
+    addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
+                 colTypeTmp, m0Tmp, mWidthTmp, mMinTmp, mMaxTmp, tau0Tmp);
+    particlePtr = particleDataEntryPtr(idTmp);
+
+    // Read in its decay channels.
+    for (int iChan = 0; isOK && iChan < nChannel; ++iChan) {
+      int onMode, meMode, nProd;
+      double bRatio;
+      int prod[8] = { 0, 0, 0, 0, 0, 0, 0, 0};
+      isOK = readBinary( is, onMode) && readBinary( is, bRatio)
+        && readBinary( is, meMode) && readBinary( is, nProd)
+        && nProd >= 0 && nProd <= 8;
+      for (int j = 0; isOK && j < nProd; ++j) isOK = readBinary( is, prod[j]);
+      if (isOK) particlePtr->addChannel(onMode, bRatio, meMode, prod[0],
+        prod[1], prod[2], prod[3], prod[4], prod[5], prod[6], prod[7]);
+    }
+  }
+
+  // Leave an empty database behind if the image could not be read.
+  particlePtr = 0;
+  if (!isOK) {
+    pdt.clear();
+    pdtIndex.clear();
+    return false;
+  }
+
+  // All particle data at this stage defines baseline original.
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) pdtEntry->second.setHasChanged(false);
+
+  // Done.
+  isInit = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the database to a binary image, which can be read back much faster
+// than the XML file. Only the information in the XML file is stored.
+
+bool ParticleData::writeBinary(ostream& os) {
+
+  // Write one particle at a time, with its decay channels.
+  Pythia8::writeBinary( os, int(pdt.size()));
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) {
+    const ParticleDataEntry& entry = pdtEntry->second;
+    Pythia8::writeBinary( os, entry.id());
+    Pythia8::writeBinary( os, entry.name(1));
+    Pythia8::writeBinary( os, entry.name(-1));
+    Pythia8::writeBinary( os, entry.spinType());
+    Pythia8::writeBinary( os, entry.chargeType());
+    Pythia8::writeBinary( os, entry.colType());
+    Pythia8::writeBinary( os, entry.m0());
+    Pythia8::writeBinary( os, entry.mWidth());
+    Pythia8::writeBinary( os, entry.mMin());
+    Pythia8::writeBinary( os, entry.mMax());
+    Pythia8::writeBinary( os, entry.tau0());
+    Pythia8::writeBinary( os, entry.sizeChannels());
+    for (int i = 0; i < entry.sizeChannels(); ++i) {
+      const DecayChannel& channel = entry.channel(i);
+      Pythia8::writeBinary( os, channel.onMode());
+      Pythia8::writeBinary( os, channel.bRatio());
+      Pythia8::writeBinary( os, channel.meMode());
+      Pythia8::writeBinary( os, channel.multiplicity());
+      for (int j = 0; j < channel.multiplicity(); ++j)
+        Pythia8::writeBinary( os, channel.product(j));
+    }
+  }
+
+  // Done.
+  return bool(os);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Print out complete database in numerical order as an XML file.
 
 void ParticleData::listXML(string outFile) {
@@ -1126,6 +1256,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    pdtIndex.clear();
     readStringHistory.resize(0);
     readStringSubrun.clear();
     isInit = false;
@@ -2193,6 +2324,53 @@ int ParticleData::nextId(int idIn) {
 
 //--------------------------------------------------------------------------
 
+// Add an entry of the map to the hash index. The index is kept at most half
+// full, so that lookups normally need only one or two probes.
+
+void ParticleData::indexParticle(int idAbs) {
+
+  // Rebuild the whole index if it would become too full.
+  if (2 * pdt.size() > pdtIndex.size()) {
+    indexParticles();
+    return;
+  }
+
+  // Else insert or update the entry in the first matching or free slot.
+  map<int, ParticleDataEntry>::iterator found = pdt.find(idAbs);
+  if (found == pdt.end()) return;
+  int mask = pdtIndex.size() - 1;
+  int i    = hashIndex(idAbs) & mask;
+  while (pdtIndex[i].first >= 0 && pdtIndex[i].first != idAbs)
+    i = (i + 1) & mask;
+  pdtIndex[i] = make_pair( idAbs, &found->second);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Rebuild the hash index from the map, with a size that is a power of two
+// and at least four times the number of entries.
+
+void ParticleData::indexParticles() {
+
+  // Reset index to the new size.
+  int nSlot = INDEXSIZEMIN;
+  while (nSlot < 4 * int(pdt.size())) nSlot *= 2;
+  pdtIndex.assign( nSlot, make_pair( -1, (ParticleDataEntry*)(NULL)));
+
+  // Insert all entries.
+  int mask = nSlot - 1;
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) {
+    int i = hashIndex(pdtEntry->first) & mask;
+    while (pdtIndex[i].first >= 0) i = (i + 1) & mask;
+    pdtIndex[i] = make_pair( pdtEntry->first, &pdtEntry->second);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Fractional width associated with open channels of one or two resonances.
 
 double ParticleData::resOpenFrac(int id1In, int id2In, int id3In) {
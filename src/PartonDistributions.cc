@@ -3,16 +3,208 @@
 // PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
-// Function definitions (not found in the header) for the PDF, LHAPDF,
-// GRV94L, CTEQ5L,  MSTWpdf, CTEQ6pdf, GRVpiL, PomFix, PomH1FitAB,
-// PomH1Jets, Lepton, NNPDF and CJKL classes.
+// Function definitions (not found in the header) for the PDFGridImage,
+// PDF, LHAPDF, GRV94L, CTEQ5L,  MSTWpdf, CTEQ6pdf, GRVpiL, PomFix,
+// PomH1FitAB, PomH1Jets, Lepton, NNPDF and CJKL classes.
 
 #include "Pythia8/PartonDistributions.h"
 
+// Map files into memory, and access file size and modification time.
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+
 namespace Pythia8 {
 
 //==========================================================================
 
+// The PDFGridImage class.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Version of the image file layout; older images are converted anew.
+const int    PDFGridImage::FORMATVERSION = 1;
+
+// Blocks begin at multiples of this size, a multiple of the page size.
+const long   PDFGridImage::PAGESIZE      = 65536;
+
+// Value stored to check that the image was written with the same
+// representation of doubles.
+const double PDFGridImage::ENDIANCHECK   = 1.2345678901234567;
+
+// First text in the image file.
+const string PDFGridImage::FILEHEADER    = "PYTHIA8PDFGRID";
+
+//--------------------------------------------------------------------------
+
+// Name of the image file of a data file: the name of the data file, with
+// the directory replaced by the image one and .bin added.
+
+string PDFGridImage::imageFile(string dataFile, string imageDir) {
+
+  if (imageDir != "" && imageDir[ imageDir.length() - 1 ] != '/')
+    imageDir += "/";
+  size_t iSlash = dataFile.rfind('/');
+  return imageDir + ((iSlash == string::npos) ? dataFile
+    : dataFile.substr(iSlash + 1)) + ".bin";
+
+}
+
+//--------------------------------------------------------------------------
+
+// Map an existing image, if it is up to date and has the right tag.
+
+bool PDFGridImage::open(string imageFileIn, string dataFile, string tag) {
+
+  // Read and check the header.
+  close();
+  ifstream is( imageFileIn.c_str(), ios::in | ios::binary);
+  if (!is.good()) return false;
+  string header, tagNow;
+  int version = 0;
+  int nBlock = 0;
+  long long size, modTime, sizeNow, modTimeNow;
+  double endianCheck = 0.;
+  if (!readBinary( is, header) || header != FILEHEADER
+    || !readBinary( is, version) || version != FORMATVERSION
+    || !readBinary( is, endianCheck) || endianCheck != ENDIANCHECK
+    || !readBinary( is, tagNow) || tagNow != tag
+    || !readBinary( is, size) || !readBinary( is, modTime)
+    || !fileStamp( dataFile, sizeNow, modTimeNow) || size != sizeNow
+    || modTime != modTimeNow || !readBinary( is, nBlock) || nBlock < 0)
+    return false;
+
+  // Read the block positions.
+  long long offset, length;
+  long long sizeMin = 0;
+  for (int iBlock = 0; iBlock < nBlock; ++iBlock) {
+    if (!readBinary( is, offset) || !readBinary( is, length)
+      || offset % PAGESIZE != 0 || length < 0) {
+      blockOffset.clear();
+      blockLength.clear();
+      return false;
+    }
+    blockOffset.push_back( offset);
+    blockLength.push_back( length);
+    sizeMin = max( sizeMin, offset + length * (long long)sizeof(double));
+  }
+  is.close();
+
+  // Map the whole file read-only, if it is complete.
+  int fd = ::open( imageFileIn.c_str(), O_RDONLY);
+  struct stat fileStat;
+  if (fd < 0 || ::fstat( fd, &fileStat) != 0 || fileStat.st_size < sizeMin
+    || fileStat.st_size == 0) {
+    if (fd >= 0) ::close(fd);
+    blockOffset.clear();
+    blockLength.clear();
+    return false;
+  }
+  void* ptr = ::mmap( 0, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (ptr == MAP_FAILED) {
+    blockOffset.clear();
+    blockLength.clear();
+    return false;
+  }
+  mapPtr  = ptr;
+  mapSize = fileStat.st_size;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write an image of the blocks and map it. The image is first written to
+// a temporary file and then renamed, so that other processes never see
+// an incomplete image, even when several convert the same file at once.
+
+bool PDFGridImage::write(string imageFileIn, string dataFile, string tag,
+  const vector<const vector<double>*>& blocks) {
+
+  // Header, with block offsets such that each begins on a new page.
+  long long size, modTime;
+  if (!fileStamp( dataFile, size, modTime)) return false;
+  int nBlock = blocks.size();
+  ostringstream tmpName;
+  tmpName << imageFileIn << ".tmp" << ::getpid();
+  ofstream os( tmpName.str().c_str(), ios::out | ios::binary);
+  if (!os.good()) return false;
+  writeBinary( os, FILEHEADER);
+  writeBinary( os, FORMATVERSION);
+  writeBinary( os, ENDIANCHECK);
+  writeBinary( os, tag);
+  writeBinary( os, size);
+  writeBinary( os, modTime);
+  writeBinary( os, nBlock);
+  long long headerSize = 2 * sizeof(int) + sizeof(double)
+    + 2 * sizeof(long long) + FILEHEADER.length() + 2 * sizeof(int)
+    + tag.length() + nBlock * 2 * sizeof(long long);
+  long long offset = PAGESIZE * ((headerSize + PAGESIZE - 1) / PAGESIZE);
+  vector<long long> offsets;
+  for (int iBlock = 0; iBlock < nBlock; ++iBlock) {
+    long long length = blocks[iBlock]->size();
+    writeBinary( os, offset);
+    writeBinary( os, length);
+    offsets.push_back( offset);
+    offset += PAGESIZE * ((length * (long long)sizeof(double) + PAGESIZE - 1)
+      / PAGESIZE);
+  }
+
+  // The blocks, padded with zeroes up to their offsets.
+  for (int iBlock = 0; iBlock < nBlock; ++iBlock) {
+    long long nPad = offsets[iBlock] - (long long)os.tellp();
+    if (nPad > 0) os << string( nPad, '\0');
+    if (blocks[iBlock]->size() > 0) os.write( reinterpret_cast<const char*>
+      (&(*blocks[iBlock])[0]), blocks[iBlock]->size() * sizeof(double));
+  }
+  os.close();
+  if (!os || ::rename( tmpName.str().c_str(), imageFileIn.c_str()) != 0) {
+    ::remove( tmpName.str().c_str());
+    return false;
+  }
+
+  // Map the new image.
+  return open( imageFileIn, dataFile, tag);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Release the mapping.
+
+void PDFGridImage::close() {
+
+  if (mapPtr != 0) ::munmap( mapPtr, mapSize);
+  mapPtr  = 0;
+  mapSize = 0;
+  blockOffset.clear();
+  blockLength.clear();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Size and modification time of a file, to check that it is unchanged.
+
+bool PDFGridImage::fileStamp(string fileName, long long& size,
+  long long& modTime) {
+
+  struct stat fileStat;
+  if (::stat( fileName.c_str(), &fileStat) != 0) return false;
+  size    = fileStat.st_size;
+  modTime = fileStat.st_mtime;
+  return true;
+
+}
+
+//==========================================================================
+
 // Base class for parton distribution functions.
 
 //--------------------------------------------------------------------------
@@ -63,7 +255,7 @@ double PDF::xf(int id, double x, double Q2) {
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
   if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+    {idSav = id; xfUpdateCached(id, x, Q2); xSav = x; Q2Sav = Q2;}
 
   // Baryon beams: only p and pbar for now.
   if (idBeamAbs == 2212) {
@@ -188,7 +380,7 @@ double PDF::xfVal(int id, double x, double Q2) {
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
   if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+    {idSav = id; xfUpdateCached(id, x, Q2); xSav = x; Q2Sav = Q2;}
 
   // Baryon and nondiagonal meson beams: only p, pbar, n, nbar, pi+, pi-.
   if (idBeamAbs == 2212) {
@@ -241,7 +433,7 @@ double PDF::xfSea(int id, double x, double Q2) {
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
   if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+    {idSav = id; xfUpdateCached(id, x, Q2); xSav = x; Q2Sav = Q2;}
 
   // Hadron beams.
   if (idBeamAbs > 100) {
@@ -299,6 +491,107 @@ double PDF::xfSea(int id, double x, double Q2) {
 
 }
 
+//--------------------------------------------------------------------------
+
+// All parton densities at a number of (x, Q2) points. For each point
+// xfOut gets NXFBATCH values: ids -5 to 5 at index id + 5, where id 0
+// is the gluon, and then the photon. Default is one flavour at a time.
+
+void PDF::xfBatch(int nPoints, const double* x, const double* Q2,
+  double* xfOut) {
+
+  for (int i = 0; i < nPoints; ++i) {
+    double* xfNow = xfOut + i * NXFBATCH;
+    for (int id = -5; id <= 5; ++id) xfNow[id + 5] = xf( id, x[i], Q2[i]);
+    xfNow[NXFBATCH - 1] = xf( 22, x[i], Q2[i]);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Batch evaluation for PDFs where xfUpdate sets all flavours at once:
+// one update per point, and no virtual call for each flavour.
+
+void PDF::xfBatchAll(int nPoints, const double* x, const double* Q2,
+  double* xfOut) {
+
+  for (int i = 0; i < nPoints; ++i) {
+    if (idSav != 9 || x[i] != xSav || Q2[i] != Q2Sav)
+      xfUpdateCached( 9, x[i], Q2[i]);
+    idSav = 9;
+    xSav  = x[i];
+    Q2Sav = Q2[i];
+    double* xfNow = xfOut + i * NXFBATCH;
+
+    // Protons and antiprotons directly, else flavour by flavour.
+    if (idBeamAbs == 2212) {
+      double* xfQ    = (idBeam > 0) ? xfNow + 6 : xfNow + 4;
+      double* xfQbar = (idBeam > 0) ? xfNow + 4 : xfNow + 6;
+      int     iStep  = (idBeam > 0) ? 1 : -1;
+      xfNow[5]              = max( 0., xg);
+      xfQ[0]                = max( 0., xd);
+      xfQ[iStep]            = max( 0., xu);
+      xfQ[2 * iStep]        = max( 0., xs);
+      xfQ[3 * iStep]        = max( 0., xc);
+      xfQ[4 * iStep]        = max( 0., xb);
+      xfQbar[0]             = max( 0., xdbar);
+      xfQbar[-iStep]        = max( 0., xubar);
+      xfQbar[-2 * iStep]    = max( 0., xsbar);
+      xfQbar[-3 * iStep]    = max( 0., xc);
+      xfQbar[-4 * iStep]    = max( 0., xb);
+      xfNow[NXFBATCH - 1]   = max( 0., xgamma);
+    } else {
+      for (int id = -5; id <= 5; ++id)
+        xfNow[id + 5] = PDF::xf( id, x[i], Q2[i]);
+      xfNow[NXFBATCH - 1] = PDF::xf( 22, x[i], Q2[i]);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Look for the (x, Q2) point among the cached ones, and if found copy
+// all flavours from there. Else update as usual and store the result,
+// overwriting the oldest entry when the cache is full.
+
+void PDF::xfFromCache(int id, double x, double Q2) {
+
+  // Search the cache, starting from the most recent entry.
+  for (int j = 1; j <= nCacheUsed; ++j) {
+    int i = (iCacheNext - j + NCACHE) % NCACHE;
+    if (xCache[i] != x || Q2Cache[i] != Q2) continue;
+    ++nCacheHit;
+    const double* val = valCache[i];
+    xu    = val[0];  xd    = val[1];  xs    = val[2];  xubar = val[3];
+    xdbar = val[4];  xsbar = val[5];  xc    = val[6];  xb    = val[7];
+    xg    = val[8];  xlepton = val[9]; xgamma = val[10];
+    xuVal = val[11]; xuSea = val[12]; xdVal = val[13]; xdSea = val[14];
+    xsVal = val[15]; xcVal = val[16]; xbVal = val[17]; xsSea = val[18];
+    xcSea = val[19]; xbSea = val[20];
+    idSav = 9;
+    return;
+  }
+
+  // Not found: do the full update and save it.
+  ++nCacheMiss;
+  xfUpdate( id, x, Q2);
+  int i      = iCacheNext;
+  xCache[i]  = x;
+  Q2Cache[i] = Q2;
+  double* val = valCache[i];
+  val[0]  = xu;    val[1]  = xd;    val[2]  = xs;    val[3]  = xubar;
+  val[4]  = xdbar; val[5]  = xsbar; val[6]  = xc;    val[7]  = xb;
+  val[8]  = xg;    val[9]  = xlepton; val[10] = xgamma;
+  val[11] = xuVal; val[12] = xuSea; val[13] = xdVal; val[14] = xdSea;
+  val[15] = xsVal; val[16] = xcVal; val[17] = xbVal; val[18] = xsSea;
+  val[19] = xcSea; val[20] = xbSea;
+  iCacheNext = (iCacheNext + 1) % NCACHE;
+  if (nCacheUsed < NCACHE) ++nCacheUsed;
+
+}
+
 //==========================================================================
 
 // Gives the GRV 94 L (leading order) parton distribution function set
@@ -685,9 +978,13 @@ void MSTWpdf::init(int iFitIn, string xmlPath, Info* infoPtr) {
   if (iFit == 2) fileName = "mrstlostarstar.00.dat";
   if (iFit == 3) fileName = "mstw2008lo.00.dat";
   if (iFit == 4) fileName = "mstw2008nlo.00.dat";
+  dataFile = xmlPath + fileName;
+
+  // Use the binary image of the grid, if it exists and is up to date.
+  if (imageDir != "" && readImage()) return;
 
   // Open data file.
-  ifstream data_file( (xmlPath + fileName).c_str() );
+  ifstream data_file( dataFile.c_str() );
   if (!data_file.good()) {
     printErr("Error in MSTWpdf::init: did not find data file ", infoPtr);
     isSet = false;
@@ -698,6 +995,10 @@ void MSTWpdf::init(int iFitIn, string xmlPath, Info* infoPtr) {
   init(data_file, infoPtr);
   data_file.close();
 
+  // Write the image, to be shared by this and later processes.
+  if (imageDir != "" && isSet && !writeImage()) printErr("Warning in "
+    "MSTWpdf::init: could not write binary grid image", infoPtr);
+
 }
 
 //--------------------------------------------------------------------------
@@ -828,6 +1129,9 @@ void MSTWpdf::init(istream& data_file, Info* infoPtr) {
       f[i][nx][m]=0.0;
 
   // Set up the new array in log10(x) and log10(qsq).
+  cSave.assign( (np + 1) * nx * nq * 25, 0.);
+  CoeffGrid* cNow = reinterpret_cast<CoeffGrid*>(&cSave[0]);
+  c = cNow;
   for (i=1;i<=nx;i++)
     xx[i]=log10(xxInit[i]);
   for (m=1;m<=nq;m++)
@@ -962,7 +1266,7 @@ void MSTWpdf::init(istream& data_file, Info* infoPtr) {
 
         l=0;
         for (k=1;k<=4;k++)
-          for (j=1;j<=4;j++) c[i][n][m][k][j]=cl[l++];
+          for (j=1;j<=4;j++) cNow[i][n][m][k][j]=cl[l++];
       } //m
     } //n
   } // i
@@ -971,6 +1275,77 @@ void MSTWpdf::init(istream& data_file, Info* infoPtr) {
 
 //--------------------------------------------------------------------------
 
+// Take the grid from its binary image. The coefficients are used directly
+// from the mapped memory, while the rest is copied.
+
+bool MSTWpdf::readImage() {
+
+  // Check that the image has the expected blocks.
+  if (!gridImage.open( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "MSTWpdf") || gridImage.nBlocks() != 4
+    || gridImage.blockSize(0) != 8 || gridImage.blockSize(1) != 65
+    || gridImage.blockSize(2) != 49
+    || gridImage.blockSize(3) != (np + 1) * nx * nq * 25) {
+    gridImage.close();
+    return false;
+  }
+
+  // Copy the parameters and the x and q grids.
+  const double* scalars = gridImage.block(0);
+  alphaSorder = int(scalars[0]);
+  alphaSnfmax = int(scalars[1]);
+  mCharm      = scalars[2];
+  mBottom     = scalars[3];
+  alphaSQ0    = scalars[4];
+  alphaSMZ    = scalars[5];
+  distance    = scalars[6];
+  tolerance   = scalars[7];
+  for (int i = 0; i < 65; ++i) xx[i] = gridImage.block(1)[i];
+  for (int i = 0; i < 49; ++i) qq[i] = gridImage.block(2)[i];
+
+  // Point to the coefficients in the image.
+  c     = reinterpret_cast<const CoeffGrid*>(gridImage.block(3));
+  isSet = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the binary image of the grid, and then use the coefficients from
+// it instead of from the private array.
+
+bool MSTWpdf::writeImage() {
+
+  // Collect the data in blocks.
+  vector<double> scalars(8);
+  scalars[0] = alphaSorder;
+  scalars[1] = alphaSnfmax;
+  scalars[2] = mCharm;
+  scalars[3] = mBottom;
+  scalars[4] = alphaSQ0;
+  scalars[5] = alphaSMZ;
+  scalars[6] = distance;
+  scalars[7] = tolerance;
+  vector<double> xxNow( xx, xx + 65);
+  vector<double> qqNow( qq, qq + 49);
+  vector<const vector<double>*> blocks;
+  blocks.push_back( &scalars);
+  blocks.push_back( &xxNow);
+  blocks.push_back( &qqNow);
+  blocks.push_back( &cSave);
+  if (!gridImage.write( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "MSTWpdf", blocks)) return false;
+
+  // Switch to the mapped coefficients and release the private ones.
+  c = reinterpret_cast<const CoeffGrid*>(gridImage.block(3));
+  vector<double>().swap( cSave);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Update PDF values.
 
 void MSTWpdf::xfUpdate(int , double x, double Q2) {
@@ -1311,9 +1686,13 @@ void CTEQ6pdf::init(int iFitIn, string xmlPath, Info* infoPtr) {
   if (iFit == 13) fileName = "pomactwsg14.pds";
   if (iFit == 14) fileName = "pomactwd19.pds";
   bool isPdsGrid = (iFit > 2);
+  dataFile = xmlPath + fileName;
+
+  // Use the binary image of the grid, if it exists and is up to date.
+  if (imageDir != "" && readImage()) return;
 
   // Open data file.
-  ifstream pdfgrid( (xmlPath + fileName).c_str() );
+  ifstream pdfgrid( dataFile.c_str() );
   if (!pdfgrid.good()) {
     printErr("Error in CTEQ6pdf::init: did not find data file", infoPtr);
     isSet = false;
@@ -1324,6 +1703,10 @@ void CTEQ6pdf::init(int iFitIn, string xmlPath, Info* infoPtr) {
   init( pdfgrid, isPdsGrid, infoPtr);
   pdfgrid.close();
 
+  // Write the image, to be shared by this and later processes.
+  if (imageDir != "" && isSet && !writeImage()) printErr("Warning in "
+    "CTEQ6pdf::init: could not write binary grid image", infoPtr);
+
 }
 
 //--------------------------------------------------------------------------
@@ -1425,12 +1808,25 @@ void CTEQ6pdf::init(istream& pdfgrid, bool isPdsGrid, Info* infoPtr) {
   int nBlk  = (nX + 1) * (nT + 1);
   int nPts  = nBlk * (nfMx + 1 + mxVal);
   int nPack = (isPdsGrid) ? 6 : 5;
+  updSave.assign( nPts + 1, 0.);
   for (int iRng = 0; iRng < int( (nPts + nPack - 1) / nPack); ++iRng) {
     getline( pdfgrid, line);
     istringstream is8(line);
     for (int i = nPack * iRng + 1; i <= nPack * (iRng + 1); ++i)
-      if (i <= nPts) is8 >> upd[i];
+      if (i <= nPts) is8 >> updSave[i];
   }
+  upd = &updSave[0];
+
+  // Set up derived quantities.
+  initDerived();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up quantities derived from the grid.
+
+void CTEQ6pdf::initDerived() {
 
   // Initialize x grid mapped to x^0.3.
   xvpow[0] = 0.;
@@ -1450,6 +1846,90 @@ void CTEQ6pdf::init(istream& pdfgrid, bool isPdsGrid, Info* infoPtr) {
 
 //--------------------------------------------------------------------------
 
+// Take the grid from its binary image. The grid proper is used directly
+// from the mapped memory, while the rest is copied.
+
+bool CTEQ6pdf::readImage() {
+
+  // Check that the image has the expected blocks.
+  if (!gridImage.open( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "CTEQ6pdf") || gridImage.nBlocks() != 5
+    || gridImage.blockSize(0) != 10 || gridImage.blockSize(1) != 6) {
+    gridImage.close();
+    return false;
+  }
+
+  // Copy the parameters and the x and q grids.
+  const double* scalars = gridImage.block(0);
+  order  = int(scalars[0]);
+  nQuark = int(scalars[1]);
+  nfMx   = int(scalars[2]);
+  mxVal  = int(scalars[3]);
+  nX     = int(scalars[4]);
+  nT     = int(scalars[5]);
+  lambda = scalars[6];
+  qIni   = scalars[7];
+  qMax   = scalars[8];
+  xMin   = scalars[9];
+  if (nT < 0 || nT > 25 || nX < 0 || nX > 201
+    || gridImage.blockSize(2) != nT + 1 || gridImage.blockSize(3) != nX + 1
+    || gridImage.blockSize(4) != (nX + 1) * (nT + 1) * (nfMx + 1 + mxVal) + 1)
+  {
+    gridImage.close();
+    return false;
+  }
+  for (int i = 1; i <= 6; ++i)  mQ[i] = gridImage.block(1)[i - 1];
+  for (int i = 0; i <= nT; ++i) tv[i] = gridImage.block(2)[i];
+  for (int i = 0; i <= nX; ++i) xv[i] = gridImage.block(3)[i];
+
+  // Point to the grid in the image.
+  upd   = gridImage.block(4);
+  initDerived();
+  isSet = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the binary image of the grid, and then use the grid from it
+// instead of from the private array.
+
+bool CTEQ6pdf::writeImage() {
+
+  // Collect the data in blocks.
+  vector<double> scalars(10);
+  scalars[0] = order;
+  scalars[1] = nQuark;
+  scalars[2] = nfMx;
+  scalars[3] = mxVal;
+  scalars[4] = nX;
+  scalars[5] = nT;
+  scalars[6] = lambda;
+  scalars[7] = qIni;
+  scalars[8] = qMax;
+  scalars[9] = xMin;
+  vector<double> mQNow( mQ + 1, mQ + 7);
+  vector<double> tvNow( tv, tv + nT + 1);
+  vector<double> xvNow( xv, xv + nX + 1);
+  vector<const vector<double>*> blocks;
+  blocks.push_back( &scalars);
+  blocks.push_back( &mQNow);
+  blocks.push_back( &tvNow);
+  blocks.push_back( &xvNow);
+  blocks.push_back( &updSave);
+  if (!gridImage.write( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "CTEQ6pdf", blocks)) return false;
+
+  // Switch to the mapped grid and release the private one.
+  upd = gridImage.block(4);
+  vector<double>().swap( updSave);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Update PDF values.
 
 void CTEQ6pdf::xfUpdate(int , double x, double Q2) {
@@ -1657,7 +2137,7 @@ double CTEQ6pdf::parton6(int iParton, double x, double q) {
 // but assuming N=4, and ignoring the error estimation.
 // Suggested by Z. Sullivan.
 
-double CTEQ6pdf::polint4F(double xa[],double ya[],double x) {
+double CTEQ6pdf::polint4F(const double xa[],const double ya[],double x) {
 
   double y, h1, h2, h3, h4, w, den, d1, c1, d2, c2, d3, c3, cd1, cc1,
          cd2, cc2, dd1, dc1;
@@ -3298,6 +3778,21 @@ double CJKL::hadronlikeB(double x, double s, double Q2) {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Lower limit of a denominator PDF in the envelope of a PDF ratio.
+const double LHAGrid1::PDFMINVALUE = 1e-10;
+
+// Extension of the grid below xMin for extrapolation, down to XPADRANGE
+// times xMin, with a spacing DLNXPAD in ln(x) but at most NXPADMAX points.
+// Below it x^b is evaluated.
+const int    LHAGrid1::NXPADMAX    = 200;
+const double LHAGrid1::XPADRANGE   = 1e-6;
+const double LHAGrid1::DLNXPAD     = 0.1;
+
+//--------------------------------------------------------------------------
+
 // Initialize PDF: select data file and open stream.
 
 void LHAGrid1::init(string pdfWord, string xmlPath, Info* infoPtr) {
@@ -3310,7 +3805,7 @@ void LHAGrid1::init(string pdfWord, string xmlPath, Info* infoPtr) {
   pdfStream >> pdfSet;
 
   // Input is file name.
-  string dataFile = "";
+  dataFile = "";
   if ( xmlPath[ xmlPath.length() - 1 ] != '/') xmlPath += "/";
   if (pdfWord[0] == '/') dataFile = pdfWord;
   else if (pdfSet == 0) dataFile = xmlPath + pdfWord;
@@ -3328,6 +3823,9 @@ void LHAGrid1::init(string pdfWord, string xmlPath, Info* infoPtr) {
   else if (pdfSet == 112) dataFile = xmlPath + "GKG18_DPDF_FitA_0000.dat";
   else if (pdfSet == 113) dataFile = xmlPath + "GKG18_DPDF_FitB_0000.dat";
 
+  // Use the binary image of the grid, if it exists and is up to date.
+  if (imageDir != "" && readImage()) return;
+
   // Open files from which grids should be read in.
   ifstream is( dataFile.c_str() );
   if (!is.good()) {
@@ -3340,6 +3838,10 @@ void LHAGrid1::init(string pdfWord, string xmlPath, Info* infoPtr) {
   init( is, infoPtr);
   is.close();
 
+  // Write the image, to be shared by this and later processes.
+  if (imageDir != "" && isSet && !writeImage()) printErr("Warning in "
+    "LHAGrid1::init: could not write binary grid image", infoPtr);
+
 }
 
 //--------------------------------------------------------------------------
@@ -3429,15 +3931,8 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
     getline( is, line);
   }
 
-  // Create array big enough to hold (flavour, x, Q) grid.
-  pdfGrid = new double**[12];
-  for (int iid = 0; iid < 12; ++iid) {
-    pdfGrid[iid] = new double*[nx];
-    for (int ix = 0; ix < nx; ++ix) {
-      pdfGrid[iid][ix] = new double[nq];
-      for (int iq = 0; iq < nq; ++iq) pdfGrid[iid][ix][iq] = 0.;
-    }
-  }
+  // Create array big enough to hold (Q, x, flavour) grid.
+  pdfGrid.assign( nq * nx * NFLAV, 0.);
 
   // Second pass through the Q subranges.
   int iln = -1;
@@ -3463,19 +3958,150 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
       istringstream ispdf( pdflines[++iln] );
       for (int iid = 0; iid < nid; ++iid) {
         ispdf >> pdfNow;
-        if (idGridMap[iid] >= 0) pdfGrid[idGridMap[iid]][ix][iq] = pdfNow;
+        if (idGridMap[iid] >= 0)
+          pdfGrid[(iq * nx + ix) * NFLAV + idGridMap[iid]] = pdfNow;
       }
     }
   }
 
   // For extrapolation to small x: create array for b values of x^b shape.
-  pdfSlope = new double*[12];
-  for (int iid = 0; iid < 12; ++iid) {
-    pdfSlope[iid] = new double[nq];
-    for (int iq = 0; iq < nq; ++iq) { pdfSlope[iid][iq] =
-      ( min( pdfGrid[iid][0][iq], pdfGrid[iid][1][iq]) > 1e-5)
-      ? ( log(pdfGrid[iid][1][iq]) - log(pdfGrid[iid][0][iq]) )
-      / (lnxGrid[1] - lnxGrid[0]) : 0.;
+  pdfSlope.assign( nq * NFLAV, 0.);
+  for (int iq = 0; iq < nq; ++iq)
+  for (int iid = 0; iid < NFLAV; ++iid) {
+    double pdf0 = pdfGrid[(iq * nx) * NFLAV + iid];
+    double pdf1 = pdfGrid[(iq * nx + 1) * NFLAV + iid];
+    pdfSlope[iq * NFLAV + iid] = ( min( pdf0, pdf1) > 1e-5)
+      ? ( log(pdf1) - log(pdf0) ) / (lnxGrid[1] - lnxGrid[0]) : 0.;
+  }
+
+  // The interpolation weight denominators only depend on the grids.
+  setWeightDenominators( lnxGrid, wxDen);
+  setWeightDenominators( lnqGrid, wqDen);
+  gridPtr  = &pdfGrid[0];
+  slopePtr = &pdfSlope[0];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Take the grid from its binary image. The grid itself is used directly
+// from the mapped memory, while the small arrays are copied.
+
+bool LHAGrid1::readImage() {
+
+  // Check that the image has the expected blocks.
+  if (!gridImage.open( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "LHAGrid1") || gridImage.nBlocks() != 11
+    || gridImage.blockSize(0) != 7) {
+    gridImage.close();
+    return false;
+  }
+  const double* scalars = gridImage.block(0);
+  nx    = int(scalars[0]);
+  nq    = int(scalars[1]);
+  nqSub = int(scalars[2]);
+  if (gridImage.blockSize(9) != nq * nx * NFLAV
+    || gridImage.blockSize(10) != nq * NFLAV) {
+    gridImage.close();
+    return false;
+  }
+
+  // Copy the small arrays.
+  xMin = scalars[3];
+  xMax = scalars[4];
+  qMin = scalars[5];
+  qMax = scalars[6];
+  const double* nqSumNow = gridImage.block(1);
+  nqSum.assign( nqSumNow, nqSumNow + gridImage.blockSize(1));
+  vector<double>* arrays[] = { &xGrid, &lnxGrid, &qGrid, &lnqGrid, &qDiv,
+    &wxDen, &wqDen};
+  for (int iArr = 0; iArr < 7; ++iArr) {
+    const double* blockNow = gridImage.block(iArr + 2);
+    arrays[iArr]->assign( blockNow, blockNow + gridImage.blockSize(iArr + 2));
+  }
+
+  // Point to the grid in the image.
+  gridPtr  = gridImage.block(9);
+  slopePtr = gridImage.block(10);
+  isSet    = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the binary image of the grid, and then use the grid from it
+// instead of from the private arrays.
+
+bool LHAGrid1::writeImage() {
+
+  // Collect the data in blocks.
+  vector<double> scalars(7);
+  scalars[0] = nx;
+  scalars[1] = nq;
+  scalars[2] = nqSub;
+  scalars[3] = xMin;
+  scalars[4] = xMax;
+  scalars[5] = qMin;
+  scalars[6] = qMax;
+  vector<double> nqSumNow( nqSum.begin(), nqSum.end());
+  vector<const vector<double>*> blocks;
+  blocks.push_back( &scalars);
+  blocks.push_back( &nqSumNow);
+  blocks.push_back( &xGrid);
+  blocks.push_back( &lnxGrid);
+  blocks.push_back( &qGrid);
+  blocks.push_back( &lnqGrid);
+  blocks.push_back( &qDiv);
+  blocks.push_back( &wxDen);
+  blocks.push_back( &wqDen);
+  blocks.push_back( &pdfGrid);
+  blocks.push_back( &pdfSlope);
+  if (!gridImage.write( PDFGridImage::imageFile( dataFile, imageDir),
+    dataFile, "LHAGrid1", blocks)) return false;
+
+  // Switch to the mapped grid and release the private one.
+  gridPtr  = gridImage.block(9);
+  slopePtr = gridImage.block(10);
+  vector<double>().swap( pdfGrid);
+  vector<double>().swap( pdfSlope);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Extend the grid below xMin with points uniform in ln(x), filled with
+// the x^b tails of the small-x slopes. Then the extrapolation is a normal
+// interpolation in this grid, without any x^b evaluation, except far
+// below xMin.
+
+void LHAGrid1::initPadding() {
+
+  // The x weights depend on whether extrapolation is used.
+  xWtSav = -1.;
+  xSav   = -1.;
+  resetCache();
+  nxPad  = 0;
+  vector<double>().swap( padGrid);
+  if (!isSet || !doExtraPol) return;
+
+  // Number and spacing of points, with the last one at xMin.
+  double lnRange = -log(XPADRANGE);
+  nxPad     = min( NXPADMAX, 2 + int(lnRange / DLNXPAD));
+  dlnxPad   = lnRange / (nxPad - 1);
+  lnxPadMin = lnxGrid[0] - lnRange;
+
+  // Fill in the power-law tails.
+  padGrid.resize( nq * nxPad * NFLAV);
+  for (int iq = 0; iq < nq; ++iq) {
+    const double* pdfNow   = &gridPtr[iq * nx * NFLAV];
+    const double* slopeNow = &slopePtr[iq * NFLAV];
+    for (int ix = 0; ix < nxPad; ++ix) {
+      double lnxRatio = (ix - nxPad + 1) * dlnxPad;
+      double* padNow  = &padGrid[(iq * nxPad + ix) * NFLAV];
+      for (int iid = 0; iid < NFLAV; ++iid)
+        padNow[iid] = pdfNow[iid] * exp( slopeNow[iid] * lnxRatio);
     }
   }
 
@@ -3483,6 +4109,27 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
 
 //--------------------------------------------------------------------------
 
+// Inverse denominators of the cubic Lagrange interpolation weights, for
+// each set of four consecutive grid points. Zero where two points agree,
+// as at a border between Q subgrids, since such sets are never used.
+
+void LHAGrid1::setWeightDenominators(const vector<double>& lnGrid,
+  vector<double>& wDen) {
+
+  int nGrid = lnGrid.size();
+  wDen.assign( 4 * max( 0, nGrid - 3), 0.);
+  for (int m3 = 0; m3 < nGrid - 3; ++m3)
+  for (int i3 = 0; i3 < 4; ++i3) {
+    double den = 1.;
+    for (int j = 0; j < 4; ++j) if (j != i3)
+      den *= lnGrid[m3+i3] - lnGrid[m3+j];
+    if (den != 0.) wDen[4 * m3 + i3] = 1. / den;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 void LHAGrid1::xfUpdate(int , double x, double Q2) {
 
   // No PDF values if not properly set up.
@@ -3522,10 +4169,60 @@ void LHAGrid1::xfUpdate(int , double x, double Q2) {
 
 void LHAGrid1::xfxevolve(double x, double Q2) {
 
-  // Find if (x, Q) inside our outside grid.
-  double q = sqrt(Q2);
+  // The x and q interpolations only depend on x and Q2, respectively,
+  // so are kept while unchanged, e.g. for several x values at one scale.
+  if (x != xWtSav) setXWeights( x);
+  if (Q2 != Q2WtSav) setQ2Weights( Q2);
+  int    inx = inxSav;
+  int    m3x = m3xSav;
+  int    n3q = n3qSav;
+  int    m3q = m3qSav;
+  const double* wx = wxSav;
+  const double* wq = wqSav;
+
+  // Interpolate between grid elements, normally bicubic, or simpler in ln(q).
+  // The four x points of a q row are adjacent in memory, and the innermost
+  // loop runs over flavours, so that all flavours are obtained in one
+  // vectorizable pass. Sum in a local array, which cannot alias the grid.
+  // The extension of the grid to small x is interpolated in the same way.
+  for (int iid = 0; iid < NFLAV; ++iid) pdfVal[iid] = 0.;
+  if (inx == 0 || inx == -1) {
+    const double* gridNow = (inx == 0) ? gridPtr : &padGrid[0];
+    int nxNow = (inx == 0) ? nx : nxPad;
+    double valNow[NFLAV] = {};
+    for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* pdfNow = &gridNow[((m3q + i3q) * nxNow + m3x) * NFLAV];
+      double w0 = wq[i3q] * wx[0];
+      double w1 = wq[i3q] * wx[1];
+      double w2 = wq[i3q] * wx[2];
+      double w3 = wq[i3q] * wx[3];
+      for (int iid = 0; iid < NFLAV; ++iid) valNow[iid]
+        += w0 * pdfNow[iid] + w1 * pdfNow[NFLAV + iid]
+        + w2 * pdfNow[2 * NFLAV + iid] + w3 * pdfNow[3 * NFLAV + iid];
+    }
+    for (int iid = 0; iid < NFLAV; ++iid) pdfVal[iid] = valNow[iid];
+
+  // Special: extrapolate to x below the extension of the grid.
+  // (Let vanish at large x, so no such code.)
+  } else if (inx == -2) {
+    for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* pdfNow   = &gridPtr[(m3q + i3q) * nx * NFLAV];
+      const double* slopeNow = &slopePtr[(m3q + i3q) * NFLAV];
+      for (int iid = 0; iid < NFLAV; ++iid)
+        pdfVal[iid] += wq[i3q] * pdfNow[iid] * pow( x / xMin, slopeNow[iid]);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the x grid position and the weights for interpolation in x.
+
+void LHAGrid1::setXWeights(double x) {
+
+  // Find if x inside our outside grid.
   int inx  = (x <= xMin) ? -1 : ((x >= xMax) ? 1 : 0);
-  int inq  = (q <= qMin) ? -1 : ((q >= qMax) ? 1 : 0);
 
   // Set up default for x interpolation.
   int    minx  = 0;
@@ -3547,11 +4244,46 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
     if      (minx == 0)      m3x = 0;
     else if (maxx == nx - 1) m3x = nx - 4;
     else                     m3x = minx - 1;
-    for (int i3 = 0; i3 < 4; ++i3)
-    for (int j = 0; j < 4; ++j) if (j != i3)
-      wx[i3] *= (lnx - lnxGrid[m3x+j]) / (lnxGrid[m3x+i3] - lnxGrid[m3x+j]);
+    cubicWeights( lnx, &lnxGrid[m3x], &wxDen[4 * m3x], wx);
+
+  // Below the grid: freeze at xMin, i.e. use the first grid point only.
+  } else if (inx == -1 && nxPad == 0) {
+    inx   = (doExtraPol) ? -2 : 0;
+    wx[1] = wx[2] = wx[3] = 0.;
+
+  // Or use the extension of the grid, with uniform spacing in ln(x),
+  // unless x is below it.
+  } else if (inx == -1) {
+    double px = (log(x) - lnxPadMin) / dlnxPad;
+    if (px < 0.) inx = -2;
+    else {
+      m3x = min( max( int(px) - 1, 0), nxPad - 4);
+      px -= m3x;
+      wx[0] = -(px - 1.) * (px - 2.) * (px - 3.) / 6.;
+      wx[1] = px * (px - 2.) * (px - 3.) / 2.;
+      wx[2] = -px * (px - 1.) * (px - 3.) / 2.;
+      wx[3] = px * (px - 1.) * (px - 2.) / 6.;
+    }
   }
 
+  // Save for later calls.
+  xWtSav = x;
+  inxSav = inx;
+  m3xSav = m3x;
+  for (int i = 0; i < 4; ++i) wxSav[i] = wx[i];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the q subgrid and the weights for interpolation in q.
+
+void LHAGrid1::setQ2Weights(double Q2) {
+
+  // Find if q inside our outside grid.
+  double q = sqrt(Q2);
+  int inq  = (q <= qMin) ? -1 : ((q >= qMax) ? 1 : 0);
+
   // Find q subgrid and set up default for q interpolation.
   int    iqDiv = 0;
   for (int iqSub = 1; iqSub < nqSub; ++iqSub)
@@ -3561,7 +4293,7 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
   int    minq  = minS;
   int    maxq  = maxS;
   int    n3q   = 4;
-  int    m3q   = 0.;
+  int    m3q   = 0;
   double wq[4] = {1., 1., 1., 1.};
 
   // Find grid value on either side of q.
@@ -3584,9 +4316,7 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
       if      (minq == minS) m3q = minS;
       else if (maxq == maxS) m3q = maxS - 3;
       else                   m3q = minq - 1;
-      for (int i3 = 0; i3 < 4; ++i3)
-      for (int j = 0; j < 4; ++j) if (j != i3)
-        wq[i3] *= (lnq - lnqGrid[m3q+j]) / (lnqGrid[m3q+i3] - lnqGrid[m3q+j]);
+      cubicWeights( lnq, &lnqGrid[m3q], &wqDen[4 * m3q], wq);
     }
 
   // Freeze at border of q range.
@@ -3595,21 +4325,309 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
     if (inq == 1) m3q = nq - 1;
   }
 
-  // Interpolate between grid elements, normally bicubic, or simpler in ln(q).
-  for (int iid = 0; iid < 12; ++iid) pdfVal[iid] = 0.;
-  if (inx == 0) {
-    for (int iid = 0; iid < 12; ++iid)
-    for (int i3x = 0; i3x < 4; ++i3x)
-    for (int i3q = 0; i3q < n3q; ++i3q)
-      pdfVal[iid] += wx[i3x] * wq[i3q] * pdfGrid[iid][m3x+i3x][m3q+i3q];
+  // Save for later calls.
+  Q2WtSav = Q2;
+  n3qSav  = n3q;
+  m3qSav  = m3q;
+  for (int i3q = 0; i3q < 4; ++i3q) wqSav[i3q] = wq[i3q];
 
-  // Special: extrapolate to small x. (Let vanish at large x, so no such code.)
-  } else if (inx == -1) {
-    for (int iid = 0; iid < 12; ++iid)
-    for (int i3q = 0; i3q < n3q; ++i3q)
-      pdfVal[iid] += wq[i3q] * pdfGrid[iid][0][m3q+i3q]
-        * (doExtraPol ? pow( x / xMin, pdfSlope[iid][m3q+i3q]) : 1.);
+}
+
+//--------------------------------------------------------------------------
+
+// Read in the other members of the set, from the files named as the
+// current one but with the member number instead of 0000, and store all
+// of them, including the current one, in the common member grid. The
+// error type, number of members and confidence level are read from the
+// .info file of the set, when available.
+
+bool LHAGrid1::initMembers(Info* infoPtr) {
+
+  // Find the stem of the file names, common to all members.
+  nMem = 1;
+  int nChar = dataFile.length();
+  if (!isSet || nChar < 9 || dataFile.substr(nChar - 9) != "_0000.dat") {
+    printErr("Error in LHAGrid1::initMembers: cannot identify the members"
+      " of the set", infoPtr);
+    return false;
   }
+  string stem = dataFile.substr(0, nChar - 8);
+
+  // Read error type, number of members and confidence level, if known.
+  int    nMemInfo  = 0;
+  double confLevel = 68.268949;
+  errorType = "replicas";
+  ifstream isInfo( (stem.substr(0, stem.length() - 1) + ".info").c_str() );
+  if (isInfo.good()) {
+    string line, key;
+    while (getline( isInfo, line)) {
+      istringstream isLine(line);
+      isLine >> key;
+      if (key == "ErrorType:") isLine >> errorType;
+      else if (key == "NumMembers:") isLine >> nMemInfo;
+      else if (key == "ErrorConfLevel:") isLine >> confLevel;
+    }
+  } else printErr("Warning in LHAGrid1::initMembers: no .info file found;"
+    " assume replicas", infoPtr);
+  errorType = toLower( errorType);
+
+  // Scale factor to one-sigma uncertainties, from the confidence level,
+  // by solving erf(z / sqrt(2)) = confLevel / 100 for z.
+  errorScale = 1.;
+  if (confLevel > 0. && confLevel < 100. && abs(confLevel - 68.268949) > 1e-3)
+  {
+    double z = 1.;
+    for (int iter = 0; iter < 20; ++iter) z -= (erf( z / sqrt(2.))
+      - 0.01 * confLevel) / (sqrt(2. / M_PI) * exp(-0.5 * z * z));
+    errorScale = 1. / z;
+  }
+
+  // Read in the members, each in a temporary object of its own.
+  vector<LHAGrid1*> memPtrs;
+  memPtrs.push_back(this);
+  for (int iMem = 1; nMemInfo == 0 || iMem < nMemInfo; ++iMem) {
+    ostringstream memNum;
+    memNum << 10000 + iMem;
+    string memFile = stem + memNum.str().substr(1) + ".dat";
+    ifstream is( memFile.c_str() );
+    if (!is.good()) break;
+    LHAGrid1* memPtr = new LHAGrid1( idBeam, is, infoPtr);
+    memPtrs.push_back(memPtr);
+
+    // The members must share the grid, to share the interpolation weights.
+    if (!memPtr->isSet || memPtr->xGrid != xGrid || memPtr->qGrid != qGrid
+      || memPtr->nqSum != nqSum) {
+      printErr("Error in LHAGrid1::initMembers: members do not have the"
+        " same grid", infoPtr);
+      for (int i = 1; i < int(memPtrs.size()); ++i) delete memPtrs[i];
+      return false;
+    }
+  }
+  if (nMemInfo > 0 && int(memPtrs.size()) != nMemInfo) printErr("Warning in"
+    " LHAGrid1::initMembers: did not find all members of the set", infoPtr);
+
+  // Copy grids and small-x slopes into the common member arrays.
+  nMem = memPtrs.size();
+  int nGrid  = nq * nx * NFLAV;
+  int nSlope = nq * NFLAV;
+  memGrid.resize( nGrid * nMem);
+  memSlope.resize( nSlope * nMem);
+  for (int iMem = 0; iMem < nMem; ++iMem) {
+    for (int i = 0; i < nGrid; ++i)
+      memGrid[i * nMem + iMem] = memPtrs[iMem]->gridPtr[i];
+    for (int i = 0; i < nSlope; ++i)
+      memSlope[i * nMem + iMem] = memPtrs[iMem]->slopePtr[i];
+    if (iMem > 0) delete memPtrs[iMem];
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Parton density of flavour id for all members at once. The flavour is
+// mapped to the grid as in xfUpdate and PDF::xf, for nucleon beams.
+
+void LHAGrid1::xfMembers(int id, double x, double Q2, double* xfOut) {
+
+  // The weights are shared by all members and flavours.
+  if (int(memTmp.size()) != nMem) {
+    memVal.resize( nMem);
+    memTmp.resize( nMem);
+  }
+  if (x != xWtSav) setXWeights( x);
+  if (Q2 != Q2WtSav) setQ2Weights( Q2);
+
+  // Find grid flavour(s), with c and b averaged over quark and antiquark.
+  int idNow = (idBeam > 0) ? id : -id;
+  int idAbs = abs(id);
+  if (idBeamAbs == 2112 && (idAbs == 1 || idAbs == 2))
+    idNow = (idNow > 0) ? 3 - idNow : -3 - idNow;
+  int iid1 = -1;
+  int iid2 = -1;
+  if (idNow == 0 || idAbs == 21)     iid1 = 0;
+  else if (idAbs == 4 || idAbs == 5) {iid1 = idAbs; iid2 = idAbs + 5;}
+  else if (idNow > 0 && idNow < 4)   iid1 = idNow;
+  else if (idNow < 0 && idNow > -4)  iid1 = 5 - idNow;
+  else if (idAbs == 22)              iid1 = NFLAV - 1;
+
+  // Interpolate, and do not allow negative values.
+  if (iid1 < 0 || !isSet) {
+    for (int iMem = 0; iMem < nMem; ++iMem) xfOut[iMem] = 0.;
+    return;
+  }
+  xfMembersGrid( x, iid1, xfOut);
+  if (iid2 >= 0) {
+    xfMembersGrid( x, iid2, &memTmp[0]);
+    for (int iMem = 0; iMem < nMem; ++iMem)
+      xfOut[iMem] = 0.5 * (xfOut[iMem] + memTmp[iMem]);
+  }
+  for (int iMem = 0; iMem < nMem; ++iMem) xfOut[iMem] = max( 0., xfOut[iMem]);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Interpolate grid flavour iid for all members, with the stored weights,
+// summed in the same order as in xfxevolve. The innermost loop runs over
+// the members, which are adjacent in memory.
+
+void LHAGrid1::xfMembersGrid(double x, int iid, double* valOut) {
+
+  // Central member only, unless others loaded.
+  if (nMem == 1) {
+    xfxevolve( x, Q2WtSav);
+    valOut[0] = pdfVal[iid];
+    return;
+  }
+  for (int iMem = 0; iMem < nMem; ++iMem) valOut[iMem] = 0.;
+  int n3q = n3qSav;
+  int m3q = m3qSav;
+  const double* wq = wqSav;
+
+  // Interpolate between grid elements, normally bicubic.
+  if (inxSav == 0) {
+    int iStep = NFLAV * nMem;
+    for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* memNow
+        = &memGrid[(((m3q + i3q) * nx + m3xSav) * NFLAV + iid) * nMem];
+      double w0 = wq[i3q] * wxSav[0];
+      double w1 = wq[i3q] * wxSav[1];
+      double w2 = wq[i3q] * wxSav[2];
+      double w3 = wq[i3q] * wxSav[3];
+      for (int iMem = 0; iMem < nMem; ++iMem) valOut[iMem]
+        += w0 * memNow[iMem] + w1 * memNow[iStep + iMem]
+        + w2 * memNow[2 * iStep + iMem] + w3 * memNow[3 * iStep + iMem];
+    }
+
+  // Special: extrapolate to small x. (Members have no grid extension.)
+  } else if (inxSav < 0) {
+    for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* memNow = &memGrid[((m3q + i3q) * nx * NFLAV + iid) * nMem];
+      const double* slopeNow = &memSlope[((m3q + i3q) * NFLAV + iid) * nMem];
+      for (int iMem = 0; iMem < nMem; ++iMem)
+        valOut[iMem] += wq[i3q] * memNow[iMem]
+          * (doExtraPol ? pow( x / xMin, slopeNow[iMem]) : 1.);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate uncertainties for one flavour, as in LHAPDF6::calcPDFEnvelope.
+
+void LHAGrid1::calcPDFEnvelope(int idNow, double xNow, double Q2Now,
+  int valSea) {
+
+  // Values for all members, possibly only valence or sea part.
+  vector<double> xfCalc(nMem);
+  bool isVal = (idNow == 1 || idNow == 2);
+  xfMembers( (valSea == 2 && isVal) ? -idNow : idNow, xNow, Q2Now,
+    &xfCalc[0]);
+  if (valSea == 1 && isVal) {
+    xfMembers( -idNow, xNow, Q2Now, &memVal[0]);
+    for (int iMem = 0; iMem < nMem; ++iMem) xfCalc[iMem] -= memVal[iMem];
+  }
+
+  // Calculate the uncertainty.
+  pdfEnvelope.pdfMemberVars = xfCalc;
+  setEnvelope( xfCalc);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate uncertainties for a ratio of two flavours and x values,
+// as in LHAPDF6::calcPDFEnvelope.
+
+void LHAGrid1::calcPDFEnvelope(pair<int,int> idNows,
+  pair<double,double> xNows, double Q2Now, int valSea) {
+
+  // Numerator for all members, possibly only valence or sea part.
+  vector<double> xfCalc(nMem);
+  int  id1    = idNows.first;
+  bool isVal1 = (id1 == 1 || id1 == 2);
+  xfMembers( (valSea == 2 && isVal1) ? -id1 : id1, xNows.first, Q2Now,
+    &xfCalc[0]);
+  if (valSea == 1 && isVal1) {
+    xfMembers( -id1, xNows.first, Q2Now, &memVal[0]);
+    for (int iMem = 0; iMem < nMem; ++iMem) xfCalc[iMem] -= memVal[iMem];
+  }
+  for (int iMem = 0; iMem < nMem; ++iMem)
+    xfCalc[iMem] = max( 0., xfCalc[iMem]);
+
+  // Divide by the denominator, evaluated at the same Q2.
+  int  id2    = idNows.second;
+  bool isVal2 = (id2 == 1 || id2 == 2);
+  vector<double> xfDen(nMem);
+  xfMembers( (valSea == 2 && isVal2) ? -id2 : id2, xNows.second, Q2Now,
+    &xfDen[0]);
+  if (valSea == 1 && isVal2) {
+    xfMembers( -id2, xNows.second, Q2Now, &memVal[0]);
+    for (int iMem = 0; iMem < nMem; ++iMem) xfDen[iMem] -= memVal[iMem];
+  }
+  for (int iMem = 0; iMem < nMem; ++iMem)
+    xfCalc[iMem] /= max( PDFMINVALUE, xfDen[iMem]);
+
+  // Calculate the uncertainty.
+  pdfEnvelope.pdfMemberVars = xfCalc;
+  setEnvelope( xfCalc);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Central value and uncertainties from the values of all members, with
+// the LHAPDF6 prescriptions for replicas and (symmetric) Hessian sets.
+
+void LHAGrid1::setEnvelope(const vector<double>& val) {
+
+  // Default is the central member without uncertainty.
+  int nErr = int(val.size()) - 1;
+  double central = val[0];
+  double errPlus = 0.;
+  double errMinus = 0.;
+  double errSymm = 0.;
+
+  // Replicas: average and standard deviation.
+  if (errorType == "replicas" && nErr > 1) {
+    double sum = 0.;
+    double sum2 = 0.;
+    for (int iMem = 1; iMem <= nErr; ++iMem) {
+      sum  += val[iMem];
+      sum2 += pow2(val[iMem]);
+    }
+    central = sum / nErr;
+    double var = (sum2 / nErr - pow2(central)) * nErr / (nErr - 1.);
+    errSymm = errPlus = errMinus = sqrtpos(var);
+
+  // Symmetric Hessian: quadratic sum of deviations.
+  } else if (errorType == "symmhessian") {
+    for (int iMem = 1; iMem <= nErr; ++iMem)
+      errSymm += pow2(val[iMem] - val[0]);
+    errSymm = errPlus = errMinus = sqrt(errSymm);
+
+  // Asymmetric Hessian: members in pairs along each eigenvector.
+  } else if (errorType == "hessian") {
+    for (int iEig = 1; iEig <= nErr / 2; ++iEig) {
+      double dUp = val[2 * iEig - 1] - val[0];
+      double dDn = val[2 * iEig] - val[0];
+      errPlus  += pow2( max( max( dUp, dDn), 0.));
+      errMinus += pow2( max( max( -dUp, -dDn), 0.));
+      errSymm  += pow2( dUp - dDn);
+    }
+    errPlus  = sqrt(errPlus);
+    errMinus = sqrt(errMinus);
+    errSymm  = 0.5 * sqrt(errSymm);
+  }
+
+  // Store, scaled to one-sigma uncertainties.
+  pdfEnvelope.centralPDF  = central;
+  pdfEnvelope.errplusPDF  = errorScale * errPlus;
+  pdfEnvelope.errminusPDF = errorScale * errMinus;
+  pdfEnvelope.errsymmPDF  = errorScale * errSymm;
+  pdfEnvelope.scalePDF    = errorScale;
 
 }
 
@@ -3871,6 +4889,29 @@ double EPAexternal::xfGamma(int id, double x, double Q2) {
 
 // Inherited class for nuclear PDFs. Needs a proton PDF as a baseline.
 
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Number of x and Q2 points of the table of nuclear PDFs.
+const int    nPDF::NXTAB    = 200;
+const int    nPDF::NQ2TAB   = 200;
+
+// Range of the table; outside it the PDFs are calculated directly.
+const double nPDF::XMINTAB  = 1e-7;
+const double nPDF::Q2MINTAB = 1.;
+const double nPDF::Q2MAXTAB = 1e8;
+
+// Allowed relative deviation of the interpolation at the check points of
+// a cell, and lower limit of the densities it is taken relative to.
+const double nPDF::TOLTAB   = 1e-3;
+const double nPDF::XFMINTAB = 1e-4;
+
+//--------------------------------------------------------------------------
+
+// Initialize the nPDF-related members.
+
 void nPDF::initNPDF(PDF* protonPDFPtrIn) {
 
   // Derive mass number and number of protons.
@@ -3900,6 +4941,23 @@ void nPDF::initNPDF(PDF* protonPDFPtrIn) {
 
 void nPDF::xfUpdate(int id, double x, double Q2) {
 
+  // Interpolate in the table of nuclear PDFs, if used and inside it.
+  if (doTable) {
+    if (!hasTable) initTable();
+    if (hasTable && xfTable( x, Q2)) return;
+  }
+
+  // Else combine the proton PDF and the nuclear modifications.
+  xfDirect( id, x, Q2);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Combine the proton PDF and the nuclear modifications at a point.
+
+void nPDF::xfDirect(int id, double x, double Q2) {
+
   if (protonPDFPtr == 0) {
     printErr("Error in nPDF: No free proton PDF pointer set.");
     return;
@@ -3933,6 +4991,166 @@ void nPDF::xfUpdate(int id, double x, double Q2) {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Tabulate the nuclear PDFs, with cubic interpolation in x and Q2. Then
+// check the interpolation in the middle of each cell of the grid, and
+// near its four corners.
+// (At the corners themselves, the grid points, the interpolation is
+// exact by construction, so there the check is a quarter cell inside.)
+
+void nPDF::initTable() {
+
+  // Need a proton PDF.
+  hasTable = false;
+  if (protonPDFPtr == 0 || !isSet || !protonPDFPtr->isSetup()) {
+    printErr("Error in nPDF::initTable: no proton PDF to tabulate");
+    return;
+  }
+
+  // The x grid, uniform in u = ln(x) - 2 (1 - x), solved for x by Newton.
+  // Done in quarter steps, to give also the points where checked.
+  uMinTab    = log(XMINTAB) - 2. * (1. - XMINTAB);
+  duTab      = -uMinTab / (NXTAB - 1);
+  lnQ2MinTab = log(Q2MINTAB);
+  dlnQ2Tab   = log(Q2MAXTAB / Q2MINTAB) / (NQ2TAB - 1);
+  vector<double> xTab( 4 * NXTAB - 3, 1.);
+  for (int ix = 0; ix < 4 * NXTAB - 4; ++ix) {
+    double uNow = uMinTab + 0.25 * ix * duTab;
+    double xNow = min( 1., exp(uNow + 2.));
+    for (int iter = 0; iter < 30; ++iter) xNow -= (log(xNow)
+      - 2. * (1. - xNow) - uNow) / (1. / xNow + 2.);
+    xTab[ix] = (ix == 0) ? XMINTAB : xNow;
+  }
+
+  // Fill the table.
+  table.resize( NQ2TAB * NXTAB * NFLTAB);
+  for (int iq = 0; iq < NQ2TAB; ++iq) {
+    double q2Now = (iq == NQ2TAB - 1) ? Q2MAXTAB
+      : exp( lnQ2MinTab + iq * dlnQ2Tab);
+    for (int ix = 0; ix < NXTAB; ++ix) {
+      xfDirect( 0, xTab[4 * ix], q2Now);
+      double* tabNow = &table[(iq * NXTAB + ix) * NFLTAB];
+      tabNow[0] = xg;
+      tabNow[1] = xd;
+      tabNow[2] = xu;
+      tabNow[3] = xdbar;
+      tabNow[4] = xubar;
+      tabNow[5] = xs;
+      tabNow[6] = xsbar;
+      tabNow[7] = xc;
+      tabNow[8] = xb;
+    }
+  }
+
+  // Compare with the direct calculation in the middle of each cell and
+  // a quarter cell in from each corner, in quarter steps of u and ln(Q2).
+  // A cell is rejected as soon as one point fails.
+  static const int IXCHK[5] = { 2, 1, 3, 1, 3};
+  static const int IQCHK[5] = { 2, 1, 1, 3, 3};
+  cellOk.assign( (NQ2TAB - 1) * (NXTAB - 1), true);
+  double tabVal[NFLTAB], dirVal[NFLTAB];
+  for (int iq = 0; iq < NQ2TAB - 1; ++iq) {
+    for (int ix = 0; ix < NXTAB - 1; ++ix) {
+      int iCell = iq * (NXTAB - 1) + ix;
+      for (int iChk = 0; iChk < 5 && cellOk[iCell]; ++iChk) {
+        double xNow  = xTab[4 * ix + IXCHK[iChk]];
+        double q2Now = exp( lnQ2MinTab + (iq + 0.25 * IQCHK[iChk])
+          * dlnQ2Tab);
+        xfTable( xNow, q2Now, false);
+        tabVal[0] = xg;
+        tabVal[1] = xd;
+        tabVal[2] = xu;
+        tabVal[3] = xdbar;
+        tabVal[4] = xubar;
+        tabVal[5] = xs;
+        tabVal[6] = xsbar;
+        tabVal[7] = xc;
+        tabVal[8] = xb;
+        xfDirect( 0, xNow, q2Now);
+        dirVal[0] = xg;
+        dirVal[1] = xd;
+        dirVal[2] = xu;
+        dirVal[3] = xdbar;
+        dirVal[4] = xubar;
+        dirVal[5] = xs;
+        dirVal[6] = xsbar;
+        dirVal[7] = xc;
+        dirVal[8] = xb;
+        for (int iFl = 0; iFl < NFLTAB; ++iFl)
+        if (abs(tabVal[iFl] - dirVal[iFl])
+          > TOLTAB * max( abs(dirVal[iFl]), XFMINTAB))
+          cellOk[iCell] = false;
+      }
+    }
+  }
+  hasTable = true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Interpolate in the table of nuclear PDFs, with four points in u and in
+// ln(Q2). False if outside the table, or in a cell that failed the check.
+
+bool nPDF::xfTable(double x, double Q2, bool checkCell) {
+
+  // Check that inside the table.
+  if (x < XMINTAB || x > 1. || Q2 < Q2MINTAB || Q2 > Q2MAXTAB) return false;
+
+  // Find the cell, and check that it can be used.
+  double px = (log(x) - 2. * (1. - x) - uMinTab) / duTab;
+  double pq = (log(Q2) - lnQ2MinTab) / dlnQ2Tab;
+  int ixCell = min( int(px), NXTAB - 2);
+  int iqCell = min( int(pq), NQ2TAB - 2);
+  if (checkCell && !cellOk[iqCell * (NXTAB - 1) + ixCell]) return false;
+
+  // Lagrange weights in u for the four points starting at ix.
+  int ix = min( max( ixCell - 1, 0), NXTAB - 4);
+  px -= ix;
+  double wx[4];
+  wx[0] = -(px - 1.) * (px - 2.) * (px - 3.) / 6.;
+  wx[1] = px * (px - 2.) * (px - 3.) / 2.;
+  wx[2] = -px * (px - 1.) * (px - 3.) / 2.;
+  wx[3] = px * (px - 1.) * (px - 2.) / 6.;
+
+  // Ditto in ln(Q2).
+  int iq = min( max( iqCell - 1, 0), NQ2TAB - 4);
+  pq -= iq;
+  double wq[4];
+  wq[0] = -(pq - 1.) * (pq - 2.) * (pq - 3.) / 6.;
+  wq[1] = pq * (pq - 2.) * (pq - 3.) / 2.;
+  wq[2] = -pq * (pq - 1.) * (pq - 3.) / 2.;
+  wq[3] = pq * (pq - 1.) * (pq - 2.) / 6.;
+
+  // Interpolate all flavours at once.
+  double val[NFLTAB];
+  for (int iFl = 0; iFl < NFLTAB; ++iFl) val[iFl] = 0.;
+  for (int i3q = 0; i3q < 4; ++i3q)
+  for (int i3x = 0; i3x < 4; ++i3x) {
+    double wNow = wq[i3q] * wx[i3x];
+    const double* tabNow = &table[((iq + i3q) * NXTAB + ix + i3x) * NFLTAB];
+    for (int iFl = 0; iFl < NFLTAB; ++iFl) val[iFl] += wNow * tabNow[iFl];
+  }
+
+  // Transfer to Pythia notation, without negative values.
+  xg     = max( 0., val[0]);
+  xd     = max( 0., val[1]);
+  xu     = max( 0., val[2]);
+  xdbar  = max( 0., val[3]);
+  xubar  = max( 0., val[4]);
+  xs     = max( 0., val[5]);
+  xsbar  = max( 0., val[6]);
+  xc     = max( 0., val[7]);
+  xb     = max( 0., val[8]);
+  xgamma = 0.;
+
+  // idSav = 9 to indicate that all flavours reset.
+  idSav  = 9;
+  return true;
+
+}
+
 //==========================================================================
 
 // Nuclear modifications of the PDFs from EPS09 fit, either LO or NLO.
@@ -660,16 +660,22 @@ bool PartonLevel::next( Event& process, Event& event) {
       if ( hasMergingHooks && doTrial)
         pTgen = max( pTgen, mergingHooksPtr->getShowerStoppingScale() );
 
+      infoPtr->startTiming(Info::TIMEFSR);
       double pTtimes = (doFSRduringProcess)
         ? timesPtr->pTnext( event, pTmaxFSR, pTgen, isFirstTrial, doTrial)
         : -1.;
+      infoPtr->stopTiming(Info::TIMEFSR);
       pTgen = max( pTgen, pTtimes);
       // No MPIs for unresolved photons.
+      infoPtr->startTiming(Info::TIMEMPI);
       double pTmulti = (doMPI && !unresolvedGamma)
         ? multiPtr->pTnext( pTmaxMPI, pTgen, event) : -1.;
+      infoPtr->stopTiming(Info::TIMEMPI);
       pTgen = max( pTgen, pTmulti);
+      infoPtr->startTiming(Info::TIMEISR);
       double pTspace = (doISR)
         ? spacePtr->pTnext( event, pTmaxISR, pTgen, nRad, doTrial) : -1.;
+      infoPtr->stopTiming(Info::TIMEISR);
       double pTnow = max( pTtimes, max( pTmulti, pTspace));
 
       // Update information.
@@ -692,7 +698,10 @@ bool PartonLevel::next( Event& process, Event& event) {
       // Do a multiparton interaction (if allowed).
       if (pTmulti > 0. && pTmulti > pTspace && pTmulti > pTtimes) {
         infoPtr->addCounter(23);
-        if (multiPtr->scatter( event)) {
+        infoPtr->startTiming(Info::TIMEMPI);
+        bool scatterOK = multiPtr->scatter( event);
+        infoPtr->stopTiming(Info::TIMEMPI);
+        if (scatterOK) {
           typeLatest = 1;
           ++nMPI;
           if (canVetoMPIStep && nMPI <= nVetoMPIStep) typeVetoStep = 1;
@@ -725,10 +734,12 @@ bool PartonLevel::next( Event& process, Event& event) {
       // Do an initial-state emission (if allowed).
       else if (pTspace > 0. && pTspace > pTtimes) {
         infoPtr->addCounter(24);
+        infoPtr->startTiming(Info::TIMEISR);
+        bool branchOK = spacePtr->branch( event);
+        infoPtr->stopTiming(Info::TIMEISR);
 
         // If MPIs, construct the gamma->qqbar branching in beamRemnants.
-        if (spacePtr->branch( event)
-            && ( !(nMPI > 1 && spacePtr->wasGamma2qqbar()) ) ) {
+        if (branchOK && ( !(nMPI > 1 && spacePtr->wasGamma2qqbar()) ) ) {
           typeLatest = 2;
           iSysNow = spacePtr->system();
           ++nISR;
@@ -760,7 +771,10 @@ bool PartonLevel::next( Event& process, Event& event) {
       // Do a final-state emission (if allowed).
       else if (pTtimes > 0.) {
         infoPtr->addCounter(25);
-        if (timesPtr->branch( event, true)) {
+        infoPtr->startTiming(Info::TIMEFSR);
+        bool branchOK = timesPtr->branch( event, true);
+        infoPtr->stopTiming(Info::TIMEFSR);
+        if (branchOK) {
           typeLatest = 3;
           iSysNow = timesPtr->system();
           ++nFSRinProc;
@@ -909,7 +923,9 @@ bool PartonLevel::next( Event& process, Event& event) {
       do {
         infoPtr->addCounter(29);
         typeVetoStep = 0;
+        infoPtr->startTiming(Info::TIMEFSR);
         double pTtimes = timesPtr->pTnext( event, pTmax, 0.);
+        infoPtr->stopTiming(Info::TIMEFSR);
         infoPtr->setPTnow( pTtimes);
 
         // Allow a user veto. Only do it once, so remember to change pTveto.
@@ -927,7 +943,10 @@ bool PartonLevel::next( Event& process, Event& event) {
         // Do a final-state emission (if allowed).
         if (pTtimes > 0.) {
           infoPtr->addCounter(30);
-          if (timesPtr->branch( event, true)) {
+          infoPtr->startTiming(Info::TIMEFSR);
+          bool branchOK = timesPtr->branch( event, true);
+          infoPtr->stopTiming(Info::TIMEFSR);
+          if (branchOK) {
             iSysNow = timesPtr->system();
             ++nFSRinProc;
             if (iSysNow == 0) ++nFSRhard;
@@ -982,8 +1001,11 @@ bool PartonLevel::next( Event& process, Event& event) {
     if (earlyResDec) {
       int oldSizeEvt = event.size();
       int oldSizeSys = partonSystemsPtr->sizeSys();
-      if (nBranchMax <= 0 || nBranch < nBranchMax)
+      if (nBranchMax <= 0 || nBranch < nBranchMax) {
+        infoPtr->startTiming(Info::TIMEFSR);
         doVeto = !resonanceShowers( process, event, true);
+        infoPtr->stopTiming(Info::TIMEFSR);
+      }
       // Abort event if vetoed.
       if (doVeto) return false;
 
@@ -1018,8 +1040,11 @@ bool PartonLevel::next( Event& process, Event& event) {
 
     // Add beam remnants, including primordial kT kick and colour tracing.
     if (!doTrial && physical && doRemnants
-      && (!beamHasGamma || gammaModeEvent != 4)
-      && !remnants.add( event, iFirst, doDiffCR)) physical = false;
+      && (!beamHasGamma || gammaModeEvent != 4)) {
+      infoPtr->startTiming(Info::TIMEREMNANTS);
+      if (!remnants.add( event, iFirst, doDiffCR)) physical = false;
+      infoPtr->stopTiming(Info::TIMEREMNANTS);
+    }
 
     // If no problems then done.
     if (physical) break;
@@ -1071,7 +1096,9 @@ bool PartonLevel::next( Event& process, Event& event) {
     Event eventSave = event;
     bool colCorrect = false;
     for (int i = 0; i < 10; ++i) {
+      infoPtr->startTiming(Info::TIMECR);
       colourReconnection.next(event, 0);
+      infoPtr->stopTiming(Info::TIMECR);
       if (junctionSplitting.checkColours(event)) {
         colCorrect = true;
         break;
@@ -1088,8 +1115,11 @@ bool PartonLevel::next( Event& process, Event& event) {
   // Perform showers in resonance decay chains after beams & reconnection.
   int oldSizeEvt = event.size();
   if (!earlyResDec) {
-    if (nBranchMax <= 0 || nBranch < nBranchMax)
+    if (nBranchMax <= 0 || nBranch < nBranchMax) {
+      infoPtr->startTiming(Info::TIMEFSR);
       doVeto = !resonanceShowers( process, event, true);
+      infoPtr->stopTiming(Info::TIMEFSR);
+    }
     // Abort event if vetoed.
     if (doVeto) return false;
 
@@ -1117,7 +1147,9 @@ bool PartonLevel::next( Event& process, Event& event) {
     Event eventSave = event;
     bool colCorrect = false;
     for (int i = 0; i < 10; ++i) {
+      infoPtr->startTiming(Info::TIMECR);
       colourReconnection.next(event, oldSizeEvt);
+      infoPtr->stopTiming(Info::TIMECR);
       if (junctionSplitting.checkColours(event)) {
         colCorrect = true;
         break;
@@ -235,6 +235,11 @@ void PhaseSpace::init(bool isFirst, SigmaProcess* sigmaProcessPtrIn,
   newSigmaMx      = false;
   biasWt          = 1.;
 
+  // No sampling results yet.
+  hasSampling123   = false;
+  isSamplingReused = false;
+  samplingIn.resize(0);
+
 }
 
 //--------------------------------------------------------------------------
@@ -625,6 +630,9 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
   wtZ = 1.;
   int nVar = (is2) ? 3 : 2;
 
+  // Reuse the outcome of an identical earlier initialization, if given.
+  if (reuseSampling123()) return true;
+
   // Initial values, to be modified later.
   tauCoef[0] = 1.;
   yCoef[1]   = 0.5;
@@ -1018,11 +1026,76 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
     << endl;
 
   // Done.
+  hasSampling123 = true;
   return true;
 }
 
 //--------------------------------------------------------------------------
 
+// Store the optimized coefficients and the maximum for 2 -> 1/2/3, as
+// found by setupSampling123(), for the initialization cache.
+
+bool PhaseSpace::getSampling( vector<double>& values) const {
+
+  // Only possible after a successful maximum search.
+  if (!hasSampling123) return false;
+  values.resize(0);
+  values.push_back( nTau);
+  values.push_back( nY);
+  values.push_back( nZ);
+  for (int i = 0; i < 8; ++i) values.push_back( tauCoef[i]);
+  for (int i = 0; i < 8; ++i) values.push_back( yCoef[i]);
+  for (int i = 0; i < 8; ++i) values.push_back( zCoef[i]);
+  values.push_back( sigmaMx);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Reuse coefficients and maximum set by setSampling(), instead of doing
+// the maximum search. Requires same number of coefficients as found now.
+
+bool PhaseSpace::reuseSampling123() {
+
+  // Check that the stored values match the current setup.
+  isSamplingReused = false;
+  if (samplingIn.size() != 28 || int(samplingIn[0]) != nTau
+    || int(samplingIn[1]) != nY || int(samplingIn[2]) != nZ) {
+    samplingIn.resize(0);
+    return false;
+  }
+
+  // Read in coefficients and provide cumulative sum of them.
+  for (int i = 0; i < 8; ++i) {
+    tauCoef[i] = samplingIn[3 + i];
+    yCoef[i]   = samplingIn[11 + i];
+    zCoef[i]   = samplingIn[19 + i];
+  }
+  tauCoefSum[0] = tauCoef[0];
+    yCoefSum[0] =   yCoef[0];
+    zCoefSum[0] =   zCoef[0];
+  for (int i = 1; i < 8; ++ i) {
+    tauCoefSum[i] = tauCoefSum[i - 1] + tauCoef[i];
+      yCoefSum[i] =   yCoefSum[i - 1] +   yCoef[i];
+      zCoefSum[i] =   zCoefSum[i - 1] +   zCoef[i];
+  }
+  tauCoefSum[nTau - 1] = 2.;
+    yCoefSum[nY   - 1] = 2.;
+    zCoefSum[nZ   - 1] = 2.;
+
+  // Maximum, including the increase found in the initial sampling.
+  sigmaMx          = samplingIn[27];
+  sigmaPos         = sigmaMx;
+  hasSampling123   = true;
+  isSamplingReused = true;
+  samplingIn.resize(0);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Select a trial kinematics phase space point.
 // Note: by In is meant the integral over the quantity multiplying
 // coefficient cn. The sum of cn is normalized to unity.
@@ -8,6 +8,9 @@
 
 #include "Pythia8/ProcessContainer.h"
 
+// Reuse of earlier initialization results.
+#include "Pythia8/InitCache.h"
+
 // Internal headers for special processes.
 #include "Pythia8/SigmaCompositeness.h"
 #include "Pythia8/SigmaEW.h"
@@ -182,6 +185,18 @@ bool ProcessContainer::init(bool isFirst, Info* infoPtrIn,
   sigmaProcessPtr->initProc();
   if (!sigmaProcessPtr->initFlux()) return false;
 
+  // Reuse the maximum search of an identical earlier initialization.
+  InitCache* initCachePtr = (isLHA) ? 0 : infoPtr->initCachePtr();
+  string cacheTag;
+  vector<double> cacheValues;
+  if (initCachePtr != 0) {
+    ostringstream osTag;
+    osTag << "ProcessContainer:" << sigmaProcessPtr->code();
+    cacheTag = initCachePtr->tag( osTag.str());
+    if (initCachePtr->get( cacheTag, cacheValues))
+      phaseSpacePtr->setSampling( cacheValues);
+  }
+
   // Find maximum of differential cross section * phasespace.
   bool physical       = phaseSpacePtr->setupSampling();
   sigmaMx             = phaseSpacePtr->sigmaMax();
@@ -191,7 +206,8 @@ bool ProcessContainer::init(bool isFirst, Info* infoPtrIn,
   sigmaSgn            = phaseSpacePtr->sigmaSumSigned();
 
   // Check maximum by a few events, and extrapolate a further increase.
-  if (physical & !isLHA) {
+  // Not needed if the extrapolated maximum was taken from the cache.
+  if (physical && !isLHA && !phaseSpacePtr->samplingReused()) {
     int nSample = (nFin < 3) ? N12SAMPLE : N3SAMPLE;
     for (int iSample = 0; iSample < nSample; ++iSample) {
       bool test = false;
@@ -202,6 +218,10 @@ bool ProcessContainer::init(bool isFirst, Info* infoPtrIn,
     sigmaMx = (sigmaHalfWay > 0.) ? pow2(sigmaFullWay) / sigmaHalfWay
                                   : sigmaFullWay;
     phaseSpacePtr->setSigmaMax(sigmaMx);
+
+    // Store the outcome for later runs.
+    if (initCachePtr != 0 && phaseSpacePtr->getSampling( cacheValues))
+      initCachePtr->put( cacheTag, cacheValues);
   }
 
   // Allow Pythia to overwrite incoming beams or parts of Les Houches input.
@@ -14,6 +14,10 @@
 // Allow string and character manipulation.
 #include <cctype>
 
+// Access file size and modification time, and file renaming and removal.
+#include <sys/stat.h>
+#include <cstdio>
+
 namespace Pythia8 {
 
 //==========================================================================
@@ -37,6 +41,16 @@ const int Pythia::NTRY          = 10;
 // Negative integer to denote that no subrun has been set.
 const int Pythia::SUBRUNDEFAULT = -999;
 
+// Version of the binary database image layout; to be increased when the
+// layout changes.
+const int Pythia::DATABASEFORMAT     = 1;
+
+// Name of the binary database image in the xmldoc directory.
+const string Pythia::DATABASEFILE   = "Pythia8Database.bin";
+
+// Identifying header at the beginning of a binary database image.
+const string Pythia::DATABASEHEADER = "PYTHIA8DATABASE";
+
 //--------------------------------------------------------------------------
 
 // Constructor.
@@ -64,10 +78,17 @@ Pythia::Pythia(string xmlDir, bool printBanner) {
   }
   if (xmlPath[ xmlPath.length() - 1 ] != '/') xmlPath += "/";
 
-  // Read in files with all flags, modes, parms and words.
+  // Read in both databases from a binary image, if it is up to date.
   settings.initPtr( &info);
-  string initFile = xmlPath + "Index.xml";
-  isConstructed = settings.init( initFile);
+  particleData.initPtr( &info, &settings, &rndm, couplingsPtr);
+  bool hasImage = readDatabase( xmlPath + DATABASEFILE);
+
+  // Else read in files with all flags, modes, parms and words.
+  if (hasImage) isConstructed = settings.getIsInit();
+  else {
+    string initFile = xmlPath + "Index.xml";
+    isConstructed = settings.init( initFile);
+  }
   if (!isConstructed) {
     info.errorMsg("Abort from Pythia::Pythia: settings unavailable");
     return;
@@ -79,13 +100,14 @@ Pythia::Pythia(string xmlDir, bool printBanner) {
   // Check that XML and header version numbers match code version number.
   if (!checkVersion()) return;
 
-  // Read in files with all particle data.
-  particleData.initPtr( &info, &settings, &rndm, couplingsPtr);
-  string dataFile = xmlPath + "ParticleData.xml";
-  isConstructed = particleData.init( dataFile);
-  if (!isConstructed) {
-    info.errorMsg("Abort from Pythia::Pythia: particle data unavailable");
-    return;
+  // Else read in files with all particle data.
+  if (!hasImage) {
+    string dataFile = xmlPath + "ParticleData.xml";
+    isConstructed = particleData.init( dataFile);
+    if (!isConstructed) {
+      info.errorMsg("Abort from Pythia::Pythia: particle data unavailable");
+      return;
+    }
   }
 
   // Write the Pythia banner to output.
@@ -189,11 +211,11 @@ Pythia::Pythia( istream& settingsStrings, istream& particleDataStrings,
 
 Pythia::~Pythia() {
 
-  // Delete the PDF's created with new.
-  if (useNewPdfHard && pdfHardAPtr != pdfAPtr) delete pdfHardAPtr;
-  if (useNewPdfHard && pdfHardBPtr != pdfBPtr) delete pdfHardBPtr;
-  if (useNewPdfA) delete pdfAPtr;
-  if (useNewPdfB) delete pdfBPtr;
+  // Delete the PDF's created with new, and finally the shared ones.
+  if (useNewPdfHard && pdfHardAPtr != pdfAPtr) deletePDF(pdfHardAPtr);
+  if (useNewPdfHard && pdfHardBPtr != pdfBPtr) deletePDF(pdfHardBPtr);
+  if (useNewPdfA) deletePDF(pdfAPtr);
+  if (useNewPdfB) deletePDF(pdfBPtr);
   if (useNewPdfPomA) delete pdfPomAPtr;
   if (useNewPdfPomB) delete pdfPomBPtr;
   if (useNewPdfGamA) delete pdfGamAPtr;
@@ -204,6 +226,8 @@ Pythia::~Pythia() {
   if (useNewPdfUnresGamB) delete pdfUnresGamBPtr;
   if (useNewPdfVMDA) delete pdfVMDAPtr;
   if (useNewPdfVMDB) delete pdfVMDBPtr;
+  for (map<string, PDF*>::iterator pdfItr = pdfSharedPtrs.begin();
+    pdfItr != pdfSharedPtrs.end(); ++pdfItr) delete pdfItr->second;
 
   // Delete the Les Houches object created with new.
   if (useNewLHA) delete lhaUpPtr;
@@ -300,6 +324,9 @@ void Pythia::initPtrs() {
   hasOwnMergingHooks = false;
   mergingHooksPtr    = 0;
 
+  // Not inside a timed event generation.
+  isTimingNext       = false;
+
   // Initial value for pointer to HeavyIons objects.
   doHeavyIons        = false;
   hasHeavyIons       = false;
@@ -361,6 +388,141 @@ bool Pythia::checkVersion() {
 
 //--------------------------------------------------------------------------
 
+// Write a binary image of the XML settings and particle databases. The XML
+// files are read afresh, so that any changes made by the user are not
+// included. Each XML file is recorded with its size and modification time.
+
+bool Pythia::writeDatabase(string fileName) {
+
+  // Default location is the xmldoc directory.
+  if (fileName == "") fileName = xmlPath + DATABASEFILE;
+
+  // Read in the XML files.
+  Settings settingsXML;
+  settingsXML.initPtr( &info);
+  ParticleData particleDataXML;
+  particleDataXML.initPtr( &info, &settingsXML, &rndm, couplingsPtr);
+  if (!settingsXML.init( xmlPath + "Index.xml")
+    || !particleDataXML.init( xmlPath + "ParticleData.xml")) {
+    info.errorMsg("Error in Pythia::writeDatabase: "
+      "could not read XML files");
+    return false;
+  }
+  vector<string> files = settingsXML.getXMLFiles();
+  files.push_back( xmlPath + "ParticleData.xml");
+
+  // Open a uniquely named temporary file.
+  ostringstream osTmp;
+  osTmp << fileName << ".tmp" << this;
+  string fileTmp = osTmp.str();
+  ofstream os( fileTmp.c_str(), ios::binary);
+  if (!os.good()) {
+    info.errorMsg("Error in Pythia::writeDatabase: "
+      "could not open file", fileName);
+    return false;
+  }
+
+  // Write header, format and version numbers, and the list of files.
+  os.write( DATABASEHEADER.c_str(), DATABASEHEADER.size());
+  writeBinary( os, DATABASEFORMAT);
+  writeBinary( os, VERSIONNUMBERCODE);
+  writeBinary( os, int(files.size()));
+  for (int i = 0; i < int(files.size()); ++i) {
+    long long size, modTime;
+    fileStamp( files[i], size, modTime);
+    writeBinary( os, files[i].substr( xmlPath.size()));
+    writeBinary( os, size);
+    writeBinary( os, modTime);
+  }
+
+  // Write the two databases.
+  settingsXML.writeBinary( os);
+  particleDataXML.writeBinary( os);
+  os.close();
+
+  // Move file in place.
+  if (!os.good() || rename( fileTmp.c_str(), fileName.c_str()) != 0) {
+    info.errorMsg("Error in Pythia::writeDatabase: "
+      "could not write file", fileName);
+    remove( fileTmp.c_str());
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read the binary image of the databases. It is only used if format and
+// version numbers agree, and if none of the XML files has been changed.
+
+bool Pythia::readDatabase(string fileName) {
+
+  // Missing file is not an error; then the XML files are read.
+  ifstream is( fileName.c_str(), ios::binary);
+  if (!is.good()) return false;
+
+  // Check header, format and version numbers.
+  string header( DATABASEHEADER.size(), ' ');
+  int    formatVersion = 0;
+  double versionNumber = 0.;
+  int    nFiles        = 0;
+  is.read( &header[0], header.size());
+  if (!is.good() || header != DATABASEHEADER
+    || !readBinary( is, formatVersion) || formatVersion != DATABASEFORMAT
+    || !readBinary( is, versionNumber)
+    || abs(versionNumber - VERSIONNUMBERCODE) > 0.0005
+    || !readBinary( is, nFiles)) {
+    info.errorMsg("Warning in Pythia::readDatabase: "
+      "unknown format or version; XML files are read instead", fileName);
+    return false;
+  }
+
+  // Check that the XML files have not been changed.
+  for (int i = 0; i < nFiles; ++i) {
+    string fileNow;
+    long long size, modTime, sizeNow, modTimeNow;
+    if (!readBinary( is, fileNow) || !readBinary( is, size)
+      || !readBinary( is, modTime)
+      || !fileStamp( xmlPath + fileNow, sizeNow, modTimeNow)
+      || sizeNow != size || modTimeNow != modTime) {
+      info.errorMsg("Warning in Pythia::readDatabase: "
+        "image is out of date; XML files are read instead", fileName);
+      return false;
+    }
+  }
+
+  // Read in the two databases.
+  if (!settings.initBinary( is) || !particleData.initBinary( is)) {
+    info.errorMsg("Warning in Pythia::readDatabase: "
+      "image is corrupt; XML files are read instead", fileName);
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Size and modification time of a file, to check that it is unchanged.
+
+bool Pythia::fileStamp(string fileName, long long& size,
+  long long& modTime) {
+
+  struct stat fileStat;
+  if (::stat( fileName.c_str(), &fileStat) != 0) {
+    size    = -1;
+    modTime = -1;
+    return false;
+  }
+  size    = fileStat.st_size;
+  modTime = fileStat.st_mtime;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Read in one update for a setting or particle data from a single line.
 
 bool Pythia::readString(string line, bool warn) {
@@ -463,10 +625,10 @@ bool Pythia::setPDFPtr( PDF* pdfAPtrIn, PDF* pdfBPtrIn, PDF* pdfHardAPtrIn,
   PDF* pdfVMDBPtrIn) {
 
   // Delete any PDF's created in a previous init call.
-  if (useNewPdfHard && pdfHardAPtr != pdfAPtr) delete pdfHardAPtr;
-  if (useNewPdfHard && pdfHardBPtr != pdfBPtr) delete pdfHardBPtr;
-  if (useNewPdfA) delete pdfAPtr;
-  if (useNewPdfB) delete pdfBPtr;
+  if (useNewPdfHard && pdfHardAPtr != pdfAPtr) deletePDF(pdfHardAPtr);
+  if (useNewPdfHard && pdfHardBPtr != pdfBPtr) deletePDF(pdfHardBPtr);
+  if (useNewPdfA) deletePDF(pdfAPtr);
+  if (useNewPdfB) deletePDF(pdfBPtr);
   if (useNewPdfPomA) delete pdfPomAPtr;
   if (useNewPdfPomB) delete pdfPomBPtr;
   if (useNewPdfGamA) delete pdfGamAPtr;
@@ -627,9 +789,16 @@ bool Pythia::init() {
   }
 
   // Initialize the random number generator.
-  if ( settings.flag("Random:setSeed") )
+  if ( settings.flag("Random:counterBased") )
+    rndm.initCounter( settings.flag("Random:setSeed")
+      ? settings.mode("Random:seed") : -1, settings.mode("Random:stream") );
+  else if ( settings.flag("Random:setSeed") )
     rndm.init( settings.mode("Random:seed") );
 
+  // Switch on timing of event generation stages, if requested.
+  info.setTiming( settings.flag("Next:timing") );
+  isTimingNext = false;
+
   // Find which frame type to use.
   info.addCounter(1);
   frameType = mode("Beams:frameType");
@@ -1042,6 +1211,21 @@ bool Pythia::init() {
 
   }
 
+  // Optionally reuse results of an earlier identical initialization.
+  // Not possible when external objects may modify the results.
+  string initCacheFile = settings.word("Init:cacheFile");
+  info.setInitCachePtr(0);
+  if (doProcessLevel && initCacheFile != "void") {
+    if (hasUserHooks || sigmaPtrs.size() > 0 || phaseSpacePtrs.size() > 0
+      || !useNewPdfA || !useNewPdfB) info.errorMsg("Warning in Pythia::init:"
+      " initialization cache not used with external processes, PDFs or"
+      " user hooks");
+    else {
+      initCache.open( initCacheFile, settings, particleData, &info);
+      info.setInitCachePtr( &initCache);
+    }
+  }
+
   // Send info/pointers to process level for initialization.
   if ( doProcessLevel && !processLevel.init( &info, settings, &particleData,
     &rndm, &beamA, &beamB, &beamGamA, &beamGamB, &beamVMDA, &beamVMDB,
@@ -1145,6 +1329,12 @@ bool Pythia::init() {
   reconnectMode      = settings.mode("ColourReconnection:mode");
   forceHadronLevelCR = settings.flag("ColourReconnection:forceHadronLevelCR");
 
+  // Store new results in the initialization cache.
+  if (initCache.isActive()) {
+    initCache.close();
+    info.setInitCachePtr(0);
+  }
+
   // Succeeded.
   isInit = true;
   info.addCounter(2);
@@ -1416,25 +1606,28 @@ bool Pythia::initKinematics() {
 
 bool Pythia::initPDFs() {
 
-  // Delete any PDF's created in a previous init call.
+  // Delete any PDF's created in a previous init call. The shared ones are
+  // kept, to be reused if the same settings are asked for again.
+  pdfCachePtrs.resize(0);
+  pdfSharedUsed.clear();
   if (useNewPdfHard) {
     if (pdfHardAPtr != pdfAPtr) {
-      delete pdfHardAPtr;
+      deletePDF(pdfHardAPtr);
       pdfHardAPtr = 0;
     }
     if (pdfHardBPtr != pdfBPtr) {
-      delete pdfHardBPtr;
+      deletePDF(pdfHardBPtr);
       pdfHardBPtr = 0;
     }
     useNewPdfHard = false;
   }
   if (useNewPdfA) {
-    delete pdfAPtr;
+    deletePDF(pdfAPtr);
     useNewPdfA    = false;
     pdfAPtr       = 0;
   }
   if (useNewPdfB) {
-    delete pdfBPtr;
+    deletePDF(pdfBPtr);
     useNewPdfB    = false;
     pdfBPtr       = 0;
   }
@@ -1547,9 +1740,9 @@ bool Pythia::initPDFs() {
     }
   }
 
-  // Set up the PDF's, if not already done.
+  // Set up the PDF's, if not already done. Identical ones are shared.
   if (pdfAPtr == 0) {
-    pdfAPtr     = getPDFPtr(idA);
+    pdfAPtr     = getSharedPDFPtr(idA);
     if (pdfAPtr == 0 || !pdfAPtr->isSetup()) {
       info.errorMsg("Error in Pythia::init: "
         "could not set up PDF for beam A");
@@ -1559,7 +1752,7 @@ bool Pythia::initPDFs() {
     useNewPdfA  = true;
   }
   if (pdfBPtr == 0) {
-    pdfBPtr     = getPDFPtr(idB, 1, "B");
+    pdfBPtr     = getSharedPDFPtr(idB, 1, "B");
     if (pdfBPtr == 0 || !pdfBPtr->isSetup()) {
       info.errorMsg("Error in Pythia::init: "
         "could not set up PDF for beam B");
@@ -1571,9 +1764,9 @@ bool Pythia::initPDFs() {
 
   // Optionally set up separate PDF's for hard process.
   if (settings.flag("PDF:useHard") && useNewPdfA && useNewPdfB) {
-    pdfHardAPtr = getPDFPtr(idA, 2);
+    pdfHardAPtr = getSharedPDFPtr(idA, 2);
     if (!pdfHardAPtr->isSetup()) return false;
-    pdfHardBPtr = getPDFPtr(idB, 2, "B");
+    pdfHardBPtr = getSharedPDFPtr(idB, 2, "B");
     if (!pdfHardBPtr->isSetup()) return false;
     useNewPdfHard = true;
   }
@@ -1656,6 +1849,30 @@ bool Pythia::initPDFs() {
     }
   }
 
+  // Switch the (x, Q2) cache of each PDF on or off, and keep a list of
+  // the ones used, so that they can be emptied for each new event.
+  bool usePDFCache = settings.flag("PDF:useCache");
+  PDF* pdfAllPtrs[] = { pdfAPtr, pdfBPtr, pdfHardAPtr, pdfHardBPtr,
+    pdfPomAPtr, pdfPomBPtr, pdfGamAPtr, pdfGamBPtr, pdfHardGamAPtr,
+    pdfHardGamBPtr, pdfUnresAPtr, pdfUnresBPtr, pdfUnresGamAPtr,
+    pdfUnresGamBPtr, pdfVMDAPtr, pdfVMDBPtr};
+  for (int i = 0; i < 16; ++i) if (pdfAllPtrs[i] != 0) {
+    pdfAllPtrs[i]->setCache( usePDFCache);
+    bool isNew = usePDFCache;
+    for (int j = 0; j < int(pdfCachePtrs.size()); ++j)
+      if (pdfCachePtrs[j] == pdfAllPtrs[i]) isNew = false;
+    if (isNew) pdfCachePtrs.push_back( pdfAllPtrs[i]);
+  }
+
+  // Delete shared PDFs left over from a previous init call but not used.
+  map<string, PDF*>::iterator pdfItr = pdfSharedPtrs.begin();
+  while (pdfItr != pdfSharedPtrs.end()) {
+    if (pdfSharedUsed.find(pdfItr->second) == pdfSharedUsed.end()) {
+      delete pdfItr->second;
+      pdfSharedPtrs.erase(pdfItr++);
+    } else ++pdfItr;
+  }
+
   // Done.
   return true;
 
@@ -1680,6 +1897,17 @@ bool Pythia::next() {
     return ok;
   }
 
+  // Time the whole event generation, if requested. The flag allows
+  // next to be called recursively without going into a loop.
+  if ( info.doTiming() && !isTimingNext ) {
+    isTimingNext = true;
+    info.startTiming(Info::TIMENEXT);
+    bool ok = next();
+    info.stopTiming(Info::TIMENEXT);
+    isTimingNext = false;
+    return ok;
+  }
+
   // Regularly print how many events have been generated.
   int nPrevious = info.getCounter(3);
   if (nCount > 0 && nPrevious > 0 && nPrevious%nCount == 0)
@@ -1690,6 +1918,9 @@ bool Pythia::next() {
   info.addCounter(3);
   for (int i = 10; i < 13; ++i) info.setCounter(i);
 
+  // Counter-based random numbers are restarted for each event.
+  rndm.nextEvent();
+
   // Simpler option when no hard process, i.e. mainly hadron level.
   if (!doProcessLevel) {
 
@@ -1731,6 +1962,8 @@ bool Pythia::next() {
   beamGamB.clear();
   beamVMDA.clear();
   beamVMDB.clear();
+  for (int i = 0; i < int(pdfCachePtrs.size()); ++i)
+    pdfCachePtrs[i]->resetCache();
 
   // Pick current beam valence flavours (for pi0, K0S, K0L, Pomeron).
   beamA.newValenceContent();
@@ -1771,7 +2004,10 @@ bool Pythia::next() {
     // from LHEF, while the current event is not read from LHEF.
     info.setLHEF3EventInfo();
 
-    if ( !processLevel.next( process) ) {
+    info.startTiming(Info::TIMEPROCESS);
+    bool processOK = processLevel.next( process);
+    info.stopTiming(Info::TIMEPROCESS);
+    if ( !processOK ) {
       if (doLHA && info.atEndOfFile()) info.errorMsg("Abort from "
         "Pythia::next: reached end of Les Houches Events File");
       else info.errorMsg("Abort from Pythia::next: "
@@ -1855,7 +2091,10 @@ bool Pythia::next() {
       partonSystems.clear();
 
       // Parton-level evolution: ISR, FSR, MPI.
-      if ( !partonLevel.next( process, event) ) {
+      info.startTiming(Info::TIMEPARTON);
+      bool partonOK = partonLevel.next( process, event);
+      info.stopTiming(Info::TIMEPARTON);
+      if ( !partonOK ) {
 
         // Abort event generation if parton level is set to abort.
         if (info.getAbortPartonLevel()) return false;
@@ -1920,7 +2159,10 @@ bool Pythia::next() {
 
       // Hadron-level: hadronization, decays.
       info.addCounter(16);
-      if ( !hadronLevel.next( event) ) {
+      info.startTiming(Info::TIMEHADRON);
+      bool hadronOK = hadronLevel.next( event);
+      info.stopTiming(Info::TIMEHADRON);
+      if ( !hadronOK ) {
         info.errorMsg("Error in Pythia::next: "
           "hadronLevel failed; try again");
         physical = false;
@@ -2073,7 +2315,10 @@ bool Pythia::forceHadronLevel(bool findJunctions) {
     }
 
     // Hadron-level: hadronization, decays.
-    if (hadronLevel.next( event)) break;
+    info.startTiming(Info::TIMEHADRON);
+    bool hadronOK = hadronLevel.next( event);
+    info.stopTiming(Info::TIMEHADRON);
+    if (hadronOK) break;
 
     // If failure then warn, restore original configuration and try again.
     info.errorMsg("Error in Pythia::forceHadronLevel: "
@@ -2231,6 +2476,10 @@ void Pythia::stat() {
   if (showErr) info.errorStatistics();
   if (reset)   info.errorReset();
 
+  // Time spent in the stages of event generation, if collected.
+  if (info.doTiming()) info.timingStatistics();
+  if (reset)           info.resetTiming();
+
 }
 
 //--------------------------------------------------------------------------
@@ -2775,16 +3024,19 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
   // Temporary pointer to be returned.
   PDF* tempPDFPtr = 0;
 
+  // Directory of shared binary images of the grids, if used.
+  string imageDir = "";
+  if (settings.flag("PDF:useGridImages")) {
+    imageDir = settings.word("PDF:gridImageDir");
+    if (imageDir == "void") imageDir = xmlPath;
+  }
+
   // One option is to treat a Pomeron like a pi0.
   if (idIn == 990 && settings.word("PDF:PomSet") == "2") idIn = 111;
 
   // Proton beam, normal or hard choice. Also used for neutron.
   if (abs(idIn) == 2212 || abs(idIn) == 2112) {
-    string pWord = settings.word("PDF:p"
-      + string(sequence == 1 ? "" : "Hard") + "Set" + beam);
-    if (pWord == "void" && sequence != 1 && beam == "B")
-      pWord = settings.word("PDF:pHardSet");
-    if (pWord == "void") pWord = settings.word("PDF:pSet");
+    string pWord = pdfSetWord(idIn, sequence, beam);
     istringstream pStream(pWord);
     int pSet = 0;
     pStream >> pSet;
@@ -2792,7 +3044,7 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     // Use internal LHAgrid1 implementation for LHAPDF6 files.
     if (pSet == 0 && pWord.length() > 9
       && toLower(pWord).substr(0,9) == "lhagrid1:")
-      tempPDFPtr = new LHAGrid1(idIn, pWord, xmlPath, &info);
+      tempPDFPtr = new LHAGrid1(idIn, pWord, xmlPath, &info, imageDir);
 
     // Use sets from LHAPDF.
     else if (pSet == 0) tempPDFPtr = new LHAPDF(idIn, pWord, &info);
@@ -2801,20 +3053,25 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     else if (pSet == 1) tempPDFPtr = new GRV94L(idIn);
     else if (pSet == 2) tempPDFPtr = new CTEQ5L(idIn);
     else if (pSet <= 6)
-      tempPDFPtr = new MSTWpdf(idIn, pSet - 2, xmlPath, &info);
+      tempPDFPtr = new MSTWpdf(idIn, pSet - 2, xmlPath, &info, imageDir);
     else if (pSet <= 12)
-      tempPDFPtr = new CTEQ6pdf(idIn, pSet - 6, 1., xmlPath, &info);
+      tempPDFPtr = new CTEQ6pdf(idIn, pSet - 6, 1., xmlPath, &info, imageDir);
     else if (pSet <= 16)
       tempPDFPtr = new NNPDF(idIn, pSet - 12, xmlPath, &info);
     else if (pSet <= 21)
-      tempPDFPtr = new LHAGrid1(idIn, pWord, xmlPath, &info);
+      tempPDFPtr = new LHAGrid1(idIn, pWord, xmlPath, &info, imageDir);
     else tempPDFPtr = 0;
+
+    // Optionally read in all members of an LHAGrid1 set, for uncertainties.
+    if (sequence == 1 && settings.flag("PDF:allMembers")) {
+      LHAGrid1* gridPtr = dynamic_cast<LHAGrid1*>(tempPDFPtr);
+      if (gridPtr != 0 && gridPtr->isSetup()) gridPtr->initMembers(&info);
+    }
   }
 
   // Pion beam (or, in one option, Pomeron beam).
   else if (abs(idIn) == 211 || idIn == 111) {
-    string piWord = settings.word("PDF:piSet" + beam);
-    if (piWord == "void" && beam == "B") piWord = settings.word("PDF:piSet");
+    string piWord = pdfSetWord(idIn, sequence, beam);
     istringstream piStream(piWord);
     int piSet = 0;
     piStream >> piSet;
@@ -2826,7 +3083,7 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     // Use internal LHAgrid1 implementation for LHAPDF6 files.
     if (piSet == 0 && piWord.length() > 9
       && toLower(piWord).substr(0,9) == "lhagrid1:")
-      tempPDFPtr = new LHAGrid1(idIn, piWord, xmlPath, &info);
+      tempPDFPtr = new LHAGrid1(idIn, piWord, xmlPath, &info, imageDir);
 
     // Use sets from LHAPDF.
     else if (piSet == 0) tempPDFPtr = new LHAPDF(idIn, piWord, &info);
@@ -2847,7 +3104,7 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     // Use internal LHAgrid1 implementation for LHAPDF6 files.
     if (pomSet == 0 && pomWord.length() > 9
       && toLower(pomWord).substr(0,9) == "lhagrid1:")
-      tempPDFPtr = new LHAGrid1(idIn, pomWord, xmlPath, &info);
+      tempPDFPtr = new LHAGrid1(idIn, pomWord, xmlPath, &info, imageDir);
 
     // Use sets from LHAPDF.
     else if (pomSet == 0) tempPDFPtr = new LHAPDF(idIn, pomWord, &info);
@@ -2873,7 +3130,8 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
       tempPDFPtr = new PomH1FitAB( 990, 3, rescale, xmlPath, &info);
     // The parametrizations of Alvero, Collins, Terron and Whitmore.
     else if (pomSet > 6 && pomSet < 11)  {
-      tempPDFPtr = new CTEQ6pdf( 990, pomSet + 4, rescale, xmlPath, &info);
+      tempPDFPtr = new CTEQ6pdf( 990, pomSet + 4, rescale, xmlPath, &info,
+        imageDir);
       info.errorMsg("Warning: Pomeron flux parameters forced for ACTW PDFs");
       settings.mode("SigmaDiffractive:PomFlux", 4);
       double pomFluxEps = (pomSet == 10) ? 0.19 : 0.14;
@@ -2883,7 +3141,7 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     else if (pomSet == 11 )
       tempPDFPtr = new PomHISASD(990, getPDFPtr(2212), settings, &info);
     else if (pomSet == 12 || pomSet == 13)
-      tempPDFPtr = new LHAGrid1(idIn, "1" + pomWord, xmlPath, &info);
+      tempPDFPtr = new LHAGrid1(idIn, "1" + pomWord, xmlPath, &info, imageDir);
     else tempPDFPtr = 0;
   }
 
@@ -2902,6 +3160,11 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     else if (nPDFSet == 3) tempPDFPtr = new EPPS16(idIn, 1, xmlPath,
       tempProtonPDFPtr, &info);
     else tempPDFPtr = 0;
+
+    // Optionally tabulate proton PDF and modifications together.
+    if (tempPDFPtr != 0 && tempPDFPtr->isSetup()
+      && settings.flag("PDF:tabulateNPDF"))
+      static_cast<nPDF*>(tempPDFPtr)->setTabulate(true);
   }
 
   // Photon beam, either point-like (unresolved) or resolved.
@@ -3048,6 +3311,86 @@ PDF* Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
   return tempPDFPtr;
 }
 
+//--------------------------------------------------------------------------
+
+// Find a PDF among the shared ones, i.e. ones that have already been set up
+// for the other beam, for the hard process or in a previous init call,
+// with the same settings. Else set up a new one and store it.
+
+PDF* Pythia::getSharedPDFPtr(int idIn, int sequence, string beam) {
+
+  // Only nucleon and charged pion PDFs are shared, since other ones
+  // may change their valence content or other state event by event.
+  if ( !settings.flag("PDF:sharePDFs") || (abs(idIn) != 2212
+    && abs(idIn) != 2112 && abs(idIn) != 211) )
+    return getPDFPtr(idIn, sequence, beam);
+
+  // The key contains the PDF set and all settings that affect it.
+  ostringstream keyStream;
+  keyStream << idIn << " " << pdfSetWord(idIn, sequence, beam) << " "
+    << settings.flag("PDF:extrapolate") << " "
+    << (sequence == 1 && settings.flag("PDF:allMembers")) << " "
+    << (abs(idIn) == 211 && (doVMDsideA || doVMDsideB)) << " "
+    << settings.flag("PDF:useGridImages") << " "
+    << settings.word("PDF:gridImageDir");
+  string key = keyStream.str();
+
+  // Reuse an existing PDF, else set up a new one.
+  map<string, PDF*>::iterator pdfItr = pdfSharedPtrs.find(key);
+  PDF* tempPDFPtr = 0;
+  if (pdfItr != pdfSharedPtrs.end()) tempPDFPtr = pdfItr->second;
+  else {
+    tempPDFPtr = getPDFPtr(idIn, sequence, beam);
+
+    // Only store PDFs that were set up successfully.
+    if (tempPDFPtr == 0 || !tempPDFPtr->isSetup()) return tempPDFPtr;
+    pdfSharedPtrs[key] = tempPDFPtr;
+  }
+
+  // Done.
+  pdfSharedUsed.insert(tempPDFPtr);
+  return tempPDFPtr;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Name of the nucleon or pion PDF set to use for a beam, for the normal
+// (sequence = 1) or the hard-process (sequence = 2) PDF.
+
+string Pythia::pdfSetWord(int idIn, int sequence, string beam) {
+
+  // Nucleons: separate choices for beam B and for the hard process.
+  if (abs(idIn) == 2212 || abs(idIn) == 2112) {
+    string pWord = settings.word("PDF:p"
+      + string(sequence == 1 ? "" : "Hard") + "Set" + beam);
+    if (pWord == "void" && sequence != 1 && beam == "B")
+      pWord = settings.word("PDF:pHardSet");
+    if (pWord == "void") pWord = settings.word("PDF:pSet");
+    return pWord;
+  }
+
+  // Pions: separate choice for beam B.
+  string piWord = settings.word("PDF:piSet" + beam);
+  if (piWord == "void" && beam == "B") piWord = settings.word("PDF:piSet");
+  return piWord;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Delete a PDF created with new, unless it is among the shared ones,
+// which are deleted when no longer used.
+
+void Pythia::deletePDF(PDF* pdfPtr) {
+
+  for (map<string, PDF*>::iterator pdfItr = pdfSharedPtrs.begin();
+    pdfItr != pdfSharedPtrs.end(); ++pdfItr)
+    if (pdfItr->second == pdfPtr) return;
+  delete pdfPtr;
+
+}
+
 //==========================================================================
 
 } // end namespace Pythia8
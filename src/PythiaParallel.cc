@@ -0,0 +1,637 @@
+// PythiaParallel.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2018 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Function definitions (not found in the header) for the PythiaParallel
+// class.
+
+#include "Pythia8/PythiaParallel.h"
+
+// Access time information and atomic counters.
+#include <ctime>
+#include <atomic>
+
+// Access process creation and temporary files.
+#include <unistd.h>
+#include <sys/wait.h>
+#include <cstdio>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The PythiaParallel class.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Negative integer to denote that no subrun has been set.
+const int PythiaParallel::SUBRUNDEFAULT = -999;
+
+// Largest allowed random number seed, cf. Random:seed.
+const int PythiaParallel::NSEEDMAX      = 900000000;
+
+//--------------------------------------------------------------------------
+
+// Constructor. The helper reads the XML files; workers copy its databases.
+
+PythiaParallel::PythiaParallel(string xmlDir, bool printBanner)
+  : pythiaHelper(xmlDir, printBanner), settings(pythiaHelper.settings),
+  particleData(pythiaHelper.particleData), isInit(false), processAsync(false),
+  counterBased(false), forkProcesses(false), numThreads(1), nAllowErrors(10),
+  seedBase(19780503), nForked(0), nEventKey(0) {}
+
+//--------------------------------------------------------------------------
+
+// Destructor.
+
+PythiaParallel::~PythiaParallel() {
+
+  clearWorkers();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Delete all workers.
+
+void PythiaParallel::clearWorkers() {
+
+  for (int i = 0; i < int(pythiaObjects.size()); ++i)
+    delete pythiaObjects[i];
+  pythiaObjects.resize(0);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Initialize all workers, without user customization.
+
+bool PythiaParallel::init() {
+
+  return init( function<bool(Pythia*)>() );
+
+}
+
+//--------------------------------------------------------------------------
+
+// Create and initialize all workers, each on its own thread.
+
+bool PythiaParallel::init(function<bool(Pythia*)> customInit) {
+
+  // Delete workers from a previous init call.
+  isInit = false;
+  clearWorkers();
+  infoForked.clear();
+  nForked = 0;
+
+  // Check that the settings are sensible before copying them.
+  if (settings.unfinishedInput() || settings.readingFailed()
+    || particleData.readingFailed()) {
+    info.errorMsg("Abort from PythiaParallel::init: "
+      "some user settings did not make sense");
+    return false;
+  }
+
+  // Read run parameters. Default to one thread per hardware core.
+  numThreads    = settings.mode("Parallelism:numThreads");
+  processAsync  = settings.flag("Parallelism:processAsync");
+  forkProcesses = settings.flag("Parallelism:forkProcesses");
+  nAllowErrors = settings.mode("Main:timesAllowErrors");
+  if (numThreads == 0)
+    numThreads = max( 1, int(thread::hardware_concurrency()));
+
+  // Base seed for the worker random number streams.
+  seedBase = settings.mode("Random:seed");
+  if (!settings.flag("Random:setSeed") || seedBase < 0) seedBase = 19780503;
+  else if (seedBase == 0) seedBase = int(time(0)) % NSEEDMAX;
+
+  // With counter-based random numbers all workers share the same seed,
+  // and each event is instead keyed by its number, see run().
+  counterBased = settings.flag("Random:counterBased");
+  nEventKey    = 0;
+
+  // Create workers as copies of the helper, each with its own seed.
+  // When forking only one is needed; the processes are made in run().
+  int nCreate = forkProcesses ? 1 : numThreads;
+  for (int iWorker = 0; iWorker < nCreate; ++iWorker) {
+    Pythia* pythiaPtr = new Pythia( settings, particleData, false);
+    pythiaObjects.push_back( pythiaPtr);
+    pythiaPtr->settings.flag("Random:setSeed", true);
+    pythiaPtr->settings.mode("Random:seed", counterBased ? seedBase
+      : 1 + (seedBase - 1 + iWorker) % NSEEDMAX);
+
+    // Only the first worker prints initialization and event listings.
+    if (iWorker > 0) {
+      pythiaPtr->settings.flag("Init:showProcesses", false);
+      pythiaPtr->settings.flag("Init:showMultipartonInteractions", false);
+      pythiaPtr->settings.flag("Init:showChangedSettings", false);
+      pythiaPtr->settings.flag("Init:showAllSettings", false);
+      pythiaPtr->settings.flag("Init:showChangedParticleData", false);
+      pythiaPtr->settings.flag("Init:showAllParticleData", false);
+      pythiaPtr->settings.mode("Init:showOneParticleData", 0);
+      pythiaPtr->settings.mode("Next:numberShowLHA", 0);
+      pythiaPtr->settings.mode("Next:numberShowInfo", 0);
+      pythiaPtr->settings.mode("Next:numberShowProcess", 0);
+      pythiaPtr->settings.mode("Next:numberShowEvent", 0);
+    }
+    pythiaPtr->settings.mode("Next:numberCount", 0);
+
+    // Forking processes is not safe while other threads are running,
+    // so workers initialized on several threads do the MPI steps serially.
+    if (nCreate > 1)
+      pythiaPtr->settings.mode("MultipartonInteractions:nInitProcesses", 1);
+
+    // Optional user customization, e.g. to set UserHooks.
+    if (customInit && !customInit(pythiaPtr)) {
+      info.errorMsg("Abort from PythiaParallel::init: "
+        "user customization of worker failed");
+      clearWorkers();
+      return false;
+    }
+  }
+
+  // Initialize the workers concurrently, or a single one directly.
+  vector<char> initOK(nCreate, 0);
+  if (nCreate == 1) initOK[0] = pythiaObjects[0]->init() ? 1 : 0;
+  else {
+    vector<thread> threads;
+    for (int iWorker = 0; iWorker < nCreate; ++iWorker)
+      threads.push_back( thread( [this, &initOK, iWorker]() {
+        initOK[iWorker] = pythiaObjects[iWorker]->init() ? 1 : 0; } ) );
+    for (int iWorker = 0; iWorker < nCreate; ++iWorker)
+      threads[iWorker].join();
+  }
+
+  // Fail if any of the workers failed.
+  for (int iWorker = 0; iWorker < nCreate; ++iWorker)
+  if (!initOK[iWorker]) {
+    info.errorMsg("Abort from PythiaParallel::init: "
+      "initialization of worker failed");
+    collectInfo();
+    clearWorkers();
+    return false;
+  }
+
+  // Done.
+  isInit = true;
+  collectInfo();
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate events on all workers until nEvents have been accepted.
+
+long PythiaParallel::run(long nEvents, function<void(Pythia*)> callback) {
+
+  // Can only generate events if initialization worked.
+  if (!isInit) {
+    info.errorMsg("Abort from PythiaParallel::run: "
+      "not properly initialized so cannot generate events");
+    return 0;
+  }
+
+  // Worker processes are handled separately.
+  if (forkProcesses) return runForked( nEvents, callback);
+
+  // Shared bookkeeping: events requested so far and events accepted,
+  // and the number keying the next counter-based random sequence.
+  std::atomic<long> nStarted(0), nAccepted(0), nKey(nEventKey);
+  std::atomic<int>  nErrors(0);
+  int nCount = settings.mode("Next:numberCount");
+
+  // Each worker takes a new event slot as long as any are left.
+  vector<thread> threads;
+  for (int iWorker = 0; iWorker < numThreads; ++iWorker)
+    threads.push_back( thread( [&, iWorker]() {
+      Pythia* pythiaPtr = pythiaObjects[iWorker];
+      while (nStarted++ < nEvents) {
+
+        // Keep the slot and retry when an event failed. Random numbers
+        // of each attempt are independent of the worker used.
+        bool isOK   = false;
+        bool isDone = false;
+        while (!isOK && !isDone) {
+          if (counterBased) pythiaPtr->rndm.setEvent(nKey++);
+          isOK = pythiaPtr->next();
+          if (!isOK && (++nErrors > nAllowErrors
+            || pythiaPtr->info.atEndOfFile())) isDone = true;
+        }
+
+        // Stop all workers if too many errors or end of file.
+        if (!isOK) {
+          nStarted = nEvents;
+          break;
+        }
+
+        // Hand on event to user, by default one worker at a time.
+        if (callback) {
+          if (processAsync) callback(pythiaPtr);
+          else {
+            std::lock_guard<mutex> lock(callbackMutex);
+            callback(pythiaPtr);
+          }
+        }
+
+        // Regularly print how many events have been generated.
+        long nNow = ++nAccepted;
+        if (nCount > 0 && nNow%nCount == 0) {
+          std::lock_guard<mutex> lock(callbackMutex);
+          cout << "\n PythiaParallel::run(): " << nNow
+               << " events have been generated " << endl;
+        }
+      } } ) );
+  for (int iWorker = 0; iWorker < numThreads; ++iWorker)
+    threads[iWorker].join();
+  nEventKey = nKey;
+
+  // Warn if the run was stopped prematurely.
+  if (nErrors > nAllowErrors) info.errorMsg("Abort from PythiaParallel::run: "
+    "too many errors; giving up");
+  else if (nAccepted < nEvents) info.errorMsg("Warning in "
+    "PythiaParallel::run: fewer events accepted than requested");
+
+  // Combine statistics from all workers and done.
+  collectInfo();
+  return nAccepted;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate events in worker processes, forked from the initialized first
+// worker so that they share its memory until it is modified. The results
+// of each process are returned in a temporary file.
+
+long PythiaParallel::runForked(long nEvents,
+  function<void(Pythia*)> callback) {
+
+  // Directory for the temporary files.
+  const char* tmpDirPtr = getenv("TMPDIR");
+  string tmpDir = (tmpDirPtr != 0 && *tmpDirPtr != '\0') ? tmpDirPtr : "/tmp";
+
+  // Output buffered so far would otherwise be repeated by each process.
+  cout << std::flush;
+  fflush(stdout);
+
+  // Start the worker processes, each with its share of the events.
+  vector<pid_t>  pids;
+  vector<string> fileNames;
+  for (int iWorker = 0; iWorker < numThreads; ++iWorker) {
+    string fileTmp = tmpDir + "/pythia8workerXXXXXX";
+    vector<char> nameTmp( fileTmp.begin(), fileTmp.end());
+    nameTmp.push_back('\0');
+    int fileDes = mkstemp( &nameTmp[0]);
+    if (fileDes < 0) {
+      info.errorMsg("Error in PythiaParallel::runForked: "
+        "could not create temporary file in", tmpDir);
+      break;
+    }
+    close(fileDes);
+    long nNow = nEvents / numThreads
+              + ((iWorker < nEvents % numThreads) ? 1 : 0);
+    pid_t pid = fork();
+    if (pid < 0) {
+      info.errorMsg("Error in PythiaParallel::runForked: "
+        "could not fork worker process");
+      remove( &nameTmp[0]);
+      break;
+    }
+
+    // The worker process never returns from here.
+    if (pid == 0) _exit( runWorkerProcess( iWorker, nNow, callback,
+      &nameTmp[0]) ? 0 : 1);
+    pids.push_back(pid);
+    fileNames.push_back( &nameTmp[0]);
+  }
+
+  // Wait for the processes to finish, and read back their results.
+  long nAccepted = 0;
+  long nTryMax   = 0;
+  bool tooManyErrors = false;
+  for (int iWorker = 0; iWorker < int(pids.size()); ++iWorker) {
+    int status = 0;
+    waitpid( pids[iWorker], &status, 0);
+    Info infoNow;
+    long nAccNow = 0;
+    long nTryNow = 0;
+    int  nErrNow = 0;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0
+      || !readWorkerResults( fileNames[iWorker], infoNow, nAccNow, nTryNow,
+      nErrNow) ) info.errorMsg("Error in PythiaParallel::runForked: "
+      "worker process failed; its events are lost");
+    else {
+      infoForked.push_back( infoNow);
+      nAccepted += nAccNow;
+      nTryMax    = max( nTryMax, nTryNow);
+      if (nErrNow > nAllowErrors) tooManyErrors = true;
+    }
+    remove( fileNames[iWorker].c_str());
+  }
+
+  // Later runs use new random number streams.
+  nForked   += numThreads;
+  nEventKey += numThreads * nTryMax;
+
+  // Warn if the run was stopped prematurely.
+  if (tooManyErrors) info.errorMsg("Abort from PythiaParallel::run: "
+    "too many errors in worker process; giving up");
+  else if (nAccepted < nEvents) info.errorMsg("Warning in "
+    "PythiaParallel::run: fewer events accepted than requested");
+
+  // Combine statistics from all workers and done.
+  collectInfo();
+  return nAccepted;
+
+}
+
+//--------------------------------------------------------------------------
+
+// The event loop of a worker process. Cross section, counter and error
+// statistics, and the histograms to be summed, are written to file.
+
+bool PythiaParallel::runWorkerProcess(int iWorker, long nEvents,
+  function<void(Pythia*)> callback, string fileName) {
+
+  // Own random number stream, unless each event has its own key.
+  Pythia* pythiaPtr = pythiaObjects[0];
+  if (!counterBased) pythiaPtr->rndm.init( 1 + (seedBase + nForked
+    + iWorker) % NSEEDMAX);
+
+  // Only the statistics of this process is to be returned.
+  Info& infoNow = pythiaPtr->info;
+  infoNow.errorReset();
+  for (int i = 0; i < 40; ++i) infoNow.setCounter(i);
+  infoNow.resetTiming();
+  for (int i = 0; i < int(histPtrs.size()); ++i) histPtrs[i]->null();
+
+  // Event loop. Attempts are keyed in steps of the number of processes.
+  int  nCount  = settings.mode("Next:numberCount");
+  long nAcc    = 0;
+  long nTry    = 0;
+  int  nErrors = 0;
+  while (nAcc < nEvents) {
+    if (counterBased) pythiaPtr->rndm.setEvent( nEventKey + iWorker
+      + nTry * numThreads);
+    ++nTry;
+    if (!pythiaPtr->next()) {
+      if (++nErrors > nAllowErrors || infoNow.atEndOfFile()) break;
+      continue;
+    }
+    if (callback) callback(pythiaPtr);
+
+    // Regularly print how many events the first process has generated.
+    ++nAcc;
+    if (iWorker == 0 && nCount > 0 && nAcc%nCount == 0)
+      cout << "\n PythiaParallel::run(): " << nAcc << " events have been "
+           << "generated by the first of " << numThreads << " processes"
+           << endl;
+  }
+  cout << std::flush;
+
+  // Write counters and the cross section estimates process by process.
+  ofstream os( fileName.c_str(), ios::binary);
+  writeBinary( os, nAcc);
+  writeBinary( os, nTry);
+  writeBinary( os, nErrors);
+  for (int i = 0; i < 40; ++i) writeBinary( os, infoNow.getCounter(i));
+  for (int i = 0; i < Info::NSTAGES; ++i) {
+    writeBinary( os, infoNow.nCallsStageSave[i]);
+    writeBinary( os, infoNow.timeStageSave[i]);
+  }
+  writeBinary( os, infoNow.wtAccSum);
+  vector<int> codes = infoNow.codesHard();
+  codes.push_back(0);
+  int nCodes = codes.size();
+  writeBinary( os, nCodes);
+  for (int j = 0; j < nCodes; ++j) {
+    writeBinary( os, codes[j]);
+    writeBinary( os, infoNow.nameProc(codes[j]));
+    writeBinary( os, infoNow.nTried(codes[j]));
+    writeBinary( os, infoNow.nSelected(codes[j]));
+    writeBinary( os, infoNow.nAccepted(codes[j]));
+    writeBinary( os, infoNow.sigmaGen(codes[j]));
+    writeBinary( os, infoNow.sigmaErr(codes[j]));
+  }
+
+  // Write error messages by text, since new ones may have been registered.
+  map<string, int> messagesNow = infoNow.errorMessages();
+  int nMessages = messagesNow.size();
+  writeBinary( os, nMessages);
+  for (map<string, int>::const_iterator it = messagesNow.begin();
+    it != messagesNow.end(); ++it) {
+    writeBinary( os, it->first);
+    writeBinary( os, it->second);
+  }
+
+  // Write the histograms and done.
+  for (int i = 0; i < int(histPtrs.size()); ++i) histPtrs[i]->writeBinary(os);
+  os.close();
+  return bool(os);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read back the results written by a worker process.
+
+bool PythiaParallel::readWorkerResults(string fileName, Info& infoOut,
+  long& nAcc, long& nTry, int& nErrors) {
+
+  // Counters.
+  ifstream is( fileName.c_str(), ios::binary);
+  if (!readBinary( is, nAcc) || !readBinary( is, nTry)
+    || !readBinary( is, nErrors)) return false;
+  for (int i = 0; i < 40; ++i) {
+    int counterNow = 0;
+    if (!readBinary( is, counterNow)) return false;
+    infoOut.setCounter( i, counterNow);
+  }
+  for (int i = 0; i < Info::NSTAGES; ++i)
+    if (!readBinary( is, infoOut.nCallsStageSave[i])
+      || !readBinary( is, infoOut.timeStageSave[i])) return false;
+
+  // Cross section estimates. The sum, code 0, comes last.
+  double wtAccSumNow = 0.;
+  int    nCodes      = 0;
+  if (!readBinary( is, wtAccSumNow) || !readBinary( is, nCodes))
+    return false;
+  infoOut.sigmaReset();
+  for (int j = 0; j < nCodes; ++j) {
+    int    code = 0;
+    string name;
+    long   nTryNow = 0, nSelNow = 0, nAccNow = 0;
+    double sigmaNow = 0., deltaNow = 0.;
+    if (!readBinary( is, code) || !readBinary( is, name)
+      || !readBinary( is, nTryNow) || !readBinary( is, nSelNow)
+      || !readBinary( is, nAccNow) || !readBinary( is, sigmaNow)
+      || !readBinary( is, deltaNow)) return false;
+    infoOut.setSigma( code, name, nTryNow, nSelNow, nAccNow, sigmaNow,
+      deltaNow, wtAccSumNow);
+  }
+
+  // Error messages.
+  int nMessages = 0;
+  if (!readBinary( is, nMessages)) return false;
+  for (int i = 0; i < nMessages; ++i) {
+    string message;
+    int    times = 0;
+    if (!readBinary( is, message) || !readBinary( is, times)) return false;
+    infoOut.messages[message] += times;
+  }
+
+  // Add the histograms to those of the main process.
+  for (int i = 0; i < int(histPtrs.size()); ++i) {
+    Hist histNow;
+    if (!histNow.readBinary(is)) return false;
+    *histPtrs[i] += histNow;
+  }
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Sum up cross section, counter and error statistics of all workers.
+// Cross sections are averaged with the number of tries as weight.
+
+void PythiaParallel::collectInfo() {
+
+  // Reset the combined information.
+  info.sigmaReset();
+  for (int i = 0; i < 40; ++i) info.setCounter(i);
+  info.setTiming( settings.flag("Next:timing") );
+  map<string, int> messagesHelper = pythiaHelper.info.messages;
+  info.messages = messagesHelper;
+  info.errorCounts = pythiaHelper.info.errorCounts;
+  if (pythiaObjects.size() > 0)
+    info.lhaStrategySave = pythiaObjects[0]->info.lhaStrategySave;
+
+  // Sum up, process by process. Code 0 is the sum of all processes.
+  map<int, string> names;
+  map<int, long> nTrySum, nSelSum, nAccSum;
+  map<int, double> sigSum, errSum;
+  names[0] = "sum";
+  // With forked processes the first worker only contributes messages
+  // from its initialization, and each process its own events.
+  vector<Info*> infoPtrs;
+  for (int iWorker = 0; iWorker < int(pythiaObjects.size()); ++iWorker)
+    infoPtrs.push_back( &pythiaObjects[iWorker]->info);
+  for (int iWorker = 0; iWorker < int(infoForked.size()); ++iWorker)
+    infoPtrs.push_back( &infoForked[iWorker]);
+  for (int iWorker = 0; iWorker < int(infoPtrs.size()); ++iWorker) {
+    Info& infoNow = *infoPtrs[iWorker];
+    for (int i = 0; i < 40; ++i) info.addCounter(i, infoNow.getCounter(i));
+    for (int i = 0; i < infoNow.nStages(); ++i) {
+      info.nCallsStageSave[i] += infoNow.nCallsStage(i);
+      info.timeStageSave[i]   += infoNow.timeStage(i);
+    }
+    for (map<string, int>::const_iterator it = infoNow.messages.begin();
+      it != infoNow.messages.end(); ++it)
+      info.messages[it->first] += it->second;
+    info.errorCounts.add( infoNow.errorCounts);
+    info.wtAccSum += infoNow.wtAccSum;
+    vector<int> codes = infoNow.codesHard();
+    codes.push_back(0);
+    for (int j = 0; j < int(codes.size()); ++j) {
+      int code = codes[j];
+      long nTryNow = infoNow.nTried(code);
+      if (code != 0) names[code] = infoNow.nameProc(code);
+      nTrySum[code] += nTryNow;
+      nSelSum[code] += infoNow.nSelected(code);
+      nAccSum[code] += infoNow.nAccepted(code);
+      sigSum[code]  += nTryNow * infoNow.sigmaGen(code);
+      errSum[code]  += pow2( nTryNow * infoNow.sigmaErr(code) );
+    }
+  }
+
+  // Store the combined numbers.
+  double wtAccSumNow = info.wtAccSum;
+  for (map<int, string>::iterator it = names.begin(); it != names.end();
+    ++it) {
+    int  code = it->first;
+    long nTry = nTrySum[code];
+    double sigma = (nTry > 0) ? sigSum[code] / nTry : 0.;
+    double delta = (nTry > 0) ? sqrt(errSum[code]) / nTry : 0.;
+    info.setSigma( code, it->second, nTry, nSelSum[code], nAccSum[code],
+      sigma, delta, wtAccSumNow);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Print combined statistics on cross sections and errors.
+
+void PythiaParallel::stat() {
+
+  // Settings as for Pythia::stat().
+  bool showPrL = settings.flag("Stat:showProcessLevel");
+  bool showErr = settings.flag("Stat:showErrors");
+
+  // Header.
+  if (showPrL) {
+    cout << "\n *-------  PythiaParallel Event and Cross Section Statistics"
+         << "  -----------------------------------------------------*\n"
+         << " |                                                            "
+         << "                                                     |\n"
+         << " | Subprocess                                    Code |       "
+         << "     Number of events       |      sigma +- delta    |\n"
+         << " |                                                    |       "
+         << "Tried   Selected   Accepted |     (estimated) (mb)   |\n"
+         << " |                                                    |       "
+         << "                            |                        |\n"
+         << " |------------------------------------------------------------"
+         << "-----------------------------------------------------|\n"
+         << " |                                                    |       "
+         << "                            |                        |\n";
+
+    // One line per process, and then the sum.
+    vector<int> codes = info.codesHard();
+    for (int i = 0; i < int(codes.size()); ++i)
+    if (codes[i] != 0) cout << " | " << left << setw(45)
+      << info.nameProc(codes[i]) << right << setw(5) << codes[i] << " | "
+      << setw(11) << info.nTried(codes[i]) << " "
+      << setw(10) << info.nSelected(codes[i]) << " "
+      << setw(10) << info.nAccepted(codes[i]) << " | "
+      << scientific << setprecision(3)
+      << setw(11) << info.sigmaGen(codes[i])
+      << setw(11) << info.sigmaErr(codes[i]) << " |\n";
+    cout << " |                                                    |       "
+         << "                            |                        |\n"
+         << " | " << left << setw(50) << "sum" << right << " | " << setw(11)
+         << info.nTried() << " " << setw(10) << info.nSelected() << " "
+         << setw(10) << info.nAccepted() << " | " << scientific
+         << setprecision(3) << setw(11) << info.sigmaGen()
+         << setw(11) << info.sigmaErr() << " |\n";
+
+    // Listing finished.
+    cout << " |                                                            "
+         << "                                                     |\n"
+         << " | Number of workers: " << setw(5)
+         << (forkProcesses ? numThreads : nWorkers())
+         << "                                                            "
+         << "                            |\n"
+         << " *-------  End PythiaParallel Event and Cross Section Statist"
+         << "ics  -------------------------------------------------*"
+         << endl;
+  }
+
+  // Summed error messages.
+  if (showErr) info.errorStatistics();
+
+  // Summed time spent in the stages of event generation, if collected.
+  if (info.doTiming()) info.timingStatistics();
+
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
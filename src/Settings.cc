@@ -179,6 +179,10 @@ bool Settings::init(string startFile, bool append) {
     };
   };
 
+  // Keep track of the files that were read.
+  if (!append) xmlFilesSave.resize(0);
+  xmlFilesSave.insert( xmlFilesSave.end(), files.begin(), files.end());
+
   // Set up default e+e- and pp tunes, if positive.
   int eeTune = mode("Tune:ee");
   if (eeTune > 0) initTuneEE( eeTune);
@@ -342,6 +346,241 @@ bool Settings::init(istream& is, bool append) {
 
 //--------------------------------------------------------------------------
 
+// Read in database from a binary image, as written by writeBinary.
+
+bool Settings::initBinary(istream& is) {
+
+  // Don't initialize if it has already been done.
+  if (isInit) return true;
+  readStringHistory.resize(0);
+  readStringSubrun.clear();
+
+  // Read in the flags, with their default values.
+  int nEntry = 0;
+  bool isOK = readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    bool   value;
+    isOK = readBinary( is, name) && readBinary( is, value);
+    if (isOK) addFlag( name, value);
+  }
+
+  // Read in the modes, with their default values and limits.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    int    value, minVal, maxVal;
+    bool   hasMin, hasMax, optOnly;
+    isOK = readBinary( is, name) && readBinary( is, value)
+      && readBinary( is, hasMin) && readBinary( is, hasMax)
+      && readBinary( is, minVal) && readBinary( is, maxVal)
+      && readBinary( is, optOnly);
+    if (isOK) addMode( name, value, hasMin, hasMax, minVal, maxVal, optOnly);
+  }
+
+  // Read in the parms, with their default values and limits.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    double value, minVal, maxVal;
+    bool   hasMin, hasMax;
+    isOK = readBinary( is, name) && readBinary( is, value)
+      && readBinary( is, hasMin) && readBinary( is, hasMax)
+      && readBinary( is, minVal) && readBinary( is, maxVal);
+    if (isOK) addParm( name, value, hasMin, hasMax, minVal, maxVal);
+  }
+
+  // Read in the words, with their default values.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name, value;
+    isOK = readBinary( is, name) && readBinary( is, value);
+    if (isOK) addWord( name, value);
+  }
+
+  // Read in the vectors of bool, with their default values.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    int    nVal = 0;
+    isOK = readBinary( is, name) && readBinary( is, nVal) && nVal >= 0;
+    vector<bool> value;
+    for (int j = 0; isOK && j < nVal; ++j) {
+      bool valNow;
+      isOK = readBinary( is, valNow);
+      value.push_back( valNow);
+    }
+    if (isOK) addFVec( name, value);
+  }
+
+  // Read in the vectors of int, with their default values and limits.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    int    nVal = 0, minVal, maxVal;
+    bool   hasMin, hasMax;
+    isOK = readBinary( is, name) && readBinary( is, nVal) && nVal >= 0;
+    vector<int> value( max( 0, nVal));
+    for (int j = 0; isOK && j < nVal; ++j) isOK = readBinary( is, value[j]);
+    isOK = isOK && readBinary( is, hasMin) && readBinary( is, hasMax)
+      && readBinary( is, minVal) && readBinary( is, maxVal);
+    if (isOK) addMVec( name, value, hasMin, hasMax, minVal, maxVal);
+  }
+
+  // Read in the vectors of double, with their default values and limits.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    int    nVal = 0;
+    double minVal, maxVal;
+    bool   hasMin, hasMax;
+    isOK = readBinary( is, name) && readBinary( is, nVal) && nVal >= 0;
+    vector<double> value( max( 0, nVal));
+    for (int j = 0; isOK && j < nVal; ++j) isOK = readBinary( is, value[j]);
+    isOK = isOK && readBinary( is, hasMin) && readBinary( is, hasMax)
+      && readBinary( is, minVal) && readBinary( is, maxVal);
+    if (isOK) addPVec( name, value, hasMin, hasMax, minVal, maxVal);
+  }
+
+  // Read in the vectors of string, with their default values.
+  isOK = isOK && readBinary( is, nEntry);
+  for (int i = 0; isOK && i < nEntry; ++i) {
+    string name;
+    int    nVal = 0;
+    isOK = readBinary( is, name) && readBinary( is, nVal) && nVal >= 0;
+    vector<string> value( max( 0, nVal));
+    for (int j = 0; isOK && j < nVal; ++j) isOK = readBinary( is, value[j]);
+    if (isOK) addWVec( name, value);
+  }
+
+  // Leave an empty database behind if the image could not be read.
+  if (!isOK) {
+    flags.clear();
+    modes.clear();
+    parms.clear();
+    words.clear();
+    fvecs.clear();
+    mvecs.clear();
+    pvecs.clear();
+    wvecs.clear();
+    return false;
+  }
+
+  // Set up default e+e- and pp tunes, if positive.
+  int eeTune = mode("Tune:ee");
+  if (eeTune > 0) initTuneEE( eeTune);
+  int ppTune = mode("Tune:pp");
+  if (ppTune > 0) initTunePP( ppTune);
+
+  // Done.
+  isInit = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the default values of the database to a binary image, which can
+// be read back much faster than the XML files.
+
+bool Settings::writeBinary(ostream& os) {
+
+  // Write the flags.
+  Pythia8::writeBinary( os, int(flags.size()));
+  for (map<string, Flag>::iterator it = flags.begin(); it != flags.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, it->second.valDefault);
+  }
+
+  // Write the modes.
+  Pythia8::writeBinary( os, int(modes.size()));
+  for (map<string, Mode>::iterator it = modes.begin(); it != modes.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, it->second.valDefault);
+    Pythia8::writeBinary( os, it->second.hasMin);
+    Pythia8::writeBinary( os, it->second.hasMax);
+    Pythia8::writeBinary( os, it->second.valMin);
+    Pythia8::writeBinary( os, it->second.valMax);
+    Pythia8::writeBinary( os, it->second.optOnly);
+  }
+
+  // Write the parms.
+  Pythia8::writeBinary( os, int(parms.size()));
+  for (map<string, Parm>::iterator it = parms.begin(); it != parms.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, it->second.valDefault);
+    Pythia8::writeBinary( os, it->second.hasMin);
+    Pythia8::writeBinary( os, it->second.hasMax);
+    Pythia8::writeBinary( os, it->second.valMin);
+    Pythia8::writeBinary( os, it->second.valMax);
+  }
+
+  // Write the words.
+  Pythia8::writeBinary( os, int(words.size()));
+  for (map<string, Word>::iterator it = words.begin(); it != words.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, it->second.valDefault);
+  }
+
+  // Write the vectors of bool.
+  Pythia8::writeBinary( os, int(fvecs.size()));
+  for (map<string, FVec>::iterator it = fvecs.begin(); it != fvecs.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, int(it->second.valDefault.size()));
+    for (int j = 0; j < int(it->second.valDefault.size()); ++j)
+      Pythia8::writeBinary( os, bool(it->second.valDefault[j]));
+  }
+
+  // Write the vectors of int.
+  Pythia8::writeBinary( os, int(mvecs.size()));
+  for (map<string, MVec>::iterator it = mvecs.begin(); it != mvecs.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, int(it->second.valDefault.size()));
+    for (int j = 0; j < int(it->second.valDefault.size()); ++j)
+      Pythia8::writeBinary( os, it->second.valDefault[j]);
+    Pythia8::writeBinary( os, it->second.hasMin);
+    Pythia8::writeBinary( os, it->second.hasMax);
+    Pythia8::writeBinary( os, it->second.valMin);
+    Pythia8::writeBinary( os, it->second.valMax);
+  }
+
+  // Write the vectors of double.
+  Pythia8::writeBinary( os, int(pvecs.size()));
+  for (map<string, PVec>::iterator it = pvecs.begin(); it != pvecs.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, int(it->second.valDefault.size()));
+    for (int j = 0; j < int(it->second.valDefault.size()); ++j)
+      Pythia8::writeBinary( os, it->second.valDefault[j]);
+    Pythia8::writeBinary( os, it->second.hasMin);
+    Pythia8::writeBinary( os, it->second.hasMax);
+    Pythia8::writeBinary( os, it->second.valMin);
+    Pythia8::writeBinary( os, it->second.valMax);
+  }
+
+  // Write the vectors of string.
+  Pythia8::writeBinary( os, int(wvecs.size()));
+  for (map<string, WVec>::iterator it = wvecs.begin(); it != wvecs.end();
+    ++it) {
+    Pythia8::writeBinary( os, it->second.name);
+    Pythia8::writeBinary( os, int(it->second.valDefault.size()));
+    for (int j = 0; j < int(it->second.valDefault.size()); ++j)
+      Pythia8::writeBinary( os, it->second.valDefault[j]);
+  }
+
+  // Done.
+  return bool(os);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Overwrite existing database by reading from specific file.
 
 bool Settings::reInit(string startFile) {
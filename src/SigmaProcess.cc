@@ -411,8 +411,21 @@ bool SigmaProcess::initFlux() {
 double SigmaProcess::sigmaPDF(bool initPS, bool samexGamma,
     bool useNewXvalues, double x1New, double x2New) {
 
+  // Hadron beams have no special photon-flux variants of the densities,
+  // so all flavours can be obtained in one call, if all have a place in it.
+  // Only for the plain xfHard case, since a PDF may override xfMax.
+  bool batchA = beamAPtr->isHadron() && !initPS && !samexGamma
+    && !(useNewXvalues && x1New > 0.) && canBatch( inBeamA);
+  bool batchB = beamBPtr->isHadron() && !initPS && !samexGamma
+    && !(useNewXvalues && x2New > 0.) && canBatch( inBeamB);
+  double xfAll[PDF::NXFBATCH];
+
   // Evaluate and store the required parton densities.
-  for (int j = 0; j < sizeBeamA(); ++j) {
+  if (batchA) {
+    beamAPtr->xfHardBatch( 1, &x1Save, &Q2FacSave, xfAll);
+    for (int j = 0; j < sizeBeamA(); ++j)
+      inBeamA[j].pdf = xfAll[PDF::xfBatchIndex(inBeamA[j].id)];
+  } else for (int j = 0; j < sizeBeamA(); ++j) {
     if ( initPS)
       inBeamA[j].pdf = beamAPtr->xfMax( inBeamA[j].id, x1Save, Q2FacSave);
     else if ( samexGamma)
@@ -422,7 +435,11 @@ double SigmaProcess::sigmaPDF(bool initPS, bool samexGamma,
     else
       inBeamA[j].pdf = beamAPtr->xfHard( inBeamA[j].id, x1Save, Q2FacSave);
   }
-  for (int j = 0; j < sizeBeamB(); ++j){
+  if (batchB) {
+    beamBPtr->xfHardBatch( 1, &x2Save, &Q2FacSave, xfAll);
+    for (int j = 0; j < sizeBeamB(); ++j)
+      inBeamB[j].pdf = xfAll[PDF::xfBatchIndex(inBeamB[j].id)];
+  } else for (int j = 0; j < sizeBeamB(); ++j){
     if ( initPS)
       inBeamB[j].pdf = beamBPtr->xfMax( inBeamB[j].id, x2Save, Q2FacSave);
     else if ( samexGamma)
@@ -473,6 +490,23 @@ double SigmaProcess::sigmaPDF(bool initPS, bool samexGamma,
 
 //--------------------------------------------------------------------------
 
+// Check whether all incoming flavours of a beam are quarks up to b,
+// gluons or photons, so that they can be read from PDF::xfBatch output.
+
+bool SigmaProcess::canBatch(const vector<InBeam>& inBeam) {
+
+  if (inBeam.size() < 2) return false;
+  for (int j = 0; j < int(inBeam.size()); ++j) {
+    int idNow = inBeam[j].id;
+    if ( (idNow == 0 || abs(idNow) > 5) && idNow != 21 && idNow != 22)
+      return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Select incoming parton channel and extract parton densities (resolved).
 
 void SigmaProcess::pickInState(int id1in, int id2in) {
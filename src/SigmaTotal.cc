@@ -9,6 +9,9 @@
 
 #include "Pythia8/SigmaTotal.h"
 
+// Reuse of earlier initialization results.
+#include "Pythia8/InitCache.h"
+
 namespace Pythia8 {
 
 //==========================================================================
@@ -1780,10 +1783,11 @@ const int    SigmaABMST::NPOINTMCCD = 200000;
 
 // Initialize data members.
 
-void SigmaABMST::init( Info* , Settings& settings, ParticleData* ,
+void SigmaABMST::init( Info* infoPtrIn, Settings& settings, ParticleData* ,
    Rndm* rndmPtrIn) {
 
-  // Save pointer.
+  // Save pointers.
+  infoPtr    = infoPtrIn;
   rndmPtr    = rndmPtrIn;
 
   // Common setup.
@@ -1973,6 +1977,22 @@ bool SigmaABMST::calcDiff( int idAin , int idBin, double sIn, double ,
   complex amp = amplitude( 0., false, true);
   sigTot = HBARC2 * imag(amp);
 
+  // Reuse the integrals of an identical earlier initialization, if any.
+  InitCache* initCachePtr = (infoPtr != 0) ? infoPtr->initCachePtr() : 0;
+  string cacheTag;
+  vector<double> cacheValues;
+  if (initCachePtr != 0) {
+    cacheTag = initCachePtr->tag("SigmaABMST");
+    if (initCachePtr->get( cacheTag, cacheValues)
+      && cacheValues.size() == 3) {
+      sigXB  = cacheValues[0];
+      sigAX  = sigXB;
+      sigXX  = cacheValues[1];
+      sigAXB = cacheValues[2];
+      return true;
+    }
+  }
+
   // Single diffractive cross sections by grid integration.
   sigXB  = dsigmaSDintXiT( 0., 1., -100., 0.);
   sigAX  = sigXB;
@@ -1984,6 +2004,15 @@ bool SigmaABMST::calcDiff( int idAin , int idBin, double sIn, double ,
   // Central diffractive cross section by Monte Carlo integration.
   sigAXB = dsigmaCDintMC();
 
+  // Store the integrals for later runs.
+  if (initCachePtr != 0) {
+    cacheValues.resize(3);
+    cacheValues[0] = sigXB;
+    cacheValues[1] = sigXX;
+    cacheValues[2] = sigAXB;
+    initCachePtr->put( cacheTag, cacheValues);
+  }
+
   // Done.
   return true;
 
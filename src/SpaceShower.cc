@@ -120,6 +120,15 @@ void SpaceShower::init( BeamParticle* beamAPtrIn,
   doRapidityOrder    = settingsPtr->flag("SpaceShower:rapidityOrder");
   doRapidityOrderMPI = settingsPtr->flag("SpaceShower:rapidityOrderMPI");
 
+  // Optionally reuse trial emissions of unchanged dipole ends.
+  reuseTrials     = settingsPtr->flag("SpaceShower:reuseTrials");
+  for (int iBeam = 0; iBeam < 2; ++iBeam) {
+    beamVersion[iBeam] = 0;
+    beamSavePtr[iBeam] = 0;
+    beamState[iBeam].resize(0);
+  }
+  pdfSavePtr      = 0;
+
   // Charm, bottom and lepton mass thresholds.
   mc              = max( MCMIN, particleDataPtr->m0(4));
   mb              = max( MBMIN, particleDataPtr->m0(5));
@@ -205,6 +214,11 @@ void SpaceShower::init( BeamParticle* beamAPtrIn,
   // Initialize alphaEM generation.
   alphaEM.init( alphaEMorder, settingsPtr);
 
+  // Optionally tabulate the running couplings.
+  bool tabulateAlpha = settingsPtr->flag("StandardModel:tabulateAlpha");
+  alphaS.setTabulate( tabulateAlpha);
+  alphaEM.setTabulate( tabulateAlpha);
+
   // Parameters of QED evolution.
   pTminChgQ       = settingsPtr->parm("SpaceShower:pTminchgQ");
   pTminChgL       = settingsPtr->parm("SpaceShower:pTminchgL");
@@ -277,9 +291,10 @@ void SpaceShower::init( BeamParticle* beamAPtrIn,
   }
 
   // Properties for enhanced emissions.
-  splittingNameSel   = "";
-  splittingNameNow   = "";
-  enhanceFactors.clear();
+  splitKernelSel     = noSplit;
+  splitKernelNow     = noSplit;
+  enhanceFacSel      = 1.;
+  enhanceFacNow      = 1.;
 
   // Enable automated uncertainty variations.
   nVarQCD            = 0;
@@ -378,7 +393,10 @@ void SpaceShower::prepare( int iSys, Event& event, bool limitPTmaxIn) {
   bool canRadiate2 = !(event[in2].isRescatteredIncoming());
 
   // Reset dipole-ends list for first interaction. Also resonances.
-  if (iSys == 0) dipEnd.resize(0);
+  if (iSys == 0) {
+    dipEnd.resize(0);
+    dipTrial.resize(0);
+  }
   if (iSys == 0) idResFirst  = 0;
   if (iSys == 1) idResSecond = 0;
 
@@ -574,35 +592,94 @@ double SpaceShower::pTnext( Event& event, double pTbegAll, double pTendAll,
                || ( doTrialNow && canEnhanceTrial);
 
   // Starting values for enhanced emissions.
-  splittingNameSel = "";
-  splittingNameNow = "";
-  enhanceFactors.clear();
+  splitKernelSel = noSplit;
+  splitKernelNow = noSplit;
+  enhanceFacSel  = 1.;
+  enhanceFacNow  = 1.;
   if (hasUserHooks) userHooksPtr->setEnhancedTrial(0., 1.);
+  if (canEnhanceET) userHooksPtr->resetEnhanceFactors();
+
+  // Trial emissions of unchanged dipole ends may be reused, except when
+  // they depend on more than the dipole end and its beam remnant.
+  bool reuseNow = reuseTrials && !doTrialNow && !canEnhanceET
+    && !doUncertainties && !beamAPtr->isGamma() && !beamBPtr->isGamma();
+  double pT2seed = 0.;
+  if (reuseNow) {
+    checkBeamState( beamAPtr, 0);
+    checkBeamState( beamBPtr, 1);
+    if (dipTrial.size() < dipEnd.size()) dipTrial.resize( dipEnd.size());
+    dipKey.resize( dipEnd.size());
+
+    // The largest trial that will be reused sets the lower limit for all
+    // new trials, so that these need not be evolved further down.
+    for (int iDipEnd = 0; iDipEnd < int(dipEnd.size()); ++iDipEnd) {
+      SpaceDipoleEnd& dip = dipEnd[iDipEnd];
+      dipKey[iDipEnd] = trialKey( dip, event);
+      if (dip.pT2 <= pT2seed || !dipTrial[iDipEnd].hasTrial
+        || dipTrial[iDipEnd].pT2 != dip.pT2
+        || !dipTrial[iDipEnd].sameDipole( dipKey[iDipEnd]) ) continue;
+      double pT2begDip = pow2( min( pTbegAll, dip.pTmax) );
+      if (pT2begDip <= dipTrial[iDipEnd].pT2beg && dip.pT2 <= pT2begDip)
+        pT2seed = dip.pT2;
+    }
+  }
 
   // Loop over all possible dipole ends.
   for (int iDipEnd = 0; iDipEnd < int(dipEnd.size()); ++iDipEnd) {
     iDipNow        = iDipEnd;
     dipEndNow      = &dipEnd[iDipEnd];
     iSysNow        = dipEndNow->system;
+    double pTbegDip = min( pTbegAll, dipEndNow->pTmax );
+    double pT2begDip = pow2(pTbegDip);
+
+    // Reuse the trial emission of an unchanged dipole end, if below the
+    // current starting scale. If there was none, the range above its
+    // lower end need not be searched again. A changed dipole end starts
+    // afresh, also for its saved parton densities.
+    double pT2begTrial = pT2begDip;
+    pdfSavePtr = 0;
+    if (reuseNow) {
+      SpaceDipoleTrial& trial = dipTrial[iDipEnd];
+      if (!trial.sameDipole( dipKey[iDipEnd])) trial = dipKey[iDipEnd];
+      else if (trial.hasTrial && trial.pT2 == dipEndNow->pT2
+        && pT2begDip <= trial.pT2beg) {
+        if (trial.pT2 > 0. && trial.pT2 <= pT2begDip) {
+          if (trial.pT2 > pT2sel) {
+            pT2sel    = trial.pT2;
+            iDipSel   = iDipNow;
+            iSysSel   = iSysNow;
+            dipEndSel = dipEndNow;
+            splitKernelSel = noSplit;
+            enhanceFacSel  = 1.;
+          }
+          continue;
+        }
+        if (trial.pT2 == 0. && trial.pT2end < pT2begDip) {
+          if (trial.pT2end <= max( pT2sel, pT2seed)) continue;
+          pT2begDip = trial.pT2end;
+        }
+      }
+      trial.hasTrial = false;
+      if (trial.isValid) pdfSavePtr = &trial;
+    }
     dipEndNow->pT2 = 0.;
     dipEndNow->pAccept = 1.0;
-    double pTbegDip = min( pTbegAll, dipEndNow->pTmax );
 
     // Check whether dipole end should be allowed to shower.
-    double pT2begDip = pow2(pTbegDip);
-    if (pT2begDip > pT2sel && ( dipEndNow->colType != 0
+    double pT2endNow = max( pT2sel, pT2seed);
+    if (pT2begDip > pT2endNow && ( dipEndNow->colType != 0
       || dipEndNow->chgType != 0 || dipEndNow->weakType != 0) ) {
       double pT2endDip = 0.;
 
       // Determine lower cut for evolution, for QCD or QED (q or l).
       if (dipEndNow->colType != 0)
-        pT2endDip = max( pT2sel, pT2min );
+        pT2endDip = max( pT2endNow, pT2min );
       else if (abs(dipEndNow->weakType) != 0)
-        pT2endDip = max( pT2sel, pT2weakCut);
+        pT2endDip = max( pT2endNow, pT2weakCut);
       else if (abs(dipEndNow->chgType) != 3 && dipEndNow->chgType != 0)
-        pT2endDip = max( pT2sel, pT2minChgQ );
+        pT2endDip = max( pT2endNow, pT2minChgQ );
       else
-        pT2endDip = max( pT2sel, pT2minChgL );
+        pT2endDip = max( pT2endNow, pT2minChgL );
 
       // Find properties of dipole and radiating dipole end.
       sideA        = ( abs(dipEndNow->side) == 1 );
@@ -645,9 +722,18 @@ double SpaceShower::pTnext( Event& event, double pTbegAll, double pTendAll,
           iDipSel   = iDipNow;
           iSysSel   = iSysNow;
           dipEndSel = dipEndNow;
-          splittingNameSel = splittingNameNow;
+          splitKernelSel = splitKernelNow;
+          enhanceFacSel  = enhanceFacNow;
         }
       }
+
+      // Keep the outcome for possible reuse.
+      if (pdfSavePtr != 0) {
+        pdfSavePtr->hasTrial = true;
+        pdfSavePtr->pT2beg   = pT2begTrial;
+        pdfSavePtr->pT2end   = pT2endDip;
+        pdfSavePtr->pT2      = dipEndNow->pT2;
+      }
     }
   // End loop over dipole ends.
   }
@@ -658,6 +744,68 @@ double SpaceShower::pTnext( Event& event, double pTbegAll, double pTendAll,
 
 //--------------------------------------------------------------------------
 
+// Update the version number of a beam when anything in its remnant state
+// has changed, i.e. the x, flavour or kind of any of its initiators.
+
+void SpaceShower::checkBeamState( BeamParticle* beamPtrIn, int iBeam) {
+
+  // Current state of the beam.
+  beamStateNow.resize(0);
+  beamStateNow.push_back( beamPtrIn->e());
+  for (int i = 0; i < beamPtrIn->size(); ++i) {
+    beamStateNow.push_back( (*beamPtrIn)[i].x());
+    beamStateNow.push_back( (*beamPtrIn)[i].id());
+    beamStateNow.push_back( (*beamPtrIn)[i].companion());
+  }
+
+  // New version if beam or its state is not the same as last time.
+  if (beamPtrIn != beamSavePtr[iBeam] || beamStateNow != beamState[iBeam]) {
+    ++beamVersion[iBeam];
+    beamSavePtr[iBeam] = beamPtrIn;
+    beamState[iBeam].swap( beamStateNow);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Current state of a dipole end, i.e. everything its trial emission
+// depends on. Only QCD and QED dipole ends can be reused.
+
+SpaceDipoleTrial SpaceShower::trialKey( const SpaceDipoleEnd& dip,
+  Event& event) {
+
+  // Dipole properties, as found in pTnext.
+  SpaceDipoleTrial key;
+  key.isValid = (dip.weakType == 0 && (dip.colType != 0 || dip.chgType != 0));
+  if (!key.isValid) return key;
+  bool sideAnow         = ( abs(dip.side) == 1 );
+  BeamParticle& beamNow = (sideAnow) ? *beamAPtr : *beamBPtr;
+  BeamParticle& beamRec = (sideAnow) ? *beamBPtr : *beamAPtr;
+  key.iRadiator   = beamNow[dip.system].iPos();
+  key.iRecoiler   = beamRec[dip.system].iPos();
+  key.iColPartner = dip.iColPartner;
+  key.idDaughter  = beamNow[dip.system].id();
+  key.x1          = beamNow[dip.system].x();
+  key.x2          = beamRec[dip.system].x();
+  key.m2Dip       = key.x1 * key.x2 * sCM
+                  + ( (dip.normalRecoil) ? 0. : event[key.iRecoiler].m2() );
+  key.m2ColPair   = (dip.iColPartner == 0) ? 0.
+                  : m2( event[key.iRadiator].p(), event[dip.iColPartner].p() );
+
+  // Dipole end, beam remnant and event history.
+  key.colType     = dip.colType;
+  key.chgType     = dip.chgType;
+  key.MEtype      = dip.MEtype;
+  key.nBranch     = dip.nBranch;
+  key.beamVersion = beamVersion[(sideAnow) ? 0 : 1];
+  key.isFirstRad  = (nRad == 0);
+  return key;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Evolve a QCD dipole end.
 
 void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
@@ -746,10 +894,8 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
   double coefColRec = (iColPartner != 0 && idColPartner == 21) ? 9./8. : 1.;
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QG, isEnhancedG2QQ, isEnhancedQ2GQ, isEnhancedG2GG;
-  isEnhancedQ2QG = isEnhancedG2QQ = isEnhancedQ2GQ = isEnhancedG2GG = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Begin evolution loop towards smaller pT values.
   int    loopTinyPDFdau = 0;
@@ -758,9 +904,8 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
 
     // Default values for current tentative emission.
     wt = 0.;
-    isEnhancedQ2QG = isEnhancedG2QQ = isEnhancedQ2GQ = isEnhancedG2GG = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Bad sign if repeated looping with small daughter PDF, so fail.
     // (Example: if all PDF's = 0 below Q_0, except for c/b companion.)
@@ -818,12 +963,25 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         continue;
       }
 
+      // Parton densities saved from an earlier call for the same dipole
+      // end can be used as if the evolution had not been interrupted.
+      bool usePDFsave = pdfSavePtr != 0 && pdfSavePtr->hasPDF
+        && pdfSavePtr->nFlavPDF == nFlavour && pT2 <= pdfSavePtr->pT2PDF
+        && pT2 >= EVALPDFSTEP * pdfSavePtr->pT2PDF;
+      if (usePDFsave) {
+        pT2PDF        = pdfSavePtr->pT2PDF;
+        xPDFdaughter  = pdfSavePtr->xPDFdaughter;
+        hasTinyPDFdau = pdfSavePtr->isTinyPDF;
+      }
+
       // Parton density of daughter at current scale.
-      pdfScale2 = (useFixedFacScale) ? fixedFacScale2 : factorMultFac * pT2;
-      xPDFdaughter = beam.xfISR(iSysNow, idDaughter, xDaughter, pdfScale2);
-      if (xPDFdaughter < TINYPDF) {
-        xPDFdaughter  = TINYPDF;
-        hasTinyPDFdau = true;
+      else {
+        pdfScale2 = (useFixedFacScale) ? fixedFacScale2 : factorMultFac * pT2;
+        xPDFdaughter = beam.xfISR(iSysNow, idDaughter, xDaughter, pdfScale2);
+        if (xPDFdaughter < TINYPDF) {
+          xPDFdaughter  = TINYPDF;
+          hasTinyPDFdau = true;
+        }
       }
 
       // Integrals of splitting kernels for gluons: g -> g, q -> g.
@@ -832,21 +990,30 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
           * log(zMaxAbs * (1.-zMinAbs) / (zMinAbs * (1.-zMaxAbs)));
         if (doMEcorrections) g2gInt *= calcMEmax(MEtype, 21, 21);
         // Optionally enhanced branching rate.
-        if (canEnhanceET) g2gInt *= userHooksPtr->enhanceFactor("isr:G2GG");
+        if (canEnhanceET)
+          g2gInt *= userHooksPtr->enhanceFactorByKernel(isrG2GG);
         q2gInt = overFac * HEADROOMQ2G * (16./3.)
           * (1./sqrt(zMinAbs) - 1./sqrt(zMaxAbs));
         if (doMEcorrections) q2gInt *= calcMEmax(MEtype, 1, 21);
         // Optionally enhanced branching rate.
-        if (canEnhanceET) q2gInt *= userHooksPtr->enhanceFactor("isr:Q2GQ");
+        if (canEnhanceET)
+          q2gInt *= userHooksPtr->enhanceFactorByKernel(isrQ2GQ);
 
         // Parton density of potential quark mothers to a g.
-        xPDFmotherSum = 0.;
-        for (int i = -nQuarkIn; i <= nQuarkIn; ++i) {
-          if (i == 0) {
-            xPDFmother[10] = 0.;
-          } else {
-            xPDFmother[i+10] = beam.xfISR(iSysNow, i, xDaughter, pdfScale2);
-            xPDFmotherSum += xPDFmother[i+10];
+        if (usePDFsave) {
+          xPDFmotherSum = pdfSavePtr->xPDFmotherSum;
+          for (int i = -nQuarkIn; i <= nQuarkIn; ++i)
+            xPDFmother[i+10] = pdfSavePtr->xPDFmother[i+10];
+        } else {
+          xPDFmotherSum = 0.;
+          for (int i = -nQuarkIn; i <= nQuarkIn; ++i) {
+            if (i == 0) {
+              xPDFmother[10] = 0.;
+            } else {
+              xPDFmother[i+10] = beam.xfISR(iSysNow, i, xDaughter,
+                pdfScale2);
+              xPDFmotherSum += xPDFmother[i+10];
+            }
           }
         }
 
@@ -861,7 +1028,8 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         q2qInt = coefColRec * overFac * (8./3.) * log( zRootMax / zRootMin );
         if (doMEcorrections) q2qInt *= calcMEmax(MEtype, 1, 1);
         // Optionally enhanced branching rate.
-        if (canEnhanceET) q2qInt *= userHooksPtr->enhanceFactor("isr:Q2QG");
+        if (canEnhanceET)
+          q2qInt *= userHooksPtr->enhanceFactorByKernel(isrQ2QG);
         kernelPDF = q2qInt;
 
       // Integrals of splitting kernels for quarks: q -> q, g -> q.
@@ -870,11 +1038,13 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
           * log( (1. - zMinAbs) / (1. - zMaxAbs) );
         if (doMEcorrections) q2qInt *= calcMEmax(MEtype, 1, 1);
         // Optionally enhanced branching rate.
-        if (canEnhanceET) q2qInt *= userHooksPtr->enhanceFactor("isr:Q2QG");
+        if (canEnhanceET)
+          q2qInt *= userHooksPtr->enhanceFactorByKernel(isrQ2QG);
         g2qInt = overFac * HEADROOMG2Q * 0.5 * (zMaxAbs - zMinAbs);
         if (doMEcorrections) g2qInt *= calcMEmax(MEtype, 21, 1);
         // Optionally enhanced branching rate.
-        if (canEnhanceET) g2qInt *= userHooksPtr->enhanceFactor("isr:G2QQ");
+        if (canEnhanceET)
+          g2qInt *= userHooksPtr->enhanceFactorByKernel(isrG2QQ);
 
         // Increase the upper weight for heavy quarks in photon beam
         // due to different behavior of the PDFs.
@@ -893,12 +1063,26 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         }
 
         // Parton density of a potential gluon mother to a q.
-        xPDFgMother = beam.xfISR(iSysNow, 21, xDaughter, pdfScale2);
+        xPDFgMother = (usePDFsave) ? pdfSavePtr->xPDFgMother
+          : beam.xfISR(iSysNow, 21, xDaughter, pdfScale2);
 
         // Total QCD evolution coefficient for a quark.
         kernelPDF = q2qInt + g2qInt * xPDFgMother / xPDFdaughter;
       }
 
+      // Save new parton densities for later calls.
+      if (pdfSavePtr != 0 && !usePDFsave) {
+        pdfSavePtr->hasPDF        = true;
+        pdfSavePtr->isTinyPDF     = hasTinyPDFdau;
+        pdfSavePtr->nFlavPDF      = nFlavour;
+        pdfSavePtr->pT2PDF        = pT2PDF;
+        pdfSavePtr->xPDFdaughter  = xPDFdaughter;
+        pdfSavePtr->xPDFmotherSum = xPDFmotherSum;
+        pdfSavePtr->xPDFgMother   = xPDFgMother;
+        for (int i = 0; i < 21; ++i)
+          pdfSavePtr->xPDFmother[i] = xPDFmother[i];
+      }
+
       // End evaluation of splitting kernels and parton densities.
       needNewPDF = false;
     }
@@ -975,14 +1159,9 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         // Account for headroom factor used to enhance trial probability
         wt /= HEADROOMG2G;
         // Optionally enhanced branching rate.
-        nameNow = "isr:G2GG";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedG2GG = true;
-          }
-        }
+        kernelNow = isrG2GG;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
       // q -> g (+ q): also select flavour.
       } else {
@@ -998,14 +1177,9 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         // Account for headroom factor used to enhance trial probability
         wt /= HEADROOMQ2G;
         // Optionally enhanced branching rate.
-        nameNow = "isr:Q2GQ";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedQ2GQ = true;
-          }
-        }
+        kernelNow = isrQ2GQ;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
       }
 
     // Select z value of branching to q, and corrective weight.
@@ -1039,14 +1213,9 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
           wt *= (m2ColPair * pow2(1. - z) + z * pT2 * 9./8.)
              / ((m2ColPair * pow2(1. - z) + z * pT2) * coefColRec);
         // Optionally enhanced branching rate.
-        nameNow = "isr:Q2QG";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedQ2QG = true;
-          }
-        }
+        kernelNow = isrQ2QG;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
       // g -> q (+ qbar).
       } else {
@@ -1062,16 +1231,11 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
         // Account for headroom factor for gluons
         wt /= HEADROOMG2Q;
         // Optionally enhanced branching rate.
-        if      (abs(idSister) <  4) nameNow = "isr:G2QQ";
-        else if (abs(idSister) == 4) nameNow = "isr:G2QQ:cc";
-        else                         nameNow = "isr:G2QQ:bb";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedG2QQ = true;
-          }
-        }
+        if      (abs(idSister) <  4) kernelNow = isrG2QQ;
+        else if (abs(idSister) == 4) kernelNow = isrG2QQcc;
+        else                         kernelNow = isrG2QQbb;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
       }
     }
 
@@ -1184,13 +1348,8 @@ void SpaceShower::pT2nextQCD( double pT2begDip, double pT2endDip) {
   } while (wt < rndmPtr->flat()) ;
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET) {
-    if (isEnhancedQ2QG) storeEnhanceFactor(pT2,"isr:Q2QG", enhanceNow);
-    if (isEnhancedG2QQ) storeEnhanceFactor(pT2,"isr:G2QQ", enhanceNow);
-    if (isEnhancedQ2GQ) storeEnhanceFactor(pT2,"isr:Q2GQ", enhanceNow);
-    if (isEnhancedG2GG) storeEnhanceFactor(pT2,"isr:G2GG", enhanceNow);
-  }
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
   // Save values for (so far) acceptable branching.
   dipEndNow->store( idDaughter,idMother, idSister, x1Now, x2Now, m2Dip,
@@ -1314,8 +1473,8 @@ void SpaceShower::pT2nearThreshold( BeamParticle& beam,
   // Save values for (so far) acceptable branching.
   double mSister = (abs(idDaughter) == 4) ? mc : mb;
 
-  if ( isGammaBeam ) splittingNameNow = "isr:A2QQ";
-  else               splittingNameNow = "isr:G2QQ";
+  splitKernelNow = (isGammaBeam) ? isrA2QQ : isrG2QQ;
+  enhanceFacNow  = 1.;
   dipEndNow->store( idDaughter, idMother, -idDaughter, x1Now, x2Now, m2Dip,
     pT2, z, xMother, Q2, mSister, pow2(mSister), pT2corr, iColPartner,
     m2ColPair, mColPartner);
@@ -1398,10 +1557,8 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
   double pT2corr  = 0.;
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QA, isEnhancedQ2AQ, isEnhancedA2QQ;
-  isEnhancedQ2QA = isEnhancedQ2AQ = isEnhancedA2QQ = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // QED evolution of fermions
   if (!isPhoton) {
@@ -1447,10 +1604,11 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
     if ( (kernelPDF + gamma2f) < TINYKERNELPDF ) return;
 
     // Optionally enhanced branching rate.
-    if (canEnhanceET) kernelPDF *= userHooksPtr->enhanceFactor("isr:Q2QA");
+    if (canEnhanceET)
+      kernelPDF *= userHooksPtr->enhanceFactorByKernel(isrQ2QA);
 
     // Optionally enhanced branching rate.
-    if (canEnhanceET) gamma2f *= userHooksPtr->enhanceFactor("isr:A2QQ");
+    if (canEnhanceET) gamma2f *= userHooksPtr->enhanceFactorByKernel(isrA2QQ);
 
     // Add gamma -> q qbar splittings to kernelPDF for photon beam.
     kernelPDF += gamma2f;
@@ -1459,9 +1617,8 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
     do {
 
       // Default values for current tentative emission.
-      isEnhancedQ2QA = isEnhancedA2QQ = false;
       enhanceNow = 1.;
-      nameNow = "";
+      kernelNow  = noSplit;
 
       // gamma -> f fbar splitting with photon beam.
       if( (rndmPtr->flat() * kernelPDF) < gamma2f ){
@@ -1506,14 +1663,9 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
         wt *= (alphaEMnow / alphaEMmax);
 
         // Optionally enhanced branching rate.
-        nameNow = "isr:A2QQ";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedA2QQ = true;
-          }
-        }
+        kernelNow = isrA2QQ;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
         // Check that gamma -> q qbar step does not cause problem.
         if (wt > 1. && pT2 > PT2MINWARN){
@@ -1570,14 +1722,9 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
         }
 
         // Optionally enhanced branching rate.
-        nameNow = "isr:Q2QA";
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedQ2QA = true;
-          }
-       }
+        kernelNow = isrQ2QA;
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
         // Derive Q2 and x of mother from pT2 and z.
         Q2      = pT2 / (1. - z);
@@ -1674,9 +1821,8 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
 
       // Default values for current tentative emission.
       wt = 0.;
-      isEnhancedQ2AQ = false;
       enhanceNow = 1.;
-      nameNow = "";
+      kernelNow  = noSplit;
 
       // Bad sign if repeated looping with small daughter PDF, so fail.
       if (hasTinyPDFdau) ++loopTinyPDFdau;
@@ -1723,7 +1869,8 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
         // (Charge-weighting happens below.)
         double q2gInt = 4. * (1./sqrt(zMinAbs) - 1./sqrt(zMaxAbs));
         // Optionally enhanced branching rate.
-        if (canEnhanceET) q2gInt *= userHooksPtr->enhanceFactor("isr:Q2QA");
+        if (canEnhanceET)
+          q2gInt *= userHooksPtr->enhanceFactorByKernel(isrQ2QA);
 
 
         // Charge-weighted Parton density of potential quark mothers.
@@ -1790,14 +1937,9 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
       wt *= (alphaEMnow / alphaEMmax);
 
       // Optionally enhanced branching rate.
-      nameNow      = "isr:Q2AQ";
-      if (canEnhanceET) {
-        double enhance = userHooksPtr->enhanceFactor(nameNow);
-        if (enhance != 1.) {
-          enhanceNow = enhance;
-          isEnhancedQ2AQ = true;
-        }
-      }
+      kernelNow = isrQ2AQ;
+      if (canEnhanceET)
+        enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
       // Derive Q2 and x of mother from pT2 and z
       Q2      = pT2 / (1. - z);
@@ -1847,12 +1989,8 @@ void SpaceShower::pT2nextQED( double pT2begDip, double pT2endDip) {
   }
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET) {
-    if (isEnhancedQ2QA) storeEnhanceFactor(pT2,"isr:Q2QA", enhanceNow);
-    if (isEnhancedQ2AQ) storeEnhanceFactor(pT2,"isr:Q2AQ", enhanceNow);
-    if (isEnhancedA2QQ) storeEnhanceFactor(pT2,"isr:A2QQ", enhanceNow);
-  }
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
   // Save values for (so far) acceptable branching.
   dipEndNow->store( idDaughter, idMother, idSister, x1Now, x2Now, m2Dip,
@@ -1921,10 +2059,8 @@ void SpaceShower::pT2nextWeak( double pT2begDip, double pT2endDip) {
   if (zMaxAbs < zMinAbs) return;
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QW;
-  isEnhancedQ2QW = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Weak evolution of fermions.
   // Integrals of splitting kernels for fermions: f -> f.
@@ -2003,15 +2139,14 @@ void SpaceShower::pT2nextWeak( double pT2begDip, double pT2endDip) {
   kernelPDF *= fudge;
   if (kernelPDF < TINYKERNELPDF) return;
   // Optionally enhanced branching rate.
-  if (canEnhanceET) kernelPDF *= userHooksPtr->enhanceFactor("isr:Q2QW");
+  if (canEnhanceET) kernelPDF *= userHooksPtr->enhanceFactorByKernel(isrQ2QW);
 
   // Begin evolution loop towards smaller pT values.
   do {
 
     // Default values for current tentative emission.
-    isEnhancedQ2QW = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Pick pT2 (in overestimated z range).
     // For l -> l gamma include extrafactor 1 / ln(pT2 / m2l) in evolution.
@@ -2054,14 +2189,9 @@ void SpaceShower::pT2nextWeak( double pT2begDip, double pT2endDip) {
     wt *= (1. + pow2(z * m2R1)) / (1. + pow2(zMaxAbs * m2R1));
 
     // Optionally enhanced branching rate.
-    nameNow      = "isr:Q2QW";
-    if (canEnhanceET) {
-      double enhance = userHooksPtr->enhanceFactor(nameNow);
-      if (enhance != 1.) {
-        enhanceNow = enhance;
-        isEnhancedQ2QW = true;
-      }
-    }
+    kernelNow = isrQ2QW;
+    if (canEnhanceET)
+      enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
     // Derive Q2 and x of mother from pT2 and z.
     Q2      = pT2 / (1. - z);
@@ -2133,9 +2263,8 @@ void SpaceShower::pT2nextWeak( double pT2begDip, double pT2endDip) {
   } while (wt < rndmPtr->flat()) ;
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET && isEnhancedQ2QW)
-    storeEnhanceFactor(pT2,"isr:Q2QW", enhanceNow);
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
   // Save values for (so far) acceptable branching.
   dipEndNow->store( idDaughter, idMother, idSister, x1Now, x2Now, m2Dip,
@@ -2151,6 +2280,9 @@ void SpaceShower::pT2nextWeak( double pT2begDip, double pT2endDip) {
 
 bool SpaceShower::branch( Event& event) {
 
+  // The trial emission of the selected dipole end cannot be reused.
+  if (iDipSel < int(dipTrial.size())) dipTrial[iDipSel].isValid = false;
+
   // Side on which branching occured.
   int side          = abs(dipEndSel->side);
   double sideSign   = (side == 1) ? 1. : -1.;
@@ -2706,19 +2838,11 @@ bool SpaceShower::branch( Event& event) {
   // Calculate event weight for enhanced emission rate.
   if (canEnhanceET) {
     // Check if emission weight was enhanced. Get enhance weight factor.
-    bool foundEnhance = false;
-    // Move backwards as last elements have highest pT, thus are chosen
-    // splittings.
-    for ( map<double,pair<string,double> >::reverse_iterator
-          it = enhanceFactors.rbegin();
-          it != enhanceFactors.rend(); ++it ){
-      if (splittingNameSel.find(it->second.first) != string::npos
-        && abs(it->second.second-1.0) > 1e-9) {
-        foundEnhance = true;
-        weight       = it->second.second;
-        vp           = userHooksPtr->vetoProbability(splittingNameSel);
-        break;
-      }
+    bool foundEnhance = (splitKernelSel != noSplit
+      && abs(enhanceFacSel - 1.0) > 1e-9);
+    if (foundEnhance) {
+      weight       = enhanceFacSel;
+      vp           = userHooksPtr->vetoProbabilityByKernel(splitKernelSel);
     }
 
     // Check emission veto.
@@ -2728,8 +2852,8 @@ bool SpaceShower::branch( Event& event) {
     if (foundEnhance && vetoedEnhancedEmission) rwgt *= (1.-1./weight)/vp;
     else if (foundEnhance) rwgt *= 1./((1.-vp)*weight);
 
-    // Reset enhance factors after usage.
-    enhanceFactors.clear();
+    // Reset enhance factor after usage.
+    enhanceFacSel = 1.;
 
     // Set events weights, so that these could be used externally.
     double wtOld = userHooksPtr->getEnhancedEventWeight();
@@ -3197,6 +3321,12 @@ bool SpaceShower::initUncertainties() {
     } // End loop over UVars.
   }
 
+  // Copy the variations to contiguous arrays, for faster evaluation.
+  uVarG2GGmuR.init( varG2GGmuRfac);  uVarG2GGcNS.init( varG2GGcNS);
+  uVarQ2QGmuR.init( varQ2QGmuRfac);  uVarQ2QGcNS.init( varQ2QGcNS);
+  uVarX2XGmuR.init( varX2XGmuRfac);  uVarX2XGcNS.init( varX2XGcNS);
+  uVarG2QQmuR.init( varG2QQmuRfac);  uVarG2QQcNS.init( varG2QQcNS);
+
   infoPtr->initUncertainties(&uVars,true);
   // Let the calling function know if we found anything.
   return (nVarQCD > 0);
@@ -3215,19 +3345,18 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
     return;
 
   // Define pointer and iterator to loop over the contents of each
-  // (iWeight,value) map.
+  // (iWeight,value) map, and to the arrays of each kind of variation.
   map<int,double>* varPtr=0;
   map<int,double>::iterator itVar;
-  // Make sure we have a dummy to point to if no map to be used.
-  map<int,double> dummy;     dummy.clear();
+  VariationList* uVarPtr = 0;
 
   int numWeights = infoPtr->nWeights();
   // Store uncertainty variation factors, initialised to unity.
   // Make vector sizes + 1 since 0 = default and variations start at 1.
-  vector<double> uVarFac(numWeights, 1.0);
-  vector<bool> doVar(numWeights, false);
+  uVarFac.assign( numWeights, 1.0);
+  doVar.assign( numWeights, 0);
   // When performing biasing, the nominal weight need not be unity.
-  doVar[0] = true;
+  doVar[0] = 1;
   uVarFac[0] = 1.0;
 
   // Extract IDs, with standard ISR nomenclature: mot -> dau(Q2) + sis
@@ -3254,7 +3383,7 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
       int iWeight   = itVar->first;
       uVarFac[iWeight] *= 1.0 + min(ratioPDFEnv.errplusPDF
         / ratioPDFEnv.centralPDF, 0.5);
-      doVar[iWeight] = true;
+      doVar[iWeight] = 1;
     }
     //
     varPtr = varPDFminus;
@@ -3262,7 +3391,7 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
       int iWeight   = itVar->first;
       uVarFac[iWeight] *= max(.01,1.0 - min(ratioPDFEnv.errminusPDF
         / ratioPDFEnv.centralPDF, 0.5));
-      doVar[iWeight] = true;
+      doVar[iWeight] = 1;
     }
     varPtr = varPDFmember;
     for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
@@ -3270,7 +3399,7 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
       int member    = int( itVar->second );
       uVarFac[iWeight] *= max(.01,ratioPDFEnv.pdfMemberVars[member]
         / ratioPDFEnv.centralPDF);
-      doVar[iWeight] = true;
+      doVar[iWeight] = 1;
     }
   }
 
@@ -3278,26 +3407,23 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
   if (dip->colType != 0) {
 
     // QCD renormalization-scale variations.
-    if (alphaSorder == 0) varPtr = &dummy;
-    else if (idMot == 21 && idSis == 21) varPtr = &varG2GGmuRfac;
-    else if (idMot == 21 && abs(idSis) <= nQuarkIn) varPtr = &varG2QQmuRfac;
+    if (alphaSorder == 0) uVarPtr = 0;
+    else if (idMot == 21 && idSis == 21) uVarPtr = &uVarG2GGmuR;
+    else if (idMot == 21 && abs(idSis) <= nQuarkIn) uVarPtr = &uVarG2QQmuR;
     else if (abs(idMot) <= nQuarkIn) {
-      if (abs(idMot) <= uVarNflavQ) varPtr = &varQ2QGmuRfac;
-      else varPtr = &varX2XGmuRfac;
+      if (abs(idMot) <= uVarNflavQ) uVarPtr = &uVarQ2QGmuR;
+      else uVarPtr = &uVarX2XGmuR;
     }
-    else varPtr = &dummy;
+    else uVarPtr = 0;
     double Q2  = dip->pT2;
-    double muR2 = renormMultFac * (Q2 + pT20in);
-    double alphaSbaseline = alphaS.alphaS(muR2);
-    for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
-      int iWeight   = itVar->first;
-      double valFac = itVar->second;
-      // Correction-factor alphaS.
-      double muR2var = max(1.1 * Lambda3flav2, pow2(valFac) * muR2);
-      double alphaSratio = alphaS.alphaS(muR2var) / alphaSbaseline;
+    if (uVarPtr != 0 && uVarPtr->size() > 0) {
+      double muR2 = renormMultFac * (Q2 + pT20in);
+      double alphaSbaseline = alphaS.alphaS(muR2);
+      double muR2min        = 1.1 * Lambda3flav2;
       // Apply soft correction factor only for (on-shell) gluon emission
-      double facCorr = 1.;
-      if (idSis == 21 && uVarMuSoftCorr) {
+      bool   doSoftCorr = (idSis == 21 && uVarMuSoftCorr);
+      double facSoftZ   = 0.;
+      if (doSoftCorr) {
         // Use smallest alphaS and b0, to make the compensation conservative.
         int nf = 5;
         if (dip->pT2 < pow2(mc)) nf = 3;
@@ -3306,40 +3432,42 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
         double facSoft    = alphaScorr * (33. - 2. * nf) / (6. * M_PI);
         // Zeta is energy fraction of emitted (on-shell) gluon = 1 - z.
         double zeta = 1. - dip->z;
-        facCorr = 1. + (1. - zeta) * facSoft * log(valFac);
+        facSoftZ = (1. - zeta) * facSoft;
+      }
+      // Limits of the absolute variation to +/- deltaAlphaSmax.
+      double facMax = (alphaSbaseline + dASmax) / alphaSbaseline;
+      double facMin = (alphaSbaseline - dASmax) / alphaSbaseline;
+      bool   hasMin = (alphaSbaseline > dASmax);
+      // Correction-factor alphaS for each variation.
+      VariationList& uVar = *uVarPtr;
+      for (int j = 0; j < uVar.size(); ++j) {
+        double muR2var = max(muR2min, pow2(uVar.value[j]) * muR2);
+        double alphaSfac = alphaS.alphaS(muR2var) / alphaSbaseline;
+        if (doSoftCorr) alphaSfac *= 1. + facSoftZ * uVar.logValue[j];
+        if (alphaSfac > 1.) alphaSfac = min(alphaSfac, facMax);
+        else if (hasMin) alphaSfac = max(alphaSfac, facMin);
+        uVar.fac[j] = alphaSfac;
       }
-      // Apply correction factor here for emission processes.
-      double alphaSfac   = alphaSratio * facCorr;
-      // Limit absolute variation to +/- deltaAlphaSmax
-      if (alphaSfac > 1.)
-        alphaSfac = min(alphaSfac, (alphaSbaseline + dASmax) / alphaSbaseline);
-      else if (alphaSbaseline > dASmax)
-        alphaSfac = max(alphaSfac, (alphaSbaseline - dASmax) / alphaSbaseline);
-      uVarFac[iWeight] *= alphaSfac;
-      doVar[iWeight] = true;
+      uVar.apply( uVarFac, doVar);
     }
 
     // QCD finite-term variations (only when no MECs and above pT threshold).
-    if (dip->MEtype != 0 || dip->pT2 < pow2(cNSpTmin) ) varPtr = &dummy;
-    else if (idMot == 21 && idSis == 21) varPtr = &varG2GGcNS;
-    else if (idMot == 21 && abs(idSis) <= nQuarkIn) varPtr = &varG2QQcNS;
+    if (dip->MEtype != 0 || dip->pT2 < pow2(cNSpTmin) ) uVarPtr = 0;
+    else if (idMot == 21 && idSis == 21) uVarPtr = &uVarG2GGcNS;
+    else if (idMot == 21 && abs(idSis) <= nQuarkIn) uVarPtr = &uVarG2QQcNS;
     else if (abs(idMot) <= nQuarkIn) {
-      if (abs(idMot) <= uVarNflavQ) varPtr = &varQ2QGcNS;
-      else varPtr = &varX2XGcNS;
+      if (abs(idMot) <= uVarNflavQ) uVarPtr = &uVarQ2QGcNS;
+      else uVarPtr = &uVarX2XGcNS;
     }
-    else varPtr = &dummy;
-    double z   = dip->z;
-    for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
-      int iWeight   = itVar->first;
-      double valFac = itVar->second;
-      // Correction-factor alphaS.
+    else uVarPtr = 0;
+    if (uVarPtr != 0 && uVarPtr->size() > 0) {
+      double z   = dip->z;
       // Virtuality for off-shell massive quarks.
       if (idMot == 21 && abs(idSis) >= 4 && idSis != 21)
         Q2 = max(1., Q2+pow2(sisPtr->m0()));
       else if (idSis == 21 && abs(idMot) >= 4 && idMot != 21)
         Q2 = max(1., Q2+pow2(motPtr->m0()));
       double yQ  = Q2 / dip->m2Dip;
-      double num = yQ * valFac;
       double denom = 1.;
       // G->GG.
       if (idSis == 21 && idMot == 21)
@@ -3353,34 +3481,39 @@ void SpaceShower::calcUncertainties(bool accept, double pAccept, double pT20in,
       // G->QQ.
       else
         denom = pow2(z) + pow2(1. - z);
-      // Compute reweight ratio.
-      double minReWeight =  max( 1. + num / denom, REJECTFACTOR );
-      uVarFac[iWeight] *= minReWeight;
-      doVar[iWeight] = true;
+      // Compute reweight ratio for each variation.
+      VariationList& uVar = *uVarPtr;
+      for (int j = 0; j < uVar.size(); ++j)
+        uVar.fac[j] = max( 1. + yQ * uVar.value[j] / denom, REJECTFACTOR );
+      uVar.apply( uVarFac, doVar);
     }
   }
 
   // Ensure 0 < PacceptPrime < 1 (with small margins).
   // Skip the central weight, so as to avoid confusion
-  for (int iWeight = 1; iWeight<numWeights; ++iWeight) {
-    if (!doVar[iWeight]) continue;
-    double pAcceptPrime = pAccept * uVarFac[iWeight];
-    if (pAcceptPrime > PROBLIMIT && dip->colType != 0) {
-      uVarFac[iWeight] *= PROBLIMIT / pAcceptPrime;
+  if (dip->colType != 0) {
+    for (int iWeight = 1; iWeight<numWeights; ++iWeight) {
+      if (!doVar[iWeight]) continue;
+      double pAcceptPrime = pAccept * uVarFac[iWeight];
+      if (pAcceptPrime > PROBLIMIT)
+        uVarFac[iWeight] *= PROBLIMIT / pAcceptPrime;
     }
   }
 
-  // Apply reject or accept reweighting factors according to input decision.
-  for (int iWeight = 0; iWeight < numWeights; ++iWeight) {
-    if (!doVar[iWeight]) continue;
-    // If trial accepted: apply ratio of accept probabilities.
-    if (accept) infoPtr->reWeight( iWeight,
-       uVarFac[iWeight] / ((1.0 - vp) * enhance) );
-    // If trial rejected : apply Sudakov reweightings.
-    else {
-      // Check for near-singular denominators (indicates too few failures,
-      // and hence would need to increase headroom).
-      double denom = 1. - pAccept * (1.0 - vp);
+  // If trial accepted: apply ratio of accept probabilities.
+  if (accept) {
+    double normAcc = (1.0 - vp) * enhance;
+    for (int iWeight = 0; iWeight < numWeights; ++iWeight)
+      if (doVar[iWeight]) infoPtr->reWeight( iWeight, uVarFac[iWeight]
+        / normAcc);
+
+  // If trial rejected : apply Sudakov reweightings.
+  } else {
+    // Check for near-singular denominators (indicates too few failures,
+    // and hence would need to increase headroom).
+    double denom = 1. - pAccept * (1.0 - vp);
+    for (int iWeight = 0; iWeight < numWeights; ++iWeight) {
+      if (!doVar[iWeight]) continue;
       if (denom < REJECTFACTOR) {
         stringstream message;
         message << iWeight;
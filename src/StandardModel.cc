@@ -3,7 +3,8 @@
 // PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
-// Function definitions (not found in the header) for the AlphaStrong class.
+// Function definitions (not found in the header) for the AlphaTable,
+// AlphaStrong, AlphaEM, CoupSM and CKM classes.
 
 #include "Pythia8/StandardModel.h"
 
@@ -11,6 +12,35 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The AlphaTable class.
+
+//--------------------------------------------------------------------------
+
+// Set up the nodes. The first and last ones are at the cell borders
+// just below scale2Min and just above scale2Max, respectively.
+
+void AlphaTable::init(double scale2MinIn, double scale2MaxIn, int nPerOctIn,
+  int nValIn) {
+
+  // Cell borders are at integer multiples of 1 / nPerOct in t.
+  nVal     = nValIn;
+  nPerOct  = nPerOctIn;
+  iMin     = 0.;
+  double pMin = floor( pCell( scale2MinIn));
+  double pMax = ceil( pCell( scale2MaxIn));
+  iMin     = pMin;
+  nCell    = max( 1, int(pMax - pMin));
+  scale2Lo = scale2T( 0.);
+  scale2Hi = scale2T( nCell);
+
+  // All cells can be used until otherwise found.
+  values.assign( (nCell + 1) * nVal, 0.);
+  cellOk.assign( nCell, true);
+
+}
+
+//==========================================================================
+
 // The AlphaStrong class.
 
 //--------------------------------------------------------------------------
@@ -21,6 +51,12 @@ namespace Pythia8 {
 // Number of iterations to determine Lambda from given alpha_s.
 const int AlphaStrong::NITER           = 10;
 
+// Optional table: number of cells per factor two in Q^2, upper end of
+// the table, and allowed relative deviation of interpolated values.
+const int    AlphaStrong::NPEROCTTAB   = 64;
+const double AlphaStrong::SCALE2MAXTAB = 1e12;
+const double AlphaStrong::TOLTAB       = 1e-5;
+
 // MZ normalization scale
 const double AlphaStrong::MZ           = 91.188;
 
@@ -160,6 +196,54 @@ void AlphaStrong::init( double valueIn, int orderIn, int nfmaxIn,
   scale2Now    = MZ * MZ;
   isInit       = true;
 
+  // Optionally set up table.
+  initTable();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up the table of first-order values and, for second order, the
+// correction factors. Cells that contain a flavour threshold, or where
+// the interpolation is not accurate enough in the middle, are not used.
+
+void AlphaStrong::initTable() {
+
+  // Only for running alpha_s.
+  table.clear();
+  if (!doTable || !isInit || order == 0) return;
+  int nVal = (order == 2) ? 2 : 1;
+  table.init( scale2Min, SCALE2MAXTAB, NPEROCTTAB, nVal);
+
+  // Direct values while the table is filled.
+  doTable = false;
+  for (int iNode = 0; iNode <= table.nCells(); ++iNode) {
+    double scale2 = table.scale2Node( iNode);
+    table.setValue( iNode, 0, alphaS1Ord( scale2));
+    if (order == 2) table.setValue( iNode, 1, alphaS2OrdCorr( scale2));
+  }
+
+  // Reject cells with a kink, at thresholds or where frozen below.
+  table.rejectCell( table.cell( scale2Min));
+  table.rejectCell( table.cell( mc2));
+  table.rejectCell( table.cell( mb2));
+  if (nfmax >= 6) table.rejectCell( table.cell( mt2));
+
+  // Check the interpolation in the middle of each cell.
+  double valTab[2], valDir[2];
+  for (int iCell = 0; iCell < table.nCells(); ++iCell) {
+    double scale2 = table.scale2Mid( iCell);
+    if (!table.interpolate( scale2, valTab)) continue;
+    valDir[0] = alphaS1Ord( scale2);
+    if (order == 2) valDir[1] = alphaS2OrdCorr( scale2);
+    for (int iVal = 0; iVal < nVal; ++iVal)
+    if (abs(valTab[iVal] - valDir[iVal]) > TOLTAB * abs(valDir[iVal]))
+      table.rejectCell( iCell);
+    if (order == 2 && abs(valTab[0] * valTab[1] - valDir[0] * valDir[1])
+      > TOLTAB * abs(valDir[0] * valDir[1])) table.rejectCell( iCell);
+  }
+  doTable = true;
+
 }
 
 //--------------------------------------------------------------------------
@@ -172,6 +256,11 @@ double AlphaStrong::alphaS( double scale2) {
   if (!isInit) return 0.;
   if (scale2 < scale2Min) scale2 = scale2Min;
 
+  // Interpolate in the table, if available.
+  double valTab[2];
+  if (doTable && table.interpolate( scale2, valTab))
+    return (order == 2) ? valTab[0] * valTab[1] : valTab[0];
+
   // If equal to old scale then same answer.
   if (scale2 == scale2Now && (order < 2 || lastCallToFull)) return valueNow;
   scale2Now      = scale2;
@@ -238,6 +327,10 @@ double  AlphaStrong::alphaS1Ord( double scale2) {
   if (!isInit) return 0.;
   if (scale2 < scale2Min) scale2 = scale2Min;
 
+  // Interpolate in the table, if available.
+  double valTab[2];
+  if (doTable && table.interpolate( scale2, valTab)) return valTab[0];
+
   // If equal to old scale then same answer.
   if (scale2 == scale2Now && (order < 2 || !lastCallToFull)) return valueNow;
   scale2Now      = scale2;
@@ -276,6 +369,10 @@ double AlphaStrong::alphaS2OrdCorr( double scale2) {
   // Only meaningful for second-order calculations.
   if (order < 2) return 1.;
 
+  // Interpolate in the table, if available.
+  double valTab[2];
+  if (doTable && table.interpolate( scale2, valTab)) return valTab[1];
+
   // Second order correction term: differs by mass region.
   double Lambda2, b1, b2;
   if (scale2 > mt2 && nfmax >= 6) {
@@ -358,6 +455,12 @@ const double AlphaEM::Q2STEP[5]  = {0.26e-6, 0.011, 0.25, 3.5, 90.};
 // enhanced for quarks to approximately account for QCD corrections.
 const double AlphaEM::BRUNDEF[5] = {0.1061, 0.2122, 0.460, 0.700, 0.725};
 
+// Optional table: number of cells per factor two in Q^2, upper end of
+// the table, and allowed relative deviation of interpolated values.
+const int    AlphaEM::NPEROCTTAB   = 32;
+const double AlphaEM::SCALE2MAXTAB = 1e12;
+const double AlphaEM::TOLTAB       = 1e-6;
+
 //--------------------------------------------------------------------------
 
 // Initialize alpha_EM calculation.
@@ -365,6 +468,7 @@ const double AlphaEM::BRUNDEF[5] = {0.1061, 0.2122, 0.460, 0.700, 0.725};
 void AlphaEM::init(int orderIn, Settings* settingsPtr) {
 
   // Order. Read in alpha_EM value at 0 and m_Z, and mass of Z.
+  table.clear();
   order     = orderIn;
   alpEM0    = settingsPtr->parm("StandardModel:alphaEM0");
   alpEMmZ   = settingsPtr->parm("StandardModel:alphaEMmZ");
@@ -391,6 +495,40 @@ void AlphaEM::init(int orderIn, Settings* settingsPtr) {
   bRun[2] = (1./alpEMstep[3] - 1./alpEMstep[2])
     / log(Q2STEP[2] / Q2STEP[3]);
 
+  // Optionally set up table.
+  initTable();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up the table of running alpha_EM values. Cells that contain a
+// threshold, or where the interpolation is not accurate enough in the
+// middle, are not used.
+
+void AlphaEM::initTable() {
+
+  // Only for running alpha_EM.
+  table.clear();
+  if (!doTable || order <= 0) return;
+  table.init( Q2STEP[0], SCALE2MAXTAB, NPEROCTTAB, 1);
+
+  // Direct values while the table is filled.
+  doTable = false;
+  for (int iNode = 0; iNode <= table.nCells(); ++iNode)
+    table.setValue( iNode, 0, alphaEM( table.scale2Node( iNode)));
+
+  // Reject cells with a threshold, and check the others in the middle.
+  for (int i = 0; i < 5; ++i) table.rejectCell( table.cell( Q2STEP[i]));
+  double valTab;
+  for (int iCell = 0; iCell < table.nCells(); ++iCell) {
+    double scale2 = table.scale2Mid( iCell);
+    if (!table.interpolate( scale2, &valTab)) continue;
+    double valDir = alphaEM( scale2);
+    if (abs(valTab - valDir) > TOLTAB * valDir) table.rejectCell( iCell);
+  }
+  doTable = true;
+
 }
 
 //--------------------------------------------------------------------------
@@ -403,6 +541,10 @@ double AlphaEM::alphaEM( double scale2) {
   if (order == 0)  return alpEM0;
   if (order <  0)  return alpEMmZ;
 
+  // Interpolate in the table, if available.
+  double valTab;
+  if (doTable && table.interpolate( scale2, &valTab)) return valTab;
+
   // Running alphaEM.
   for (int i = 4; i >= 0; --i) if (scale2 > Q2STEP[i])
     return alpEMstep[i] / (1. - bRun[i] * alpEMstep[i]
@@ -66,6 +66,12 @@ const double TimeShower::REJECTFACTOR = 0.1;
 // Limit on probability for uncertainty variations.
 const double TimeShower::PROBLIMIT = 0.99;
 
+// Expressions coded in calcMEcorr for each ME kind: 0 = a single one,
+// 1 = only vector, 7 = vector, axial and combined ones.
+const int    TimeShower::NMEKIND       = 34;
+const int    TimeShower::MEKINDEXPR[]  = { 0, 0, 7, 7, 7, 7, 1, 1, 1, 1,
+  7, 7, 7, 7, 7, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
 //--------------------------------------------------------------------------
 
 // Initialize alphaStrong, alphaEM and related pTmin parameters.
@@ -163,6 +169,11 @@ void TimeShower::init( BeamParticle* beamAPtrIn,
   // Initialize alphaEM generation.
   alphaEM.init( alphaEMorder, settingsPtr);
 
+  // Optionally tabulate the running couplings.
+  bool tabulateAlpha = settingsPtr->flag("StandardModel:tabulateAlpha");
+  alphaS.setTabulate( tabulateAlpha);
+  alphaEM.setTabulate( tabulateAlpha);
+
   // Parameters of QED evolution.
   nGammaToQuark      = settingsPtr->mode("TimeShower:nGammaToQuark");
   nGammaToLepton     = settingsPtr->mode("TimeShower:nGammaToLepton");
@@ -198,6 +209,9 @@ void TimeShower::init( BeamParticle* beamAPtrIn,
   // Flag to allow to start from a scale smaller than scalup.
   limitMUQ           = settingsPtr->flag("TimeShower:limitPTmaxGlobal");
 
+  // Reuse trial emissions of dipole ends unchanged since the last step.
+  reuseTrials        = settingsPtr->flag("TimeShower:reuseTrials");
+
   // Fraction and colour factor of gluon emission off onium octat state.
   octetOniumFraction = settingsPtr->parm("TimeShower:octetOniumFraction");
   octetOniumColFac   = settingsPtr->parm("TimeShower:octetOniumColFac");
@@ -261,9 +275,10 @@ void TimeShower::init( BeamParticle* beamAPtrIn,
   }
 
   // Properties for enhanced emissions.
-  splittingNameSel   = "";
-  splittingNameNow   = "";
-  enhanceFactors.clear();
+  splitKernelSel     = noSplit;
+  splitKernelNow     = noSplit;
+  enhanceFacSel      = 1.;
+  enhanceFacNow      = 1.;
 
   // Enable automated uncertainty variations.
   nVarQCD            = 0;
@@ -411,10 +426,13 @@ int TimeShower::showerQED( int i1, int i2, Event& event, double pTmax) {
 
   // Fill dipole-ends list.
   dipEnd.resize(0);
+  dipTrial.resize(0);
   if (iChg1 != 0) dipEnd.push_back( TimeDipoleEnd(i1, i2, pTmax,
       0, iChg1, 0, 0, 0, iSys, MEtype, i2) );
   if (iChg2 != 0) dipEnd.push_back( TimeDipoleEnd(i2, i1, pTmax,
       0, iChg2, 0, 0, 0, iSys, MEtype, i1) );
+  for (int iDip = 0; iDip < int(dipEnd.size()); ++iDip)
+    setupMEcorr( dipEnd[iDip]);
 
   // Begin evolution down in pT from hard pT scale.
   int nBranch  = 0;
@@ -621,7 +639,10 @@ void TimeShower::prepare( int iSys, Event& event, bool limitPTmaxIn) {
   // Reset dipole-ends list for first interaction and for resonance decays.
   int iInA = partonSystemsPtr->getInA(iSys);
   int iInB = partonSystemsPtr->getInB(iSys);
-  if (iSys == 0 || iInA == 0) dipEnd.resize(0);
+  if (iSys == 0 || iInA == 0) {
+    dipEnd.resize(0);
+    dipTrial.resize(0);
+  }
   int dipEndSizeBeg = dipEnd.size();
 
   // No dipoles for 2 -> 1 processes.
@@ -709,9 +730,12 @@ void TimeShower::prepare( int iSys, Event& event, bool limitPTmaxIn) {
   if (doWeakShower && weakExternal && iSys == 0)
     setupWeakdipExternal(event, limitPTmaxIn);
 
-  // Loop through dipole ends to find matrix element corrections.
-  for (int iDip = dipEndSizeBeg; iDip < int(dipEnd.size()); ++iDip)
+  // Loop through dipole ends to find matrix element corrections,
+  // and precompile how each of them is to be evaluated.
+  for (int iDip = dipEndSizeBeg; iDip < int(dipEnd.size()); ++iDip) {
     findMEtype( event, dipEnd[iDip]);
+    setupMEcorr( dipEnd[iDip]);
+  }
 
   // Update dipole list after a multiparton interactions rescattering.
   if (iSys > 0 && ( (iInA > 0 && event[iInA].status() == -34)
@@ -906,6 +930,10 @@ void TimeShower::rescatterUpdate( int iSys, Event& event) {
     }
   }
 
+  // Redo the ME corrections of changed and new dipole ends.
+  for (int iDip = 0; iDip < int(dipEnd.size()); ++iDip)
+    setupMEcorr( dipEnd[iDip]);
+
 }
 
 //--------------------------------------------------------------------------
@@ -1010,6 +1038,7 @@ void TimeShower::rescatterUpdate( int iSys, Event& event) {
       dipNow.colType = 0;
       dipNow.chgType = 0;
       dipNow.gamType = 0;
+      setupMEcorr( dipNow);
       infoPtr->errorMsg("Error in TimeShower::update: "
       "failed to locate new recoiling partner");
     }
@@ -1023,6 +1052,9 @@ void TimeShower::rescatterUpdate( int iSys, Event& event) {
   // Set the weak radiated variable to true if already radiated.
   if (hasWeakRad) hasWeaklyRadiated = true;
 
+  // Dipole ends added below have their ME corrections precompiled after.
+  int dipEndSizeBeg = dipEnd.size();
+
   // Find new dipole end formed by colour index.
   int colTag = event[iNewNew].col();
   if (doQCDshower && colTag > 0)
@@ -1070,6 +1102,10 @@ void TimeShower::rescatterUpdate( int iSys, Event& event) {
     }
   }
 
+  // Precompile the ME corrections of the new dipole ends.
+  for (int iDip = dipEndSizeBeg; iDip < int(dipEnd.size()); ++iDip)
+    setupMEcorr( dipEnd[iDip]);
+
   // Start iterate over list of rescatterers - may be empty.
   int iRescNow = -1;
   while (++iRescNow < int(iRescatterer.size())) {
@@ -1901,30 +1937,74 @@ double TimeShower::pTnext( Event& event, double pTbegAll, double pTendAll,
                || ( doTrialNow && canEnhanceTrial);
 
   // Starting values for enhanced emissions.
-  splittingNameSel = "";
-  splittingNameNow = "";
-  enhanceFactors.clear();
+  splitKernelSel = noSplit;
+  splitKernelNow = noSplit;
+  enhanceFacSel  = 1.;
+  enhanceFacNow  = 1.;
   if (hasUserHooks) userHooksPtr->setEnhancedTrial(0., 1.);
+  if (canEnhanceET) userHooksPtr->resetEnhanceFactors();
+
+  // For global recoil find, once for all dipole ends, which outgoing
+  // partons stem from the hard scattering (including resonance decay
+  // products), which systems only contain such partons, and the number
+  // of final coloured partons.
+  int nSys = partonSystemsPtr->sizeSys();
+  vector< vector<bool> > hasHardAncestor;
+  vector<bool> isHardSystem;
+  int nFinalCol = 0;
+  if (globalRecoil) {
+    hasHardAncestor.resize( nSys);
+    isHardSystem.resize( nSys, true);
+    for (int iS = 0; iS < nSys; ++iS) {
+      int sizeOut = partonSystemsPtr->sizeOut(iS);
+      hasHardAncestor[iS].resize( sizeOut);
+      for (int i = 0; i < sizeOut; ++i) {
+        int ii = partonSystemsPtr->getOut( iS, i);
+        bool hasHardNow = event[ii].statusAbs() < 23;
+        for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard){
+          if ( event[ii].isAncestor(hardPartons[iHard])
+            || ii == hardPartons[iHard]
+            || (event[ii].status() == 23 && event[ii].colType() == 0) )
+            hasHardNow = true;
+        }
+        hasHardAncestor[iS][i] = hasHardNow;
+        if (!hasHardNow) isHardSystem[iS] = false;
+      }
+    }
+    if (globalRecoilMode == 2)
+    for (int k = 0; k < int(event.size()); ++k)
+      if ( event[k].isFinal() && event[k].colType() != 0) nFinalCol++;
+  }
+
+  // Trial emissions of unchanged dipole ends may be reused, except when
+  // they depend on more than the dipole end itself.
+  bool reuseNow = reuseTrials && !globalRecoil && !doTrialNow
+    && !canEnhanceET && !doUncertainties;
+  if (reuseNow && dipTrial.size() < dipEnd.size())
+    dipTrial.resize( dipEnd.size());
+
+  // The largest trial that will be reused sets the lower limit for all
+  // new trials, so that these need not be evolved further down.
+  double pT2seed = 0.;
+  if (reuseNow)
+  for (int iDip = 0; iDip < int(dipEnd.size()); ++iDip) {
+    TimeDipoleEnd& dip = dipEnd[iDip];
+    if (dip.pT2 <= pT2seed || !TimeDipoleTrial::canKeep(dip)
+      || !dipTrial[iDip].matches( dip, event)) continue;
+    double pT2begDip = min( pow2( min( pTbegAll, dip.pTmax)),
+      dipTrial[iDip].pT2cap);
+    if (pT2begDip <= dipTrial[iDip].pT2beg && dip.pT2 <= pT2begDip)
+      pT2seed = dip.pT2;
+  }
 
   for (int iDip = 0; iDip < int(dipEnd.size()); ++iDip) {
     TimeDipoleEnd& dip = dipEnd[iDip];
-    dip.pAccept        = 1.0;
 
     // Check if this system is part of the hard scattering
     // (including resonance decay products).
-    bool hardSystem = true;
+    bool hardSystem = globalRecoil && dip.system < nSys
+      && isHardSystem[dip.system];
     bool isQCD = event[dip.iRadiator].colType() != 0;
-    for (int i = 0; i < partonSystemsPtr->sizeOut(dip.system); ++i) {
-      int ii = partonSystemsPtr->getOut( dip.system, i);
-      bool hasHardAncestor = event[ii].statusAbs() < 23;
-      for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard){
-        if ( event[ii].isAncestor(hardPartons[iHard])
-          || ii == hardPartons[iHard]
-          || (event[ii].status() == 23 && event[ii].colType() == 0) )
-          hasHardAncestor = true;
-      }
-      if (!hasHardAncestor) hardSystem = false;
-    }
 
     // Check if global recoil should be used.
     useLocalRecoilNow = !(globalRecoil && hardSystem
@@ -1944,10 +2024,7 @@ double TimeShower::pTnext( Event& event, double pTbegAll, double pTendAll,
       useLocalRecoilNow = !(globalRecoil && hardSystem
         && nProposed.find(dip.system) != nProposed.end()
         && nProposed[dip.system]-infoPtr->getCounter(40) == 0);
-      int nFinal = 0;
-      for (int k = 0; k < int(event.size()); ++k)
-        if ( event[k].isFinal() && event[k].colType() != 0) nFinal++;
-      bool isFirst = (nHard == nFinal);
+      bool isFirst = (nHard == nFinalCol);
 
       // Switch off global recoil after first emission
       if ( globalRecoil && doInterleave && !isFirst )
@@ -1968,18 +2045,11 @@ double TimeShower::pTnext( Event& event, double pTbegAll, double pTendAll,
       Vec4 pSumGlobal;
       // Include all particles in all hard systems (hard production system,
       // systems of resonance decay products) in the global recoil momentum.
-      for (int iS = 0; iS < partonSystemsPtr->sizeSys(); ++iS) {
+      for (int iS = 0; iS < nSys; ++iS) {
         for (int i = 0; i < partonSystemsPtr->sizeOut(iS); ++i) {
           int ii = partonSystemsPtr->getOut( iS, i);
-          bool hasHardAncestor = event[ii].statusAbs() < 23;
-          for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard) {
-            if ( event[ii].isAncestor(hardPartons[iHard])
-              || ii == hardPartons[iHard]
-              || (event[ii].status() == 23 && event[ii].colType() == 0) )
-              hasHardAncestor = true;
-          }
-          if (hasHardAncestor && ii !=  dip.iRadiator && event[ii].isFinal() )
-            pSumGlobal += event[ii].p();
+          if (hasHardAncestor[iS][i] && ii !=  dip.iRadiator
+            && event[ii].isFinal() ) pSumGlobal += event[ii].p();
         }
       }
       dip.mRec = pSumGlobal.mCalc();
@@ -2011,8 +2081,31 @@ double TimeShower::pTnext( Event& event, double pTbegAll, double pTendAll,
       pT2begDip = min( pow2(muQ), min(pow2(pTbegDip), 0.25 * m2DC) );
     }
 
+    // Reuse the trial emission of an unchanged QCD or QED dipole end,
+    // if below the current starting scale. If there was none, the range
+    // above its lower end need not be searched again.
+    bool canReuse = reuseNow && TimeDipoleTrial::canKeep(dip);
+    double pT2begTrial = pT2begDip;
+    if (canReuse && dipTrial[iDip].matches( dip, event)
+      && pT2begDip <= dipTrial[iDip].pT2beg) {
+      if (dip.pT2 > 0. && dip.pT2 <= pT2begDip) {
+        if (dip.pT2 > pT2sel) {
+          pT2sel  = dip.pT2;
+          dipSel  = &dip;
+          iDipSel = iDip;
+        }
+        continue;
+      }
+      if (dip.pT2 == 0. && dipTrial[iDip].pT2end < pT2begDip) {
+        if (dipTrial[iDip].pT2end <= max( pT2sel, pT2seed)) continue;
+        pT2begDip = dipTrial[iDip].pT2end;
+      }
+    }
+    dip.pAccept = 1.0;
+
     // Do not try splitting if the corrected dipole mass is negative.
     dip.pT2 = 0.;
+    if (reuseNow) dipTrial[iDip].isValid = false;
     if (dip.m2DipCorr < 0.) {
       infoPtr->errorMsg("Warning in TimeShower::pTnext: "
       "negative dipole mass.");
@@ -2020,24 +2113,31 @@ double TimeShower::pTnext( Event& event, double pTbegAll, double pTendAll,
     }
 
     // Do QCD, QED, weak or HV evolution if it makes sense.
-    if (pT2begDip > pT2sel) {
+    double pT2endDip   = max( pT2sel, pT2seed);
+    double pT2endTrial = max( pT2endDip, pT2begDip);
+    if (pT2begDip > pT2endDip) {
       if      (dip.colType != 0)
-        pT2nextQCD(pT2begDip, pT2sel, dip, event);
+        pT2nextQCD(pT2begDip, pT2endDip, dip, event);
       else if (dip.chgType != 0 || dip.gamType != 0)
-        pT2nextQED(pT2begDip, pT2sel, dip, event);
+        pT2nextQED(pT2begDip, pT2endDip, dip, event);
       else if (dip.weakType != 0)
-        pT2nextWeak(pT2begDip, pT2sel, dip, event);
+        pT2nextWeak(pT2begDip, pT2endDip, dip, event);
       else if (dip.colvType != 0)
-        pT2nextHV(pT2begDip, pT2sel, dip, event);
+        pT2nextHV(pT2begDip, pT2endDip, dip, event);
 
       // Update if found larger pT than current maximum.
+      pT2endTrial = pT2endDip;
       if (dip.pT2 > pT2sel) {
         pT2sel  = dip.pT2;
         dipSel  = &dip;
         iDipSel = iDip;
-        splittingNameSel = splittingNameNow;
+        splitKernelSel = splitKernelNow;
+        enhanceFacSel  = enhanceFacNow;
       }
     }
+
+    // Keep the outcome for possible reuse.
+    if (canReuse) dipTrial[iDip].set( dip, event, pT2begTrial, pT2endTrial);
   }
 
   // Update the number of proposed timelike emissions.
@@ -2099,18 +2199,15 @@ void TimeShower::pT2nextQCD(double pT2begDip, double pT2sel,
   double overFac       = doUncertaintiesNow ? overFactor : 1.0;
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QG, isEnhancedG2QQ, isEnhancedG2GG;
-  isEnhancedQ2QG = isEnhancedG2QQ = isEnhancedG2GG = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Begin evolution loop towards smaller pT values.
   do {
 
     // Default values for current tentative emission.
-    isEnhancedQ2QG = isEnhancedG2QQ = isEnhancedG2GG = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Initialize evolution coefficients at the beginning and
     // reinitialize when crossing c and b flavour thresholds.
@@ -2145,9 +2242,9 @@ void TimeShower::pT2nextQCD(double pT2begDip, double pT2sel,
       emitCoefGlue = overFac * wtPSglue * colFac * log(1. / zMinAbs - 1.);
       // Optionally enhanced branching rate.
       if (canEnhanceET && colTypeAbs == 2)
-        emitCoefGlue *= userHooksPtr->enhanceFactor("fsr:G2GG");
+        emitCoefGlue *= userHooksPtr->enhanceFactorByKernel(fsrG2GG);
       if (canEnhanceET && colTypeAbs == 1)
-        emitCoefGlue *= userHooksPtr->enhanceFactor("fsr:Q2QG");
+        emitCoefGlue *= userHooksPtr->enhanceFactorByKernel(fsrQ2QG);
 
       // For dipole recoil: no g -> g g branching, since in SpaceShower.
       if (doDipoleRecoil && dip.isrType != 0 && colTypeAbs == 2)
@@ -2159,7 +2256,7 @@ void TimeShower::pT2nextQCD(double pT2begDip, double pT2sel,
         emitCoefQqbar = overFac * wtPSqqbar * (1. - 2. * zMinAbs);
         // Optionally enhanced branching rate.
         if (canEnhanceET)
-          emitCoefQqbar *= userHooksPtr->enhanceFactor("fsr:G2QQ");
+          emitCoefQqbar *= userHooksPtr->enhanceFactorByKernel(fsrG2QQ);
         emitCoefTot  += emitCoefQqbar;
       }
 
@@ -2227,37 +2324,22 @@ void TimeShower::pT2nextQCD(double pT2begDip, double pT2sel,
 
         if (dip.flavour == 21
           && (colTypeAbs == 1 || colTypeAbs == 3) ) {
-          nameNow = "fsr:Q2QG";
+          kernelNow = fsrQ2QG;
           // Optionally enhanced branching rate.
-          if (canEnhanceET) {
-            double enhance = userHooksPtr->enhanceFactor(nameNow);
-            if (enhance != 1.) {
-              enhanceNow = enhance;
-              isEnhancedQ2QG = true;
-            }
-          }
+          if (canEnhanceET)
+            enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
         } else if (dip.flavour == 21) {
-          nameNow = "fsr:G2GG";
+          kernelNow = fsrG2GG;
           // Optionally enhanced branching rate.
-          if (canEnhanceET) {
-            double enhance = userHooksPtr->enhanceFactor(nameNow);
-            if (enhance != 1.) {
-              enhanceNow = enhance;
-              isEnhancedG2GG = true;
-            }
-          }
+          if (canEnhanceET)
+            enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
         } else {
-          if      (dip.flavour <  4) nameNow = "fsr:G2QQ";
-          else if (dip.flavour == 4) nameNow = "fsr:G2QQ:cc";
-          else                       nameNow = "fsr:G2QQ:bb";
+          if      (dip.flavour <  4) kernelNow = fsrG2QQ;
+          else if (dip.flavour == 4) kernelNow = fsrG2QQcc;
+          else                       kernelNow = fsrG2QQbb;
           // Optionally enhanced branching rate.
-          if (canEnhanceET) {
-            double enhance = userHooksPtr->enhanceFactor(nameNow);
-            if (enhance != 1.) {
-              enhanceNow = enhance;
-              isEnhancedG2QQ = true;
-            }
-          }
+          if (canEnhanceET)
+            enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
         }
 
         // No z weight, except threshold, if to do ME corrections later on.
@@ -2361,12 +2443,8 @@ void TimeShower::pT2nextQCD(double pT2begDip, double pT2sel,
   } while (wt < rndmPtr->flat());
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET) {
-    if (isEnhancedQ2QG) storeEnhanceFactor(dip.pT2,"fsr:Q2QG", enhanceNow);
-    if (isEnhancedG2QQ) storeEnhanceFactor(dip.pT2,"fsr:G2QQ", enhanceNow);
-    if (isEnhancedG2GG) storeEnhanceFactor(dip.pT2,"fsr:G2GG", enhanceNow);
-  }
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
 }
 
@@ -2399,10 +2477,8 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
   double alphaEM2pi  = alphaEMmax / (2. * M_PI);
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QA, isEnhancedA2LL, isEnhancedA2QQ;
-  isEnhancedQ2QA = isEnhancedA2LL = isEnhancedA2QQ = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Emission: upper estimate for matrix element weighting; charge factor.
   if (hasCharge) {
@@ -2414,7 +2490,8 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
     if (zMinAbs < SIMPLIFYROOT) zMinAbs = pT2endDip / dip.m2DipCorr;
     emitCoefTot = alphaEM2pi * chg2 * wtPSgam * log(1. / zMinAbs - 1.);
     // Optionally enhanced branching rate.
-    if (canEnhanceET) emitCoefTot *= userHooksPtr->enhanceFactor("fsr:Q2QA");
+    if (canEnhanceET)
+      emitCoefTot *= userHooksPtr->enhanceFactorByKernel(fsrQ2QA);
 
   // Branching: sum of squared charge factors for lepton and quark daughters.
   } else {
@@ -2426,8 +2503,8 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
     else if (nGammaToQuark > 0) chg2SumQ =  1. / 9.;
 
     // Optionally enhanced branching rate.
-    if (canEnhanceET) chg2SumL *= userHooksPtr->enhanceFactor("fsr:A2LL");
-    if (canEnhanceET) chg2SumQ *= userHooksPtr->enhanceFactor("fsr:A2QQ");
+    if (canEnhanceET) chg2SumL *= userHooksPtr->enhanceFactorByKernel(fsrA2LL);
+    if (canEnhanceET) chg2SumQ *= userHooksPtr->enhanceFactorByKernel(fsrA2QQ);
 
     // Total sum of squared charge factors. Find evolution coefficient.
     chg2Sum     = chg2SumL + 3. * chg2SumQ;
@@ -2443,9 +2520,8 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
 
 
     // Default values for current tentative emission.
-    isEnhancedQ2QA = isEnhancedA2LL = isEnhancedA2QQ = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Pick pT2 (in overestimated z range).
     dip.pT2 = dip.pT2 * pow(rndmPtr->flat(), 1. / emitCoefTot);
@@ -2491,35 +2567,20 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
 
 
       if (hasCharge) {
-        nameNow = "fsr:Q2QA";
+        kernelNow = fsrQ2QA;
         // Optionally enhanced branching rate.
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedQ2QA = true;
-          }
-        }
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
       } else if (dip.flavour > 10) {
-        nameNow = "fsr:A2LL";
+        kernelNow = fsrA2LL;
         // Optionally enhanced branching rate.
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedA2LL = true;
-          }
-        }
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
       } else {
-        nameNow = "fsr:A2QQ";
+        kernelNow = fsrA2QQ;
         // Optionally enhanced branching rate.
-        if (canEnhanceET) {
-          double enhance = userHooksPtr->enhanceFactor(nameNow);
-          if (enhance != 1.) {
-            enhanceNow = enhance;
-            isEnhancedA2QQ = true;
-          }
-        }
+        if (canEnhanceET)
+          enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
       }
 
       // No z weight, except threshold, if to do ME corrections later on.
@@ -2605,12 +2666,8 @@ void TimeShower::pT2nextQED(double pT2begDip, double pT2sel,
   } while (wt < rndmPtr->flat());
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET) {
-    if (isEnhancedQ2QA) storeEnhanceFactor(dip.pT2,"fsr:Q2QA", enhanceNow);
-    if (isEnhancedA2LL) storeEnhanceFactor(dip.pT2,"fsr:A2LL", enhanceNow);
-    if (isEnhancedA2QQ) storeEnhanceFactor(dip.pT2,"fsr:A2QQ", enhanceNow);
-  }
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
 }
 
@@ -2656,31 +2713,28 @@ void TimeShower::pT2nextWeak(double pT2begDip, double pT2sel,
       * pow2(2. * coupSMPtr->rf( event[dip.iRadiator].idAbs() ));
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QW;
-  isEnhancedQ2QW = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Variables used inside evolution loop.
   emitCoefTot = weakEnhancement * weakCoupling
     * wtPSgam * log(1. / zMinAbs - 1.);
   // Fudge factor to correct for weak PS not being an overestimate of ME.
-  if ( dip.MEtype == 201 || dip.MEtype == 202 || dip.MEtype == 203
-    || dip.MEtype == 206 || dip.MEtype == 207 || dip.MEtype == 208 )
+  if (dip.MEcorr.mode == TimeDipoleME::WEAKTCHANNEL)
     emitCoefTot *= WEAKPSWEIGHT;
   dip.pT2 = pT2begDip;
   double wt;
 
   // Optionally enhanced branching rate.
-  if (canEnhanceET) emitCoefTot *= userHooksPtr->enhanceFactor("fsr:Q2QW");
+  if (canEnhanceET)
+    emitCoefTot *= userHooksPtr->enhanceFactorByKernel(fsrQ2QW);
 
   // Begin evolution loop towards smaller pT values.
   do {
 
     // Default values for current tentative emission.
-    isEnhancedQ2QW = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Pick pT2 (in overestimated z range).
     dip.pT2 = dip.pT2 * pow(rndmPtr->flat(), 1. / emitCoefTot);
@@ -2717,15 +2771,10 @@ void TimeShower::pT2nextWeak(double pT2begDip, double pT2sel,
       double alphaEMnow = alphaEM.alphaEM(renormMultFac * dip.pT2);
       wt *= (alphaEMnow / alphaEMmax);
 
-      nameNow = "fsr:Q2QW";
+      kernelNow = fsrQ2QW;
       // Optionally enhanced branching rate.
-      if (canEnhanceET) {
-        double enhance = userHooksPtr->enhanceFactor(nameNow);
-        if (enhance != 1.) {
-          enhanceNow = enhance;
-          isEnhancedQ2QW = true;
-        }
-      }
+      if (canEnhanceET)
+        enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
       // Suppression factors for dipole to beam remnant.
       if (dip.isrType != 0 && useLocalRecoilNow) {
@@ -2772,9 +2821,8 @@ void TimeShower::pT2nextWeak(double pT2begDip, double pT2sel,
   } while (wt < rndmPtr->flat());
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET && isEnhancedQ2QW)
-    storeEnhanceFactor(dip.pT2,"fsr:Q2QW", enhanceNow);
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
 }
 
@@ -2806,21 +2854,19 @@ void TimeShower::pT2nextHV(double pT2begDip, double pT2sel,
   double wt;
 
   // Set default values for enhanced emissions.
-  bool isEnhancedQ2QHV;
-  isEnhancedQ2QHV = false;
-  double enhanceNow = 1.;
-  string nameNow = "";
+  double      enhanceNow = 1.;
+  SplitKernel kernelNow  = noSplit;
 
   // Optionally enhanced branching rate.
-  if (canEnhanceET) emitCoefTot *= userHooksPtr->enhanceFactor("fsr:Q2QHV");
+  if (canEnhanceET)
+    emitCoefTot *= userHooksPtr->enhanceFactorByKernel(fsrQ2QHV);
 
   // Begin evolution loop towards smaller pT values.
   do {
 
     // Default values for current tentative emission.
-    isEnhancedQ2QHV = false;
     enhanceNow = 1.;
-    nameNow = "";
+    kernelNow  = noSplit;
 
     // Pick pT2 (in overestimated z range), fixed or first-order alpha_strong.
     if (alphaHVorder == 0) {
@@ -2857,15 +2903,10 @@ void TimeShower::pT2nextHV(double pT2begDip, double pT2sel,
       else if (colvTypeAbs == 1) wt = (1. + pow2(dip.z)) / 2.;
       else wt = (1. + pow3(dip.z)) / 2.;
 
-      nameNow = "fsr:Q2QHV";
+      kernelNow = fsrQ2QHV;
       // Optionally enhanced branching rate.
-      if (canEnhanceET) {
-        double enhance = userHooksPtr->enhanceFactor(nameNow);
-        if (enhance != 1.) {
-          enhanceNow = enhance;
-          isEnhancedQ2QHV = true;
-        }
-      }
+      if (canEnhanceET)
+        enhanceNow = userHooksPtr->enhanceFactorByKernel(kernelNow);
 
     }
 
@@ -2877,9 +2918,8 @@ void TimeShower::pT2nextHV(double pT2begDip, double pT2sel,
   } while (wt < rndmPtr->flat());
 
   // Store outcome of enhanced branching rate analysis.
-  splittingNameNow = nameNow;
-  if (canEnhanceET && isEnhancedQ2QHV)
-    storeEnhanceFactor(dip.pT2,"fsr:Q2QHV", enhanceNow);
+  splitKernelNow = kernelNow;
+  enhanceFacNow  = enhanceNow;
 
 }
 
@@ -2892,6 +2932,10 @@ void TimeShower::pT2nextHV(double pT2begDip, double pT2sel,
 
 bool TimeShower::branch( Event& event, bool isInterleaved) {
 
+  // The trial emission of the selected dipole end is used up.
+  if (iDipSel >= 0 && iDipSel < int(dipTrial.size()))
+    dipTrial[iDipSel].isValid = false;
+
   // Check if this system is part of the hard scattering
   // (including resonance decay products).
   bool hardSystem = true;
@@ -2987,9 +3031,7 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
   // Find old incoming momenta for weak shower t-channel ME correction.
   Vec4 p3weak = event[3].p();
   Vec4 p4weak = event[4].p();
-  if ( dipSel->MEtype == 201 || dipSel->MEtype == 202
-    || dipSel->MEtype == 203 || dipSel->MEtype == 206
-    || dipSel->MEtype == 207 || dipSel->MEtype == 208) {
+  if (dipSel->MEcorr.mode == TimeDipoleME::WEAKTCHANNEL) {
     if (!weakExternal) {
       // Trace back to original mother. MPI not allowed to radiate weakly.
       int i2to2Mother = iRadBef;
@@ -3400,19 +3442,11 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
   // Calculate event weight for enhanced emission rate.
   if (canEnhanceET) {
     // Check if emission weight was enhanced. Get enhance weight factor.
-    bool foundEnhance = false;
-    // Move backwards as last elements have highest pT, thus are chosen
-    // splittings.
-    for ( map<double,pair<string,double> >::reverse_iterator
-          it = enhanceFactors.rbegin();
-          it != enhanceFactors.rend(); ++it ){
-      if (splittingNameSel.find(it->second.first) != string::npos
-        && abs(it->second.second-1.0) > 1e-9) {
-        foundEnhance = true;
-        weight       = it->second.second;
-        vp           = userHooksPtr->vetoProbability(splittingNameSel);
-        break;
-      }
+    bool foundEnhance = (splitKernelSel != noSplit
+      && abs(enhanceFacSel - 1.0) > 1e-9);
+    if (foundEnhance) {
+      weight       = enhanceFacSel;
+      vp           = userHooksPtr->vetoProbabilityByKernel(splitKernelSel);
     }
 
     // Check emission veto.
@@ -3422,8 +3456,8 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
     if (foundEnhance && vetoedEnhancedEmission) rwgt *= (1.-1./weight)/vp;
     else if (foundEnhance) rwgt *= 1./((1.-vp)*weight);
 
-    // Reset enhance factors after usage.
-    enhanceFactors.clear();
+    // Reset enhance factor after usage.
+    enhanceFacSel = 1.;
 
     // Set events weights, so that these could be used externally.
     double wtOld = userHooksPtr->getEnhancedEventWeight();
@@ -3500,6 +3534,9 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
   // Update number of splittings that have been produced with global recoil.
   if ( !useLocalRecoilNow ) ++nGlobal;
 
+  // Dipole ends added below have their ME corrections precompiled after.
+  int dipEndSizeBeg = dipEnd.size();
+
   // Photon emission: update to new dipole ends; add new photon "dipole".
   if (dipSel->flavour == 22) {
     dipSel->iRadiator = iRad;
@@ -3521,6 +3558,7 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
     dipSel->pTmax      = pTsel;
     // Optionally also kill ME corrections after first emission.
     if (!doMEafterFirst) dipSel->MEtype = 0;
+    setupMEcorr( *dipSel);
     // PS dec 2010: check normalization of radiating dipole
     // Dipole corresponding to the newly created colour tag has normal strength
     double flexFactor  = (isFlexible) ? dipSel->flexFactor : 1.0;
@@ -3532,6 +3570,7 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
         dipEnd[i].iRecoiler = iEmt;
         // Optionally also kill ME corrections after first emission.
         if (!doMEafterFirst) dipEnd[i].MEtype = 0;
+        setupMEcorr( dipEnd[i]);
         // Strive to match colour to anticolour inside closed system.
         if ( !isFlexible && dipEnd[i].colType * dipSel->colType > 0)
           dipEnd[i].iRecoiler = iRad;
@@ -3581,6 +3620,7 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
         // Note: gluino -> quark + squark gives a deeper radiation dip than
         // the more obvious alternative photon decay, so is more realistic.
         dipEnd[i].MEtype = (doMEcorrections && doMEafterFirst) ? 66 : 0;
+        setupMEcorr( dipEnd[i]);
         if (&dipEnd[i] == dipSel) dipEnd[i].iMEpartner = iRad;
         else                      dipEnd[i].iMEpartner = iEmt;
       }
@@ -3687,6 +3727,10 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
       for (int i = 0; i < int(dipEnd.size()); ++i) dipEnd[i].weakType = 0;
   }
 
+  // Precompile the ME corrections of the new dipole ends.
+  for (int iDip = dipEndSizeBeg; iDip < int(dipEnd.size()); ++iDip)
+    setupMEcorr( dipEnd[iDip]);
+
   // Copy or set lifetime for new final state.
   if (event[iRad].id() == event[iRadBef].id()) {
     event[iRad].tau( event[iRadBef].tau() );
@@ -3708,6 +3752,7 @@ bool TimeShower::branch( Event& event, bool isInterleaved) {
           dipEnd[i].colType = 2;
         if (dipEnd[i].colType ==-1 && dipSel->flavour == 21)
           dipEnd[i].colType =-2;
+        setupMEcorr( dipEnd[i]);
       }
     }
     if (dipEnd[i].iRadiator  == iRadBef) dipEnd[i].iRadiator  = iRad;
@@ -3900,6 +3945,12 @@ bool TimeShower::initUncertainties() {
       if (nRecognizedQCD > 0) ++nVarQCD;
     } // End loop over UVars.
   }
+
+  // Copy the variations to contiguous arrays, for faster evaluation.
+  uVarG2GGmuR.init( varG2GGmuRfac);  uVarG2GGcNS.init( varG2GGcNS);
+  uVarQ2QGmuR.init( varQ2QGmuRfac);  uVarQ2QGcNS.init( varQ2QGcNS);
+  uVarX2XGmuR.init( varX2XGmuRfac);  uVarX2XGcNS.init( varX2XGcNS);
+  uVarG2QQmuR.init( varG2QQmuRfac);  uVarG2QQcNS.init( varG2QQcNS);
   infoPtr->initUncertainties(&uVars);
   // Let the calling function know if we found anything.
   return (nUncertaintyVariations > 0);
@@ -3919,20 +3970,19 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
     return;
 
   // Define pointer and iterator to loop over the contents of each
-  // (iWeight,value) map.
+  // (iWeight,value) map, and to the arrays of each kind of variation.
   map<int,double>* varPtr=0;
   map<int,double>::iterator itVar;
-  // Make sure we have a dummy to point to if no map to be used.
-  map<int,double> dummy;     dummy.clear();
+  VariationList* uVarPtr = 0;
 
   int numWeights = infoPtr->nWeights();
   // Store uncertainty variation factors, initialised to unity.
   // Make vector sizes + 1 since 0 = default and variations start at 1.
-  vector<double> uVarFac(numWeights, 1.0);
-  vector<bool> doVar(numWeights, false);
+  uVarFac.assign( numWeights, 1.0);
+  doVar.assign( numWeights, 0);
 
   // For the case of biasing, the nominal weight might not be unity.
-  doVar[0] = true;
+  doVar[0] = 1;
   uVarFac[0] = 1.0;
 
   // Extract relevant quantities.
@@ -3943,25 +3993,22 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
   if (dip->colType != 0) {
 
     // QCD renormalization-scale variations.
-    if (alphaSorder == 0) varPtr = &dummy;
-    else if (idEmt == 21 && idRad == 21) varPtr = &varG2GGmuRfac;
+    if (alphaSorder == 0) uVarPtr = 0;
+    else if (idEmt == 21 && idRad == 21) uVarPtr = &uVarG2GGmuR;
     else if (idEmt == 21 && abs(idRad) <= uVarNflavQ)
-      varPtr = &varQ2QGmuRfac;
-    else if (idEmt == 21) varPtr = &varX2XGmuRfac;
+      uVarPtr = &uVarQ2QGmuR;
+    else if (idEmt == 21) uVarPtr = &uVarX2XGmuR;
     else if (abs(idRad) <= nGluonToQuark && abs(idEmt) <= nGluonToQuark)
-      varPtr = &varG2QQmuRfac;
-    else varPtr = &dummy;
-    for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
-      int iWeight   = itVar->first;
-      double valFac = itVar->second;
+      uVarPtr = &uVarG2QQmuR;
+    else uVarPtr = 0;
+    if (uVarPtr != 0 && uVarPtr->size() > 0) {
       double muR2 = renormMultFac * dip->pT2;
       double alphaSbaseline = alphaS.alphaS(muR2);
-      // Correction-factor alphaS.
-      double muR2var = max(1.1 * Lambda3flav2, pow2(valFac) * muR2);
-      double alphaSratio = alphaS.alphaS(muR2var) / alphaSbaseline;
+      double muR2min        = 1.1 * Lambda3flav2;
       // Apply soft correction factor to X2XG.
-      double facCorr = 1.;
-      if (idEmt == 21 && uVarMuSoftCorr) {
+      bool   doSoftCorr = (idEmt == 21 && uVarMuSoftCorr);
+      double facSoftZ   = 0.;
+      if (doSoftCorr) {
         // Use smallest alphaS and b0, to make the compensation conservative.
         int nf = 5;
         if (dip->pT2 < pow2(mc)) nf = 3;
@@ -3970,37 +4017,39 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
         double facSoft    = alphaScorr * (33. - 2. * nf) / (6. * M_PI);
         double zeta = 1. - dip->z;
         if (idRad == 21) zeta = min(dip->z, 1. - dip->z);
-        facCorr = 1. + (1. - zeta) * facSoft * log(valFac);
+        facSoftZ = (1. - zeta) * facSoft;
+      }
+      // Limits of the absolute variation to +/- deltaAlphaSmax.
+      double facMax = (alphaSbaseline + dASmax) / alphaSbaseline;
+      double facMin = (alphaSbaseline - dASmax) / alphaSbaseline;
+      bool   hasMin = (alphaSbaseline > dASmax);
+      // Correction-factor alphaS for each variation.
+      VariationList& uVar = *uVarPtr;
+      for (int j = 0; j < uVar.size(); ++j) {
+        double muR2var = max(muR2min, pow2(uVar.value[j]) * muR2);
+        double alphaSfac = alphaS.alphaS(muR2var) / alphaSbaseline;
+        if (doSoftCorr) alphaSfac *= 1. + facSoftZ * uVar.logValue[j];
+        if (alphaSfac > 1.) alphaSfac = min(alphaSfac, facMax);
+        else if (hasMin) alphaSfac = max(alphaSfac, facMin);
+        uVar.fac[j] = alphaSfac;
       }
-      // Apply correction factor here for emission processes.
-      double alphaSfac   = alphaSratio * facCorr;
-      // Limit absolute variation to +/- deltaAlphaSmax.
-      if (alphaSfac > 1.)
-        alphaSfac = min(alphaSfac, (alphaSbaseline + dASmax) / alphaSbaseline);
-      else if (alphaSbaseline > dASmax)
-        alphaSfac = max(alphaSfac, (alphaSbaseline - dASmax) / alphaSbaseline);
-      uVarFac[iWeight] *= alphaSfac;
-      doVar[iWeight] = true;
+      uVar.apply( uVarFac, doVar);
     }
 
     // QCD finite-term variations (only when no MECs and above pT threshold).
-    if (dip->MEtype != 0 || dip->pT2 < pow2(cNSpTmin) ) varPtr = &dummy;
-    else if (idEmt == 21 && idRad == 21) varPtr = &varG2GGcNS;
-    else if (idEmt == 21 && abs(idRad) <= uVarNflavQ) varPtr = &varQ2QGcNS;
-    else if (idEmt == 21) varPtr = &varX2XGcNS;
+    if (dip->MEtype != 0 || dip->pT2 < pow2(cNSpTmin) ) uVarPtr = 0;
+    else if (idEmt == 21 && idRad == 21) uVarPtr = &uVarG2GGcNS;
+    else if (idEmt == 21 && abs(idRad) <= uVarNflavQ) uVarPtr = &uVarQ2QGcNS;
+    else if (idEmt == 21) uVarPtr = &uVarX2XGcNS;
     else if (abs(idRad) <= nGluonToQuark && abs(idEmt) <= nGluonToQuark)
-      varPtr = &varG2QQcNS;
-    else varPtr = &dummy;
-    for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
-      int iWeight   = itVar->first;
-      double valFac = itVar->second;
-      // Correction-factor alphaS.
+      uVarPtr = &uVarG2QQcNS;
+    else uVarPtr = 0;
+    if (uVarPtr != 0 && uVarPtr->size() > 0) {
       double z   = dip->z;
       double Q2  = dip->m2;
       // Virtuality for massive radiators.
       if (abs(idRad) >= 4 && idRad != 21) Q2 = max(1., Q2-radPtr->m2());
       double yQ  = Q2 / dip->m2Dip;
-      double num = yQ * valFac;
       double denom = 1.;
       // G->GG.
       if (idEmt == 21 && idRad == 21)
@@ -4011,9 +4060,11 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
       // G->QQ.
       else
           denom = pow2(z) + pow2(1. - z);
-      // Compute reweight ratio.
-      uVarFac[iWeight] *= 1. + num / denom;
-      doVar[iWeight] = true;
+      // Compute reweight ratio for each variation.
+      VariationList& uVar = *uVarPtr;
+      for (int j = 0; j < uVar.size(); ++j)
+        uVar.fac[j] = 1. + yQ * uVar.value[j] / denom;
+      uVar.apply( uVarFac, doVar);
     }
 
     // PDF variations for dipoles that connect to the initial state.
@@ -4040,7 +4091,7 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
           int iWeight   = itVar->first;
           uVarFac[iWeight] *= 1.0 + min(ratioPDFEnv.errplusPDF
             / ratioPDFEnv.centralPDF,0.5);
-          doVar[iWeight] = true;
+          doVar[iWeight] = 1;
         }
         //
         varPtr = varPDFminus;
@@ -4048,7 +4099,7 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
           int iWeight   = itVar->first;
           uVarFac[iWeight] *= max(.01,1.0 - min(ratioPDFEnv.errminusPDF
             / ratioPDFEnv.centralPDF,0.5));
-          doVar[iWeight] = true;
+          doVar[iWeight] = 1;
         }
         varPtr = varPDFmember;
         for (itVar = varPtr->begin(); itVar != varPtr->end(); ++itVar) {
@@ -4056,7 +4107,7 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
           int member    = int( itVar->second );
           uVarFac[iWeight] *= max(.01,ratioPDFEnv.pdfMemberVars[member]
             / ratioPDFEnv.centralPDF);
-          doVar[iWeight] = true;
+          doVar[iWeight] = 1;
         }
       }
     }
@@ -4065,25 +4116,29 @@ void TimeShower::calcUncertainties(bool accept, double pAccept, double enhance,
 
   // Ensure 0 < PacceptPrime < 1 (with small margins).
   // Skip the central weight, so as to avoid confusion
-  for (int iWeight = 1; iWeight<=nUncertaintyVariations; ++iWeight) {
-    if (!doVar[iWeight]) continue;
-    double pAcceptPrime = pAccept * uVarFac[iWeight];
-    if (pAcceptPrime > PROBLIMIT && dip->colType != 0) {
-      uVarFac[iWeight] *= PROBLIMIT / pAcceptPrime;
+  if (dip->colType != 0) {
+    for (int iWeight = 1; iWeight<=nUncertaintyVariations; ++iWeight) {
+      if (!doVar[iWeight]) continue;
+      double pAcceptPrime = pAccept * uVarFac[iWeight];
+      if (pAcceptPrime > PROBLIMIT)
+        uVarFac[iWeight] *= PROBLIMIT / pAcceptPrime;
     }
   }
 
-  // Apply reject or accept reweighting factors according to input decision.
-  for (int iWeight = 0; iWeight <= nUncertaintyVariations; ++iWeight) {
-    if (!doVar[iWeight]) continue;
-    // If trial accepted: apply ratio of accept probabilities.
-    if (accept) infoPtr->reWeight(iWeight,
-      uVarFac[iWeight] / ((1.0 - vp) * enhance) );
-    // If trial rejected : apply Sudakov reweightings.
-    else {
-      // Check for near-singular denominators (indicates too few failures,
-      // and hence would need to increase headroom).
-      double denom = 1. - pAccept*(1.0 - vp);
+  // If trial accepted: apply ratio of accept probabilities.
+  if (accept) {
+    double normAcc = (1.0 - vp) * enhance;
+    for (int iWeight = 0; iWeight <= nUncertaintyVariations; ++iWeight)
+      if (doVar[iWeight]) infoPtr->reWeight(iWeight, uVarFac[iWeight]
+        / normAcc);
+
+  // If trial rejected : apply Sudakov reweightings.
+  } else {
+    // Check for near-singular denominators (indicates too few failures,
+    // and hence would need to increase headroom).
+    double denom = 1. - pAccept*(1.0 - vp);
+    for (int iWeight = 0; iWeight <= nUncertaintyVariations; ++iWeight) {
+      if (!doVar[iWeight]) continue;
       if (denom < REJECTFACTOR) {
         stringstream message;
         message << iWeight;
@@ -4773,17 +4828,89 @@ double TimeShower::gammaZmix( Event& event, int iRes, int iDau1, int iDau2) {
 
 //--------------------------------------------------------------------------
 
+// Precompile how the ME correction of a dipole end is to be evaluated,
+// so that findMEcorr need not redo the classification for each trial.
+
+void TimeShower::setupMEcorr( TimeDipoleEnd& dip) {
+
+  // Default is no correction, i.e. unit weight.
+  TimeDipoleME& me = dip.MEcorr;
+  me.mode   = TimeDipoleME::NOCORR;
+  if (dip.MEtype <= 0) return;
+
+  // QCD and Hidden Valley dipoles: kind and combination from MEtype.
+  int kind  = 0;
+  int combi = 1;
+  if (dip.colType != 0 || dip.colvType != 0) {
+    me.mode = TimeDipoleME::QCD;
+    kind    = dip.MEtype / 5;
+    combi   = dip.MEtype % 5;
+
+  // Charge dipoles: generic charges, or vector source with masses.
+  } else if (dip.chgType != 0 && dip.MEtype == 101) {
+    me.mode = TimeDipoleME::QEDCHARGE;
+  } else if (dip.chgType != 0 && dip.MEtype == 102) {
+    me.mode = TimeDipoleME::QEDVECTOR;
+    kind    = 2;
+
+  // Weak s-channel emissions, and t-channel ones done in findMEcorrWeak.
+  } else if (dip.MEtype == 200 || dip.MEtype == 205) {
+    me.mode = TimeDipoleME::WEAKSCHANNEL;
+    kind    = 32;
+  } else if (dip.MEtype == 201 || dip.MEtype == 202 || dip.MEtype == 203
+    || dip.MEtype == 206 || dip.MEtype == 207 || dip.MEtype == 208)
+    me.mode = TimeDipoleME::WEAKTCHANNEL;
+
+  // Expressions and coupling weights to use.
+  setMEcoef( me, kind, combi, dip.MEmix);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set the ME kind, and translate the combination and mixing of vector
+// and axial parts into the expressions and weights used by calcMEcorr.
+
+void TimeShower::setMEcoef( TimeDipoleME& me, int kind, int combiIn,
+  double mixIn) {
+
+  // Allowed combination and mixing.
+  int    combi = max(1, min(4, combiIn) );
+  double mix   = max(0., min(1., mixIn) );
+  me.kind      = kind;
+
+  // Kinds with vector, axial and combined expressions use them as asked,
+  // those with only a vector or a single one always use that.
+  int exprs    = (kind >= 0 && kind < NMEKIND) ? MEKINDEXPR[kind] : 0;
+  me.expr      = (exprs == 7) ? combi : exprs;
+  me.wt1       = mix;
+  me.wt2       = 1. - mix;
+
+  // Offset of the eikonal expressions.
+  me.offset    = 0.;
+  if      (combi == 2) me.offset = 1.;
+  else if (combi == 3) me.offset = mix;
+  else if (combi == 4) me.offset = 0.5;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Set up to calculate QCD ME correction with calcMEcorr.
 // Normally for primary particles, but also from g/gamma -> f fbar.
 
 double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
   Particle& partner, Particle& emt, bool cutEdge) {
 
-  // Initial values and matrix element kind.
+  // Precompiled ME correction. The t-channel weak corrections are
+  // handled separately in findMEcorrWeak.
+  const TimeDipoleME& me = dip->MEcorr;
+  if (me.mode == TimeDipoleME::NOCORR
+    || me.mode == TimeDipoleME::WEAKTCHANNEL) return 1.;
+
+  // Initial values.
   double wtME    = 1.;
   double wtPS    = 1.;
-  int    MEkind  = dip->MEtype / 5;
-  int    MEcombi = dip->MEtype % 5;
 
   // Construct ME variables.
   Vec4   sum     = rad.p() + partner.p() + emt.p();
@@ -4801,7 +4928,7 @@ double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
     double x3Tmp    = 2. - x1 - x2;
     gammavCorr      = x3Tmp / (x3Tmp - kRad * (x1 + x3Tmp));
     // For Q_v Qbar_v pair correct kinematics to common average mass.
-    if (MEkind == 31) {
+    if (me.kind == 31) {
       double m2Pair = (rad.p() + partner.p()).m2Calc();
       double m2Avg  = 0.5 * (rad.m2() + partner.m2())
                     - 0.25 * pow2(rad.m2() - partner.m2()) / m2Pair;
@@ -4826,13 +4953,11 @@ double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
   }
 
   // Begin processing of QCD dipoles.
-  if (dip->colType !=0 || dip->colvType != 0) {
+  if (me.mode == TimeDipoleME::QCD) {
 
     // Evaluate normal ME, for proper order of particles.
-    if (dip->MEorder) wtME = calcMEcorr(MEkind, MEcombi, dip->MEmix,
-      x1, x2, r1, r2, r3, cutEdge);
-    else wtME = calcMEcorr(MEkind, MEcombi, dip->MEmix,
-      x2, x1, r2, r1, r3, cutEdge);
+    if (dip->MEorder) wtME = calcMEcorr(me, x1, x2, r1, r2, r3, cutEdge);
+    else wtME = calcMEcorr(me, x2, x1, r2, r1, r3, cutEdge);
 
     // Split up total ME when two radiating particles.
     if (dip->MEsplit) wtME = wtME * x1minus / x3;
@@ -4844,7 +4969,7 @@ double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
 
   // For generic charge combination currently only massless expression.
   // (Masses included only to respect phase space boundaries.)
-  } else if (dip->chgType !=0 && dip->MEtype == 101) {
+  } else if (me.mode == TimeDipoleME::QEDCHARGE) {
     double chg1 = particleDataPtr->charge(rad.id());
     double chg2 = particleDataPtr->charge(partner.id());
     wtME = (x1*x1 + x2*x2) * pow2( chg1 * x1minus / x3
@@ -4852,25 +4977,19 @@ double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
     wtPS = 2. * ( chg1*chg1 * x1minus / x3 + chg2*chg2 * x2minus / x3 );
 
   // For flavour neutral system assume vector source and include masses.
-  } else if (dip->chgType !=0 && dip->MEtype == 102) {
-    wtME = calcMEcorr(2, 1, dip->MEmix, x1, x2, r1, r2, 0., cutEdge)
-      * x1minus / x3;
+  } else if (me.mode == TimeDipoleME::QEDVECTOR) {
+    wtME = calcMEcorr(me, x1, x2, r1, r2, 0., cutEdge) * x1minus / x3;
     wtPS = 2. / ( x3 * x2minus );
   }
 
   // Weak W and Z emissions, currently using same matrix element.
   // The s-channel corrections are handled with simple MEs.
-  else if (dip->MEtype == 200 || dip->MEtype == 205) {
+  else if (me.mode == TimeDipoleME::WEAKSCHANNEL) {
     r3   = emt.m() / eCMME;
-    wtME = calcMEcorr(32, 1, dip->MEmix, x1, x2, r1, r2, r3, cutEdge)
-      * x1minus / x3;
+    wtME = calcMEcorr(me, x1, x2, r1, r2, r3, cutEdge) * x1minus / x3;
     wtPS = 8. / (x3 * x2minus);
     wtPS *= x3 / (x3 - kRad * (x1 + x3));
   }
-  // The t-channel corrections are handled separately in findMEweak.
-  else if (dip->MEtype == 201 || dip->MEtype == 202
-       ||  dip->MEtype == 203 || dip->MEtype == 205
-       ||  dip->MEtype == 206 || dip->MEtype == 207) return 1.;
 
   // Return ratio of actual ME to assumed PS rate of emission.
   if (wtME > wtPS) infoPtr->errorMsg("Warning in TimeShower::findMEcorr: "
@@ -4911,11 +5030,13 @@ double TimeShower::findMEcorr(TimeDipoleEnd* dip, Particle& rad,
 //       = 2 : pure gamma5, i.e. axial vector/pseudoscalar/....
 //       = 3 : mixture mix*(combi=1) + (1-mix)*(combi=2)
 //       = 4 : mixture (combi=1) +- (combi=2)
+// Kind and combination are precompiled per dipole end, see setMEcoef.
 
-double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
-  double x1, double x2, double r1, double r2, double r3, bool cutEdge) {
+double TimeShower::calcMEcorr( const TimeDipoleME& me, double x1,
+  double x2, double r1, double r2, double r3, bool cutEdge) {
 
   // Frequent variable combinations.
+  int    kind   = me.kind;
   double x3     = 2. - x1 - x2;
   double x1s    = x1 * x1;
   double x2s    = x2 * x2;
@@ -4959,16 +5080,14 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
     }
   }
 
-  // Initial values; phase space.
-  int combi   = max(1, min(4, combiIn) );
-  double mix  = max(0., min(1., mixIn) );
-  bool isSet1 = false;
-  bool isSet2 = false;
-  bool isSet4 = false;
+  // Expressions to evaluate; phase space.
+  bool doExpr1 = (me.expr == 1 || me.expr == 3);
+  bool doExpr2 = (me.expr == 2 || me.expr == 3);
+  bool doExpr4 = (me.expr == 4);
   double ps = sqrtpos( pow2(1. - r1*r1 - r2*r2) - pow2(2. * r1 * r2) );
   double rLO = 0., rFO = 0., rLO1 = 0., rFO1 = 0., rLO2 = 0.,
     rFO2 = 0., rLO4 = 0., rFO4 = 0.;
-  double offset = 0;
+  double offset = me.offset * x3s;
 
   // Select which kind of ME to use.
   switch (kind) {
@@ -4977,7 +5096,7 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
 
     // V -> q qbar (V = gamma*/Z0/W+-/...).
     case 2:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(2.-r1s-r1q+6.*r1*r2-r2s+2.*r1s*r2s-r2q)/2.;
         rFO1 = -(3.+6.*r1s+r1q-6.*r1*r2+6.*r1c*r2-2.*r2s-6.*r1s*r2s
         +6.*r1*r2c+r2q-3.*x1+6.*r1*r2*x1+2.*r2s*x1+x1s-2.*r1s*x1s
@@ -4995,9 +5114,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -2.*r2s*x1s-r1s*x3+r2s*x3-r1s*x1*x3+r2s*x1*x3+x1s*x3+x2)
         /prop1s;
         rFO1 = rFO1/2.;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(2.-r1s-r1q-6.*r1*r2-r2s+2.*r1s*r2s-r2q)/2.;
         rFO2 = -(3.+6.*r1s+r1q+6.*r1*r2-6.*r1c*r2-2.*r2s-6.*r1s*r2s
         -6.*r1*r2c+r2q-3.*x1-6.*r1*r2*x1+2.*r2s*x1+x1s-2.*r1s*x1s
@@ -5014,9 +5132,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -2.*r2s*x1s-r1s*x3+r2s*x3-r1s*x1*x3+r2s*x1*x3+x1s*x3+x2)
         /prop1s;
         rFO2 = rFO2/2.;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(2.-r1s-r1q-r2s+2.*r1s*r2s-r2q)/2.;
         rFO4 = (1.-r1q+6.*r1s*r2s-r2q+x1+3.*r1s*x1-9.*r2s*x1-3.*x1s
         -r1s*x1s+3.*r2s*x1s+x1c-x2-r1s*x2+r2s*x2-r1s*x1*x2+r2s*x1*x2
@@ -5030,13 +5147,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +x1*x2s+x2c)
         /prop2s;
         rFO4 = rFO4/2.;
-        isSet4 = true;
       }
       break;
 
     // q -> q V.
     case 3:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-2.*r1s+r1q+r2s-6.*r1*r2s+r1s*r2s-2.*r2q);
         rFO1 = -2.*(-1.+r1-2.*r1s+2.*r1c-r1q+pow5(r1)-r2s+r1*r2s
         -5.*r1s*r2s+r1c*r2s-2.*r1*r2q+2.*x1-2.*r1*x1+2.*r1s*x1
@@ -5056,9 +5172,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +r1s*r2s*x2-2.*r2q*x2-9.*x1*x2-3.*r1s*x1*x2+2.*r2s*x1*x2
         +2.*x1s*x2-3.*x2s-r1s*x2s+2.*r2s*x2s+x1*x2s)
         /x3s;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-2.*r1s+r1q+r2s+6.*r1*r2s+r1s*r2s-2.*r2q);
         rFO2 = 2*(1.+r1+2.*r1s+2.*r1c+r1q+pow5(r1)+r2s+r1*r2s
         +5.*r1s*r2s+r1c*r2s-2.*r1*r2q-2.*x1-2.*r1*x1-2.*r1s*x1
@@ -5078,9 +5193,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +r1s*r2s*x2-2.*r2q*x2-9.*x1*x2-3.*r1s*x1*x2+2.*r2s*x1*x2
         +2.*x1s*x2-3.*x2s-r1s*x2s+2.*r2s*x2s+x1*x2s)
         /x3s;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-2.*r1s+r1q+r2s+r1s*r2s-2.*r2q);
         rFO4 = 2*(1.+2.*r1s+r1q+r2s+5.*r1s*r2s-2.*x1-2.*r1s*x1
         -2.*r2s*x1-r1s*r2s*x1-2.*r2q*x1+x1s+r2s*x1s-3.*x2-4.*r1s*x2
@@ -5097,13 +5211,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -3.*r1s*x1*x2+2.*r2s*x1*x2+2.*x1s*x2-3.*x2s-r1s*x2s+2.*r2s*x2s
         +x1*x2s)
         /x3s;
-        isSet4 = true;
       }
       break;
 
     // S -> q qbar    (S = h0/H0/A0/H+-/...).
     case 4:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-r1s-r2s-2.*r1*r2);
         rFO1 = -(-1.+r1q-2.*r1*r2-2.*r1c*r2-6.*r1s*r2s-2.*r1*r2c+r2q+x1
         -r1s*x1+2.*r1*r2*x1+3.*r2s*x1+x2+r1s*x2-r2s*x2-x1*x2)
@@ -5114,9 +5227,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -(-1.+r1q-2.*r1*r2-2.*r1c*r2-6.*r1s*r2s-2.*r1*r2c+r2q+x1-r1s*x1
         +r2s*x1+x2+3.*r1s*x2+2.*r1*r2*x2-r2s*x2-x1*x2)
         /prop2s;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-r1s-r2s+2.*r1*r2);
         rFO2 = -(-1.+r1q+2.*r1*r2+2.*r1c*r2-6.*r1s*r2s+2.*r1*r2c+r2q+x1
         -r1s*x1-2.*r1*r2*x1+3.*r2s*x1+x2+r1s*x2-r2s*x2-x1*x2)
@@ -5127,9 +5239,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +2.*(-r1s-r1q-2.*r1c*r2-r2s+6.*r1s*r2s-2.*r1*r2c-r2q+r1s*x1
         +r1*r2*x1-2.*r2s*x1-2.*r1s*x2+r1*r2*x2+r2s*x2+x1*x2)
         /prop12;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-r1s-r2s);
         rFO4 = -(-1.+r1q-6.*r1s*r2s+r2q+x1-r1s*x1+3.*r2s*x1+x2
         +r1s*x2-r2s*x2-x1*x2)
@@ -5140,13 +5251,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -(-1.+r1q-6.*r1s*r2s+r2q+x1-r1s*x1+r2s*x1
         +x2+3.*r1s*x2-r2s*x2-x1*x2)
         /prop2s;
-        isSet4 = true;
       }
       break;
 
     // q -> q S.
     case 5:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.+r1s-r2s+2.*r1);
         rFO1 = (4.-4.*r1s+4.*r2s-3.*x1-2.*r1*x1+r1s*x1-r2s*x1-5.*x2
         -2.*r1*x2+r1s*x2-r2s*x2+x1*x2+x2s)
@@ -5157,9 +5267,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.-2.*r1-6.*r1s-2.*r1c+2.*r2s-2.*r1*r2s-x1+r1s*x1
         -r2s*x1-3.*x2+2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)
         /prop2s;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.+r1s-r2s-2.*r1);
         rFO2 = (4.-4.*r1s+4.*r2s-3.*x1+2.*r1*x1+r1s*x1-r2s*x1-5.*x2
         +2.*r1*x2+r1s*x2-r2s*x2+x1*x2+x2s)
@@ -5170,9 +5279,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.+2.*r1-6.*r1s+2.*r1c+2.*r2s+2.*r1*r2s-x1+r1s*x1
         -r2s*x1-3.*x2-2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)
         /prop2s;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.+r1s-r2s);
         rFO4 = (4.-4.*r1s+4.*r2s-3.*x1+r1s*x1-r2s*x1-5.*x2+r1s*x2
         -r2s*x2+x1*x2+x2s)
@@ -5183,7 +5291,6 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.-6.*r1s+2.*r2s-x1+r1s*x1-r2s*x1-3.*x2+3.*r1s*x2
         -r2s*x2+x1*x2+x2s)
         /prop2s;
-        isSet4 = true;
       }
       break;
 
@@ -5202,7 +5309,6 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
       +6.*r2s*x1-2.*x1s+2.*x2+6.*r1s*x2+6.*r2s*x2-4.*x1*x2
       -2.*r1s*x1*x2-2.*r2s*x1*x2+x1s*x2-2.*x2s+x1*x2s)
       /prop12;
-      isSet1 = true;
       break;
 
     // ~q -> ~q V.
@@ -5222,7 +5328,6 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
       -4.*r2s*x1+x1s-3.*x2-3.*r1s*x2-3.*r2s*x2+3.*x1*x2+2.*x2s)
       /(3.*x3);
       rFO1 = 3.*rFO1/8.;
-      isSet1 = true;
       break;
 
     // S -> ~q ~qbar.
@@ -5233,7 +5338,6 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
       -r1s*x1*x2-r2s*x1*x2+x1s*x2-x2s-r1s*x2s+x1*x2s)
       /(prop1s*prop2s);
       rFO1 = 2.*rFO1;
-      isSet1 = true;
       break;
 
     // ~q -> ~q S.
@@ -5245,12 +5349,11 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
       /prop23
       -(x1+x2)
       /x3s;
-      isSet1 = true;
       break;
 
     // chi -> q ~qbar   (chi = neutralino/chargino).
     case 10:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.+r1s-r2s+2.*r1);
         rFO1 = (2.*r1+x1)*(-1.-r1s-r2s+x1)
         /prop1s
@@ -5260,9 +5363,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.-2.*r1-6.*r1s-2.*r1c+2.*r2s-2.*r1*r2s-x1+r1s*x1
         -r2s*x1-3.*x2+2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)
         /prop2s;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-2.*r1+r1s-r2s);
         rFO2 = (2.*r1-x1)*(1.+r1s+r2s-x1)
         /prop1s
@@ -5272,9 +5374,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.+2.*r1-6.*r1s+2.*r1c+2.*r2s+2.*r1*r2s-x1+r1s*x1
         -r2s*x1-3.*x2-2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)/
         prop2s;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.+r1s-r2s);
         rFO4 = x1*(-1.-r1s-r2s+x1)
         /prop1s
@@ -5284,13 +5385,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(2.-6.*r1s+2.*r2s-x1+r1s*x1-r2s*x1-3.*x2+3.*r1s*x2
         -r2s*x2+x1*x2+x2s)
         /prop2s;
-        isSet4 = true;
       }
       break;
 
     // ~q -> q chi.
     case 11:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-pow2(r1+r2));
         rFO1 = (1.+r1s+2.*r1*r2+r2s-x1-x2)*(x1+x2)
         /x3s
@@ -5300,9 +5400,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(-1.-2.*r1s-r1q-2.*r1*r2-2.*r1c*r2+2.*r1*r2c+r2q+x1+r1s*x1
         -2.*r1*r2*x1-3.*r2s*x1+2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /prop23;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-pow2(r1-r2));
         rFO2 = (1.+r1s-2.*r1*r2+r2s-x1-x2)*(x1+x2)
         /x3s
@@ -5312,9 +5411,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(-1.-2.*r1s-r1q+2.*r1*r2+2.*r1c*r2-2.*r1*r2c+r2q+x1+r1s*x1
         +2.*r1*r2*x1-3.*r2s*x1+2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /prop23;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-r1s-r2s);
         rFO4 = (1.+r1s+r2s-x1-x2)*(x1+x2)
         /x3s
@@ -5324,13 +5422,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +(-1.-2.*r1s-r1q+r2q+x1+r1s*x1-3.*r2s*x1
         +2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /prop23;
-        isSet4 = true;
       }
       break;
 
     // q -> ~q chi.
     case 12:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-r1s+r2s+2.*r2);
         rFO1 = (2.*r2+x2)*(-1.-r1s-r2s+x2)
         /prop2s
@@ -5340,9 +5437,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +2.*(-1.-r1s+r2+r1s*r2-r2s-r2c+x1+r2*x1+r2s*x1+2.*x2
         +r1s*x2-x1*x2*0.5-x2s*0.5)
         /prop23;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-r1s+r2s-2.*r2);
         rFO2 = (2.*r2-x2)*(1.+r1s+r2s-x2)
         /prop2s
@@ -5352,9 +5448,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +2.*(-1.-r1s-r2-r1s*r2-r2s+r2c+x1-r2*x1+r2s*x1+2.*x2
         +r1s*x2-x1*x2*0.5-x2s*0.5)
         /prop23;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-r1s+r2s);
         rFO4 = x2*(-1.-r1s-r2s+x2)
         /prop2s
@@ -5364,13 +5459,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +2.*(-1.-r1s-r2s+x1+r2s*x1+2.*x2
         +r1s*x2-x1*x2*0.5-x2s*0.5)
         /prop23;
-        isSet4 = true;
       }
       break;
 
     // ~g -> q ~qbar.
     case 13:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.+r1s-r2s+2.*r1);
         rFO1 = 4.*(2.*r1+x1)*(-1.-r1s-r2s+x1)
         /(3.*prop1s)
@@ -5390,9 +5484,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -3.*x2+2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)
         /(3.*prop2s);
         rFO1 = 3.*rFO1/4.;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.+r1s-r2s-2.*r1);
         rFO2 = 4.*(2.*r1-x1)*(1.+r1s+r2s-x1)
         /(3.*prop1s)
@@ -5412,9 +5505,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -3.*x2-2.*r1*x2+3.*r1s*x2-r2s*x2+x1*x2+x2s)
         /(3.*prop2s);
         rFO2 = 3.*rFO2/4.;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.+r1s-r2s);
         rFO4 = 8.*x1*(-1.-r1s-r2s+x1)
         /(3.*prop1s)
@@ -5431,13 +5523,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +x1*x2+x2s)
         /(3.*prop2s);
         rFO4 = 3.*rFO4/8.;
-        isSet4 = true;
       }
       break;
 
     // ~q -> q ~g.
     case 14:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-r1s-r2s-2.*r1*r2);
         rFO1 = 64.*(1.+r1s+2.*r1*r2+r2s-x1-x2)*(x1+x2)
         /(9.*x3s)
@@ -5457,9 +5548,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -2.*r1*r2*x1-3.*r2s*x1+2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /(9.*prop23);
         rFO1 = 9.*rFO1/64.;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-r1s-r2s+2.*r1*r2);
         rFO2 = 64.*(1.+r1s-2.*r1*r2+r2s-x1-x2)*(x1+x2)
         /(9.*x3s)
@@ -5479,9 +5569,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         2.*r1*r2*x1-3.*r2s*x1+2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /(9.*prop23);
         rFO2 = 9.*rFO2/64.;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-r1s-r2s);
         rFO4 = 128.*(1.+r1s+r2s-x1-x2)*(x1+x2)
         /(9.*x3s)
@@ -5501,13 +5590,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         +2.*r1s*x2-2.*r2s*x2+x1*x2+x2s)
         /(9.*prop23);
         rFO4 = 9.*rFO4/128.;
-        isSet4 = true;
       }
       break;
 
     // q -> ~q ~g.
     case 15:
-      if (combi == 1 || combi == 3) {
+      if (doExpr1) {
         rLO1 = ps*(1.-r1s+r2s+2.*r2);
         rFO1 = 32*(2.*r2+x2)*(-1.-r1s-r2s+x2)
         /(9.*prop2s)
@@ -5527,9 +5615,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -x1*x2*0.5-x2s*0.5)
         /(9.*prop23);
         rFO1 = 9.*rFO1/32.;
-        isSet1 = true;
       }
-      if (combi == 2 || combi == 3) {
+      if (doExpr2) {
         rLO2 = ps*(1.-r1s+r2s-2.*r2);
         rFO2 = 32*(2.*r2-x2)*(1.+r1s+r2s-x2)
         /(9.*prop2s)
@@ -5549,9 +5636,8 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -x1*x2*0.5-x2s*0.5)
         /(9.*prop23);
         rFO2 = 9.*rFO2/32.;
-        isSet2 = true;
       }
-      if (combi == 4) {
+      if (doExpr4) {
         rLO4 = ps*(1.-r1s+r2s);
         rFO4 = 64.*x2*(-1.-r1s-r2s+x2)
         /(9.*prop2s)
@@ -5570,16 +5656,12 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
         -16.*(-1.-r1s-r2s+x1+r2s*x1+2.*x2+r1s*x2-x1*x2*0.5-x2s*0.5)
         /(9.*prop23);
         rFO4 = 9.*rFO4/64.;
-        isSet4 = true;
       }
       break;
 
     // g -> ~g ~g. Use (9/4)*eikonal. May be changed in the future.
     case 16:
       rLO = ps;
-      if      (combi == 2) offset = x3s;
-      else if (combi == 3) offset = mix * x3s;
-      else if (combi == 4) offset = 0.5 * x3s;
       rFO = ps * 4.5 * ( (x1+x2-1.+offset-r1s-r2s)/prop12
       - r1s/prop2s - r2s/prop1s );
       break;
@@ -5625,9 +5707,6 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
     // Eikonal expression for kind == 1; also acts as default.
     default:
       rLO = ps;
-      if      (combi == 2) offset = x3s;
-      else if (combi == 3) offset = mix * x3s;
-      else if (combi == 4) offset = 0.5 * x3s;
       rFO = ps * 2. * ( (x1+x2-1.+offset-r1s-r2s)/prop12
       - r1s/prop2s - r2s/prop1s );
       break;
@@ -5636,24 +5715,18 @@ double TimeShower::calcMEcorr( int kind, int combiIn, double mixIn,
   }
 
   // Find relevant leading and first order expressions.
-  if      (combi == 1 && isSet1) {
+  if      (me.expr == 1) {
     rLO = rLO1;
     rFO = rFO1; }
-  else if (combi == 2 && isSet2) {
+  else if (me.expr == 2) {
     rLO = rLO2;
     rFO = rFO2; }
-  else if (combi == 3 && isSet1 && isSet2) {
-    rLO = mix * rLO1 + (1.-mix) * rLO2;
-    rFO = mix * rFO1 + (1.-mix) * rFO2; }
-  else if (isSet4) {
+  else if (me.expr == 3) {
+    rLO = me.wt1 * rLO1 + me.wt2 * rLO2;
+    rFO = me.wt1 * rFO1 + me.wt2 * rFO2; }
+  else if (me.expr == 4) {
     rLO = rLO4;
     rFO = rFO4; }
-  else if (combi == 4 && isSet1 && isSet2) {
-    rLO = 0.5 * (rLO1 + rLO2);
-    rFO = 0.5 * (rFO1 + rFO2); }
-  else if (isSet1) {
-    rLO = rLO1;
-    rFO = rFO1; }
 
   // Return ratio of first to leading order cross section.
   return rFO / rLO;
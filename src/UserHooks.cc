@@ -17,6 +17,18 @@ namespace Pythia8 {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+
+// Names of the shower splitting kernels, in the order of the SplitKernel
+// codes, as passed to enhanceFactor(string) and vetoProbability(string).
+const string UserHooks::SPLITKERNELNAME[nSplitKernel] = { "",
+  "fsr:Q2QG", "fsr:G2GG", "fsr:G2QQ", "fsr:G2QQ:cc", "fsr:G2QQ:bb",
+  "fsr:Q2QA", "fsr:A2LL", "fsr:A2QQ", "fsr:Q2QW", "fsr:Q2QHV",
+  "isr:G2GG", "isr:Q2GQ", "isr:Q2QG", "isr:G2QQ", "isr:G2QQ:cc",
+  "isr:G2QQ:bb", "isr:Q2QA", "isr:Q2AQ", "isr:A2QQ", "isr:Q2QW" };
+
+//--------------------------------------------------------------------------
+
 // multiplySigmaBy allows the user to introduce a multiplicative factor
 // that modifies the cross section of a hard process. Since it is called
 // from before the event record is generated in full, the normal analysis